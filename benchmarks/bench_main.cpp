@@ -0,0 +1,39 @@
+#include "bench_util.hpp"
+#include <cstring>
+#include <iostream>
+
+/**
+ * @brief 用法：x30_nav_sdk_bench [codec|framing|roundtrip]...，不带参数时运行全部基准
+ */
+int main(int argc, char* argv[]) {
+    auto selected = [&](const char* suite) {
+        if (argc < 2) {
+            return true;
+        }
+        for (int i = 1; i < argc; ++i) {
+            if (std::strcmp(argv[i], suite) == 0) {
+                return true;
+            }
+        }
+        return false;
+    };
+
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "codec") != 0 && std::strcmp(argv[i], "framing") != 0 &&
+            std::strcmp(argv[i], "roundtrip") != 0) {
+            std::cerr << "未知的基准: " << argv[i] << "\n用法: " << argv[0] << " [codec|framing|roundtrip]..." << std::endl;
+            return 1;
+        }
+    }
+
+    if (selected("codec")) {
+        bench::runCodecBenchmarks();
+    }
+    if (selected("framing")) {
+        bench::runFramingBenchmarks();
+    }
+    if (selected("roundtrip")) {
+        bench::runRoundTripBenchmarks();
+    }
+    return 0;
+}
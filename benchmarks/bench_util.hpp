@@ -0,0 +1,116 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace bench {
+
+/**
+ * @brief 防止编译器把被测代码当作无副作用而优化掉
+ */
+template <typename T>
+inline void doNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const T* sink;
+    sink = &value;
+#endif
+}
+
+/**
+ * @brief 单项基准测试结果
+ */
+struct Result {
+    std::string name;
+    uint64_t iterations = 0;
+    double nsPerOp = 0.0;
+};
+
+/**
+ * @brief 以固定迭代次数运行被测函数并统计每次调用耗时
+ * @param name 测试项名称
+ * @param iterations 迭代次数
+ * @param fn 被测函数
+ * @return 测试结果
+ */
+template <typename Fn>
+Result run(const std::string& name, uint64_t iterations, Fn&& fn) {
+    // 预热，填充缓存与分支预测
+    for (uint64_t i = 0; i < iterations / 10 + 1; ++i) {
+        fn();
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    for (uint64_t i = 0; i < iterations; ++i) {
+        fn();
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+
+    Result result;
+    result.name = name;
+    result.iterations = iterations;
+    result.nsPerOp = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()) /
+                     static_cast<double>(iterations);
+
+    std::printf("%-56s %12llu iters %12.1f ns/op\n", name.c_str(),
+                static_cast<unsigned long long>(iterations), result.nsPerOp);
+    return result;
+}
+
+/**
+ * @brief 延迟样本的分位数统计
+ */
+struct LatencySummary {
+    uint64_t samples = 0;
+    double p50Us = 0.0;
+    double p99Us = 0.0;
+    double p999Us = 0.0;
+    double maxUs = 0.0;
+};
+
+/**
+ * @brief 计算延迟样本的 p50/p99/p999（最近秩法），样本会被排序
+ * @param latencies 延迟样本
+ */
+inline LatencySummary summarize(std::vector<std::chrono::nanoseconds>& latencies) {
+    LatencySummary summary;
+    if (latencies.empty()) {
+        return summary;
+    }
+
+    std::sort(latencies.begin(), latencies.end());
+    auto at = [&](double quantile) {
+        size_t rank = static_cast<size_t>(quantile * static_cast<double>(latencies.size()) + 0.5);
+        rank = std::min(std::max<size_t>(rank, 1), latencies.size());
+        return static_cast<double>(latencies[rank - 1].count()) / 1000.0;
+    };
+
+    summary.samples = latencies.size();
+    summary.p50Us = at(0.50);
+    summary.p99Us = at(0.99);
+    summary.p999Us = at(0.999);
+    summary.maxUs = static_cast<double>(latencies.back().count()) / 1000.0;
+    return summary;
+}
+
+/**
+ * @brief 编解码基准：各消息类型的 Serializer 编码与解码
+ */
+void runCodecBenchmarks();
+
+/**
+ * @brief 帧基准：ProtocolHeader 的构造与校验、FrameDecoder 切分字节流
+ */
+void runFramingBenchmarks();
+
+/**
+ * @brief 端到端基准：连接进程内的模拟服务端，测量 1002 请求往返延迟分位数与吞吐量
+ */
+void runRoundTripBenchmarks();
+
+} // namespace bench
@@ -0,0 +1,286 @@
+#include "bench_util.hpp"
+#include "protocol/messages.hpp"
+#include "protocol/protocol_header.hpp"
+#include "protocol/serializer.hpp"
+#include <rapidxml/rapidxml.hpp>
+#include <iostream>
+#include <sstream>
+
+namespace {
+
+using namespace protocol;
+
+/**
+ * @brief 在原缓冲区上解析XML文档（对照组，SDK 已改用单遍扫描）
+ */
+void parseXmlInPlace(rapidxml::xml_document<>& doc, std::string_view data) {
+    doc.parse<rapidxml::parse_non_destructive>(const_cast<char*>(data.data()));
+}
+
+std::string_view nodeValue(const rapidxml::xml_node<>* node) {
+    return std::string_view(node->value(), node->value_size());
+}
+
+// 与机器狗实际返回格式一致的 1002 实时状态响应
+const std::string REAL_TIME_STATUS_XML =
+    "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+    "<PatrolDevice>\n"
+    "  <Type>1002</Type>\n"
+    "  <Command>1</Command>\n"
+    "  <Time>2024-05-20 12:34:56</Time>\n"
+    "  <Items>\n"
+    "    <MotionState>1</MotionState>\n"
+    "    <PosX>3.14159</PosX>\n"
+    "    <PosY>-2.71828</PosY>\n"
+    "    <PosZ>0.125</PosZ>\n"
+    "    <AngleYaw>1.5708</AngleYaw>\n"
+    "    <Roll>0.0123</Roll>\n"
+    "    <Pitch>-0.0456</Pitch>\n"
+    "    <Yaw>1.5707</Yaw>\n"
+    "    <Speed>0.85</Speed>\n"
+    "    <CurOdom>12.5</CurOdom>\n"
+    "    <SumOdom>10234.75</SumOdom>\n"
+    "    <CurRuntime>3600</CurRuntime>\n"
+    "    <SumRuntime>7200000</SumRuntime>\n"
+    "    <Res>0.05</Res>\n"
+    "    <X0>1.25</X0>\n"
+    "    <Y0>-3.5</Y0>\n"
+    "    <H>250</H>\n"
+    "    <Electricity>87</Electricity>\n"
+    "    <Location>0</Location>\n"
+    "    <RTKState>1</RTKState>\n"
+    "    <OnDockState>0</OnDockState>\n"
+    "    <GaitState>2</GaitState>\n"
+    "    <MotorState>0</MotorState>\n"
+    "    <ChargeState>0</ChargeState>\n"
+    "    <ControlMode>1</ControlMode>\n"
+    "    <MapUpdateState>0</MapUpdateState>\n"
+    "  </Items>\n"
+    "</PatrolDevice>";
+
+/**
+ * @brief 旧的两遍解析流程：先完整解析一次文档取出 Type，再由消息对象再次解析
+ */
+std::unique_ptr<IMessage> deserializeTwoPass(const Frame& frame) {
+    rapidxml::xml_document<> doc;
+    parseXmlInPlace(doc, frame.body);
+
+    int type = 0;
+    rapidxml::xml_node<>* root = doc.first_node("PatrolDevice");
+    if (root && root->first_node("Type")) {
+        parseNumber(nodeValue(root->first_node("Type")), type);
+    }
+
+    auto message = createMessage(type == 1002 ? MessageType::GET_REAL_TIME_STATUS_RESP : MessageType::UNKNOWN);
+    if (!message || !message->deserialize(frame.body)) {
+        return nullptr;
+    }
+    message->setSequenceNumber(frame.sequenceNumber);
+    return message;
+}
+
+/**
+ * @brief 旧的 1002 字段解码方式：逐字段 first_node() 线性查找，stringstream 转换数值
+ */
+bool deserializeRealTimeStatusDom(std::string_view body, GetRealTimeStatusResponse& resp) {
+    rapidxml::xml_document<> doc;
+    parseXmlInPlace(doc, body);
+
+    rapidxml::xml_node<>* root = doc.first_node("PatrolDevice");
+    rapidxml::xml_node<>* items_node = root ? root->first_node("Items") : nullptr;
+    if (!items_node) {
+        return false;
+    }
+
+    auto get_node_value = [&](const char* name, auto& value) {
+        rapidxml::xml_node<>* node = items_node->first_node(name);
+        if (node) {
+            std::stringstream ss(std::string(nodeValue(node)));
+            ss >> value;
+        }
+    };
+
+    get_node_value("MotionState", resp.motionState);
+    get_node_value("PosX", resp.posX);
+    get_node_value("PosY", resp.posY);
+    get_node_value("PosZ", resp.posZ);
+    get_node_value("AngleYaw", resp.angleYaw);
+    get_node_value("Roll", resp.roll);
+    get_node_value("Pitch", resp.pitch);
+    get_node_value("Yaw", resp.yaw);
+    get_node_value("Speed", resp.speed);
+    get_node_value("CurOdom", resp.curOdom);
+    get_node_value("SumOdom", resp.sumOdom);
+    get_node_value("CurRuntime", resp.curRuntime);
+    get_node_value("SumRuntime", resp.sumRuntime);
+    get_node_value("Res", resp.res);
+    get_node_value("X0", resp.x0);
+    get_node_value("Y0", resp.y0);
+    get_node_value("H", resp.h);
+    get_node_value("Electricity", resp.electricity);
+    get_node_value("Location", resp.location);
+    get_node_value("RTKState", resp.RTKState);
+    get_node_value("OnDockState", resp.onDockState);
+    get_node_value("GaitState", resp.gaitState);
+    get_node_value("MotorState", resp.motorState);
+    get_node_value("ChargeState", resp.chargeState);
+    get_node_value("ControlMode", resp.controlMode);
+    get_node_value("MapUpdateState", resp.mapUpdateState);
+    return true;
+}
+
+/**
+ * @brief 以协议头 + 消息体拼出一个完整帧，供 Serializer::deserializeMessage() 使用
+ */
+std::string makeFrame(const std::string& body, uint16_t sequenceNumber) {
+    ProtocolHeader header(static_cast<uint16_t>(body.size()), sequenceNumber);
+    std::string frame(reinterpret_cast<const char*>(&header), sizeof(header));
+    frame += body;
+    return frame;
+}
+
+/**
+ * @brief 构造一个只有 <Items> 内容不同的响应消息体
+ */
+std::string makeResponseBody(int type, const std::string& items) {
+    return "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<PatrolDevice>\n<Type>" + std::to_string(type) +
+           "</Type>\n<Command>1</Command>\n<Time>2024-05-20 12:34:56</Time>\n<Items>\n" + items +
+           "</Items>\n</PatrolDevice>";
+}
+
+/**
+ * @brief 每种消息类型的编码与解码
+ *
+ * SDK 只编码请求、只解码响应（响应的 serialize() 为空实现），因此编码覆盖 4 种请求，
+ * 解码覆盖 4 种响应；解码走 Serializer::deserializeMessage()，包含协议头解析与消息体拷贝。
+ */
+void runAllMessageTypes(uint64_t iterations) {
+    Serializer serializer;
+
+    std::cout << "\n== 全部请求类型编码 (Serializer::serializeMessage) ==" << std::endl;
+    GetRealTimeStatusRequest statusRequest;
+    CancelTaskRequest cancelRequest;
+    QueryStatusRequest queryRequest;
+    NavigationTaskRequest navRequest;
+    navRequest.timestamp = "2024-05-20 12:34:56";
+    NavigationPoint point;
+    point.mapId = 1;
+    point.value = 7;
+    point.posX = 12.5;
+    point.posY = -3.25;
+    point.angleYaw = 1.5708;
+    navRequest.points.push_back(point);
+
+    const std::pair<const char*, const IMessage*> requests[] = {
+        {"1002 GetRealTimeStatusRequest", &statusRequest},
+        {"1003 NavigationTaskRequest (1 point)", &navRequest},
+        {"1004 CancelTaskRequest", &cancelRequest},
+        {"1007 QueryStatusRequest", &queryRequest},
+    };
+
+    std::string out;
+    for (const auto& request : requests) {
+        const IMessage& message = *request.second;
+        bench::run(std::string("encode ") + request.first + " (new string)", iterations, [&]() {
+            std::string frame = serializer.serializeMessage(message);
+            bench::doNotOptimize(frame);
+        });
+        bench::run(std::string("encode ") + request.first + " (reused buffer)", iterations, [&]() {
+            serializer.serializeMessage(message, out);
+            bench::doNotOptimize(out);
+        });
+    }
+
+    std::cout << "\n== 全部响应类型解码 (Serializer::deserializeMessage) ==" << std::endl;
+    const std::pair<const char*, std::string> responses[] = {
+        {"1002 GetRealTimeStatusResponse", makeFrame(REAL_TIME_STATUS_XML, 1)},
+        {"1003 NavigationTaskResponse", makeFrame(makeResponseBody(1003,
+            "  <Value>7</Value>\n  <ErrorCode>0</ErrorCode>\n  <ErrorStatus>0</ErrorStatus>\n"), 2)},
+        {"1004 CancelTaskResponse", makeFrame(makeResponseBody(1004, "  <ErrorCode>0</ErrorCode>\n"), 3)},
+        {"1007 QueryStatusResponse", makeFrame(makeResponseBody(1007,
+            "  <Value>7</Value>\n  <Status>1</Status>\n  <ErrorCode>0</ErrorCode>\n"), 4)},
+    };
+
+    for (const auto& response : responses) {
+        if (!serializer.deserializeMessage(response.second)) {
+            std::cerr << "无法解码 " << response.first << std::endl;
+            continue;
+        }
+        bench::run(std::string("decode ") + response.first, iterations, [&]() {
+            auto message = serializer.deserializeMessage(response.second);
+            bench::doNotOptimize(message);
+        });
+    }
+}
+
+} // namespace
+
+namespace bench {
+
+void runCodecBenchmarks() {
+    constexpr uint64_t ITERATIONS = 200000;
+
+    Frame frame;
+    frame.sequenceNumber = 1;
+    frame.body = REAL_TIME_STATUS_XML;
+
+    Serializer serializer;
+
+    std::cout << "== 1002 GetRealTimeStatusResponse 解码 ==" << std::endl;
+    auto twoPass = bench::run("decode 1002 (two-pass, baseline)", ITERATIONS, [&]() {
+        auto message = deserializeTwoPass(frame);
+        bench::doNotOptimize(message);
+    });
+    auto singlePass = bench::run("decode 1002 (Serializer::deserializeFrame)", ITERATIONS, [&]() {
+        auto message = serializer.deserializeFrame(frame);
+        bench::doNotOptimize(message);
+    });
+
+    std::printf("speedup: %.2fx\n", twoPass.nsPerOp / singlePass.nsPerOp);
+
+    std::cout << "\n== 1002 字段解码 ==" << std::endl;
+    GetRealTimeStatusResponse resp;
+    auto dom = bench::run("1002 fields (rapidxml DOM + stringstream)", ITERATIONS, [&]() {
+        deserializeRealTimeStatusDom(frame.body, resp);
+        bench::doNotOptimize(resp);
+    });
+    auto scanner = bench::run("1002 fields (tag scanner + from_chars)", ITERATIONS, [&]() {
+        resp.deserialize(frame.body);
+        bench::doNotOptimize(resp);
+    });
+
+    std::printf("speedup: %.2fx\n", dom.nsPerOp / scanner.nsPerOp);
+
+    std::cout << "\n== 1002 GetRealTimeStatusRequest 编码 ==" << std::endl;
+    GetRealTimeStatusRequest statusRequest;
+    std::string statusFrame;
+    uint16_t seq = 0;
+    bench::run("encode 1002 (frame template, reused buffer)", ITERATIONS, [&]() {
+        statusRequest.setSequenceNumber(++seq);
+        serializer.serializeMessage(statusRequest, statusFrame);
+        bench::doNotOptimize(statusFrame);
+    });
+
+    std::cout << "\n== 1003 NavigationTaskRequest 编码 ==" << std::endl;
+    NavigationTaskRequest route;
+    route.timestamp = "2024-05-20 12:34:56";
+    for (int i = 0; i < 100; ++i) {
+        NavigationPoint point;
+        point.mapId = 1;
+        point.value = i;
+        point.posX = 1.25 * i;
+        point.posY = -0.5 * i;
+        point.angleYaw = 0.01 * i;
+        route.points.push_back(point);
+    }
+
+    std::string encoded;
+    bench::run("encode 1003 x100 points (reused buffer)", ITERATIONS / 100, [&]() {
+        serializer.serializeMessage(route, encoded);
+        bench::doNotOptimize(encoded);
+    });
+
+    runAllMessageTypes(ITERATIONS);
+}
+
+} // namespace bench
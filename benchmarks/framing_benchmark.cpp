@@ -0,0 +1,88 @@
+#include "bench_util.hpp"
+#include "protocol/frame_decoder.hpp"
+#include "protocol/protocol_header.hpp"
+#include <cstring>
+#include <iostream>
+
+namespace {
+
+using namespace protocol;
+
+constexpr size_t FRAMES_PER_STREAM = 64;   ///< 每轮送入解码器的帧数
+constexpr size_t SEGMENT_SIZE = 1460;      ///< 以太网 MSS，模拟一次 TCP 读取的数据量
+
+/**
+ * @brief 构造由 FRAMES_PER_STREAM 个 1002 响应帧首尾相接组成的字节流
+ */
+std::string makeStream() {
+    const std::string body =
+        "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<PatrolDevice>\n<Type>1002</Type>\n<Command>1</Command>\n"
+        "<Time>2024-05-20 12:34:56</Time>\n<Items>\n<MotionState>1</MotionState>\n<PosX>3.14159</PosX>\n"
+        "<PosY>-2.71828</PosY>\n<Electricity>87</Electricity>\n</Items>\n</PatrolDevice>";
+
+    std::string stream;
+    for (size_t i = 0; i < FRAMES_PER_STREAM; ++i) {
+        ProtocolHeader header(static_cast<uint16_t>(body.size()), static_cast<uint16_t>(i));
+        stream.append(reinterpret_cast<const char*>(&header), sizeof(header));
+        stream += body;
+    }
+    return stream;
+}
+
+} // namespace
+
+namespace bench {
+
+void runFramingBenchmarks() {
+    constexpr uint64_t ITERATIONS = 2000000;
+
+    std::cout << "\n== ProtocolHeader ==" << std::endl;
+    uint16_t seq = 0;
+    bench::run("ProtocolHeader construct", ITERATIONS, [&]() {
+        ProtocolHeader header(512, ++seq);
+        bench::doNotOptimize(header);
+    });
+
+    const ProtocolHeader wire(512, 42);
+    char bytes[sizeof(ProtocolHeader)];
+    std::memcpy(bytes, &wire, sizeof(bytes));
+    bench::run("ProtocolHeader parse + validateSyncBytes", ITERATIONS, [&]() {
+        ProtocolHeader header;
+        std::memcpy(&header, bytes, sizeof(header));
+        const bool valid = header.validateSyncBytes();
+        const uint16_t size = header.getBodySize();
+        bench::doNotOptimize(valid);
+        bench::doNotOptimize(size);
+    });
+
+    std::cout << "\n== FrameDecoder (" << FRAMES_PER_STREAM << " frames per op) ==" << std::endl;
+    const std::string stream = makeStream();
+    FrameDecoder decoder;
+    Frame frame;
+
+    auto whole = bench::run("FrameDecoder append whole stream + next()", ITERATIONS / 1000, [&]() {
+        decoder.append(stream.data(), stream.size());
+        size_t frames = 0;
+        while (decoder.next(frame)) {
+            ++frames;
+        }
+        bench::doNotOptimize(frames);
+    });
+    std::printf("%-56s %12.1f ns/frame\n", "", whole.nsPerOp / FRAMES_PER_STREAM);
+
+    auto segmented = bench::run("FrameDecoder prepare/commit per MSS + next()", ITERATIONS / 1000, [&]() {
+        size_t frames = 0;
+        for (size_t offset = 0; offset < stream.size(); offset += SEGMENT_SIZE) {
+            const size_t n = std::min(SEGMENT_SIZE, stream.size() - offset);
+            std::memcpy(decoder.prepare(n), stream.data() + offset, n);
+            decoder.commit(n);
+            while (decoder.next(frame)) {
+                ++frames;
+            }
+        }
+        bench::doNotOptimize(frames);
+    });
+    std::printf("%-56s %12.1f ns/frame\n", "", segmented.nsPerOp / FRAMES_PER_STREAM);
+}
+
+} // namespace bench
@@ -0,0 +1,124 @@
+#include "bench_util.hpp"
+#include "navigation_sdk.h"
+#include "mock_server.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <iostream>
+#include <mutex>
+
+namespace {
+
+using namespace robotserver_sdk;
+using Clock = std::chrono::steady_clock;
+
+constexpr size_t WARMUP_REQUESTS = 1000;
+constexpr size_t SYNC_REQUESTS = 20000;
+constexpr size_t PIPELINED_REQUESTS = 100000;
+
+void printSummary(const char* name, std::vector<std::chrono::nanoseconds>& latencies,
+                  Clock::duration elapsed, size_t errors) {
+    const bench::LatencySummary summary = bench::summarize(latencies);
+    const double seconds = std::chrono::duration<double>(elapsed).count();
+    std::printf("%-32s %8llu reqs  p50 %8.1f us  p99 %8.1f us  p999 %8.1f us  max %8.1f us  %10.0f req/s  errors %zu\n",
+                name, static_cast<unsigned long long>(summary.samples), summary.p50Us, summary.p99Us,
+                summary.p999Us, summary.maxUs, seconds > 0 ? static_cast<double>(summary.samples) / seconds : 0.0,
+                errors);
+}
+
+/**
+ * @brief 同步接口逐个请求：一次只有一个请求在途，测量单请求往返延迟
+ */
+void runSync(RobotServerSdk& sdk) {
+    std::vector<std::chrono::nanoseconds> latencies;
+    latencies.reserve(SYNC_REQUESTS);
+    size_t errors = 0;
+
+    const auto start = Clock::now();
+    for (size_t i = 0; i < SYNC_REQUESTS; ++i) {
+        const auto sent = Clock::now();
+        const RealTimeStatus status = sdk.request1002_RunTimeStatus();
+        latencies.push_back(Clock::now() - sent);
+        if (status.errorCode != ErrorCode_RealTimeStatus::SUCCESS) {
+            ++errors;
+        }
+    }
+    printSummary("1002 sync, 1 in flight", latencies, Clock::now() - start, errors);
+}
+
+/**
+ * @brief 回调接口流水线请求：始终保持 depth 个请求在途，每完成一个就在回调中发出下一个
+ */
+void runPipelined(RobotServerSdk& sdk, size_t depth) {
+    std::vector<std::chrono::nanoseconds> latencies(PIPELINED_REQUESTS);
+    std::atomic<size_t> issued{0};
+    std::atomic<size_t> completed{0};
+    std::atomic<size_t> errors{0};
+    std::mutex mutex;
+    std::condition_variable done;
+
+    std::function<void()> issue = [&]() {
+        const size_t index = issued.fetch_add(1);
+        if (index >= PIPELINED_REQUESTS) {
+            return;
+        }
+
+        const auto sent = Clock::now();
+        sdk.request1002_RunTimeStatus([&, index, sent](const RealTimeStatus& status) {
+            latencies[index] = Clock::now() - sent;
+            if (status.errorCode != ErrorCode_RealTimeStatus::SUCCESS) {
+                ++errors;
+            }
+            issue();
+            if (completed.fetch_add(1) + 1 == PIPELINED_REQUESTS) {
+                std::lock_guard<std::mutex> lock(mutex);
+                done.notify_one();
+            }
+        });
+    };
+
+    const auto start = Clock::now();
+    for (size_t i = 0; i < depth; ++i) {
+        issue();
+    }
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        done.wait(lock, [&]() { return completed.load() == PIPELINED_REQUESTS; });
+    }
+    const auto elapsed = Clock::now() - start;
+
+    const std::string name = "1002 callback, " + std::to_string(depth) + " in flight";
+    printSummary(name.c_str(), latencies, elapsed, errors.load());
+}
+
+} // namespace
+
+namespace bench {
+
+void runRoundTripBenchmarks() {
+    std::cout << "\n== 1002 端到端往返 (进程内 examples/server 模拟服务端, 127.0.0.1) ==" << std::endl;
+
+    example::MockServer server(0, "127.0.0.1", false);
+    server.start();
+
+    // 合并查询会让并发的 1002 共享一个请求，基准测试需要每次调用都真正往返
+    SdkOptions options;
+    options.coalesceQueries = false;
+    RobotServerSdk sdk(options);
+    if (!sdk.connect("127.0.0.1", server.port())) {
+        std::cerr << "无法连接模拟服务端" << std::endl;
+        return;
+    }
+
+    for (size_t i = 0; i < WARMUP_REQUESTS; ++i) {
+        sdk.request1002_RunTimeStatus();
+    }
+
+    runSync(sdk);
+    runPipelined(sdk, 16);
+    runPipelined(sdk, 64);
+
+    sdk.disconnect();
+    server.stop();
+}
+
+} // namespace bench
@@ -0,0 +1,423 @@
+#include <navigation_sdk.h>
+#include <algorithm>
+#include <atomic>
+#include <csignal>
+#include <cstdio>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+
+using namespace robotserver_sdk;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+volatile std::sig_atomic_t g_stop = 0;
+
+void onSignal(int) {
+    g_stop = 1;
+}
+
+/**
+ * @brief 把打开文件数的软上限提高到硬上限，每个模拟连接占用一个套接字
+ */
+void raiseOpenFileLimit() {
+#ifndef _WIN32
+    rlimit limit{};
+    if (getrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur < limit.rlim_max) {
+        limit.rlim_cur = limit.rlim_max;
+        setrlimit(RLIMIT_NOFILE, &limit);
+    }
+#endif
+}
+
+/**
+ * @brief 压测配置
+ */
+struct LoadOptions {
+    std::string host = "127.0.0.1";
+    uint16_t port = 30000;
+    size_t robots = 100;                 ///< 连接数，第 i 个连接到 port + i（samePort 时都连接 port）
+    bool samePort = false;
+    size_t threads = 0;                  ///< 共享 IO 线程数，0 表示硬件并发数
+    double rampSeconds = 0.0;            ///< 在这段时间内线性地建立连接、提升请求速率
+    double rate = 0.0;                   ///< 总请求速率（次/秒），0 表示闭环：每个连接始终保持 inFlight 个请求在途
+    uint32_t inFlight = 1;               ///< 每个连接同时在途的请求上限
+    int durationSeconds = 30;            ///< 总运行时长（包括爬坡阶段）
+    std::chrono::milliseconds timeout{3000};
+    int type = 1002;                     ///< 请求类型：1002 或 1007
+};
+
+/**
+ * @brief 一台被压测的机器狗（一个连接）
+ */
+struct Robot {
+    std::unique_ptr<RobotServerSdk> sdk;
+    std::atomic<uint32_t> inFlight{0};
+    std::atomic<bool> connected{false};
+};
+
+/**
+ * @brief 按桶上界（微秒）合并的延迟直方图，桶边界与 SDK 的 LatencySnapshot 一致
+ */
+using Histogram = std::map<int64_t, uint64_t>;
+
+void addLatency(Histogram& histogram, const LatencySnapshot& snapshot) {
+    for (const auto& bucket : snapshot.buckets) {
+        histogram[bucket.first.count()] += bucket.second;
+    }
+}
+
+/**
+ * @brief 把合并后的直方图转换回 LatencySnapshot，以复用其分位数估算
+ * @param since 为非空时只统计相对 since 新增的样本
+ */
+LatencySnapshot toSnapshot(const Histogram& histogram, const Histogram* since = nullptr) {
+    LatencySnapshot snapshot;
+    for (const auto& bucket : histogram) {
+        uint64_t count = bucket.second;
+        if (since) {
+            const auto previous = since->find(bucket.first);
+            if (previous != since->end()) {
+                count -= std::min(count, previous->second);
+            }
+        }
+        if (count != 0) {
+            snapshot.buckets.emplace_back(std::chrono::microseconds(bucket.first), count);
+            snapshot.count += count;
+        }
+    }
+
+    // percentile() 以 max 截断桶上界，合并后只知道最高非空桶的上界
+    if (!snapshot.buckets.empty()) {
+        snapshot.max = snapshot.buckets.back().first;
+    }
+    return snapshot;
+}
+
+class LoadGenerator {
+public:
+    explicit LoadGenerator(const LoadOptions& options)
+        : options_(options),
+          pool_(std::make_shared<IoThreadPool>(options.threads)) {
+        SdkOptions sdkOptions;
+        sdkOptions.ioThreadPool = pool_;
+        sdkOptions.requestTimeout = options_.timeout;
+        sdkOptions.coalesceQueries = false;  // 每次调用都真正发出请求
+
+        for (size_t i = 0; i < options_.robots; ++i) {
+            auto robot = std::make_unique<Robot>();
+            robot->sdk = std::make_unique<RobotServerSdk>(sdkOptions);
+            robots_.push_back(std::move(robot));
+        }
+    }
+
+    void run() {
+        const auto start = Clock::now();
+        std::thread connector([this, start]() { connectAll(start); });
+        std::thread driver([this, start]() { drive(start); });
+
+        Histogram last;
+        uint64_t lastSent = 0;
+        uint64_t lastSucceeded = 0;
+        uint64_t lastFailed = 0;
+        uint64_t lastSkipped = 0;
+        for (int second = 1; !g_stop && second <= options_.durationSeconds; ++second) {
+            std::this_thread::sleep_until(start + std::chrono::seconds(second));
+
+            const Histogram current = collectLatency();
+            const LatencySnapshot interval = toSnapshot(current, &last);
+            const uint64_t sent = sent_.load();
+            const uint64_t succeeded = succeeded_.load();
+            const uint64_t failed = failed_.load();
+            const uint64_t skipped = skipped_.load();
+
+            std::printf("[%4ds] 连接 %6zu/%-6zu 发送 %8llu/s  成功 %8llu/s  失败 %6llu/s  窗口满跳过 %6llu/s  "
+                        "p50 %7lld us  p99 %7lld us  p999 %7lld us\n",
+                        second, connectedCount(), robots_.size(),
+                        static_cast<unsigned long long>(sent - lastSent),
+                        static_cast<unsigned long long>(succeeded - lastSucceeded),
+                        static_cast<unsigned long long>(failed - lastFailed),
+                        static_cast<unsigned long long>(skipped - lastSkipped),
+                        static_cast<long long>(interval.percentile(0.5).count()),
+                        static_cast<long long>(interval.percentile(0.99).count()),
+                        static_cast<long long>(interval.percentile(0.999).count()));
+            std::fflush(stdout);
+
+            last = current;
+            lastSent = sent;
+            lastSucceeded = succeeded;
+            lastFailed = failed;
+            lastSkipped = skipped;
+        }
+
+        running_ = false;
+        connector.join();
+        driver.join();
+        const double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+
+        // 等待在途请求结束（成功或超时）再汇总
+        const auto deadline = Clock::now() + options_.timeout + std::chrono::seconds(1);
+        while (totalInFlight() != 0 && Clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+
+        const LatencySnapshot total = toSnapshot(collectLatency());
+        std::printf("\n汇总: 运行 %.1f s，发送 %llu，成功 %llu，失败 %llu，窗口满跳过 %llu，平均吞吐 %.0f 次/秒\n"
+                    "      延迟 p50 %lld us，p99 %lld us，p999 %lld us\n",
+                    elapsed,
+                    static_cast<unsigned long long>(sent_.load()),
+                    static_cast<unsigned long long>(succeeded_.load()),
+                    static_cast<unsigned long long>(failed_.load()),
+                    static_cast<unsigned long long>(skipped_.load()),
+                    elapsed > 0 ? static_cast<double>(succeeded_.load()) / elapsed : 0.0,
+                    static_cast<long long>(total.percentile(0.5).count()),
+                    static_cast<long long>(total.percentile(0.99).count()),
+                    static_cast<long long>(total.percentile(0.999).count()));
+
+        for (auto& robot : robots_) {
+            robot->sdk->disconnect();
+        }
+    }
+
+private:
+    /**
+     * @brief 爬坡阶段内进度，[0, 1]
+     */
+    double rampProgress(Clock::time_point start) const {
+        if (options_.rampSeconds <= 0.0) {
+            return 1.0;
+        }
+        const double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+        return std::min(1.0, elapsed / options_.rampSeconds);
+    }
+
+    /**
+     * @brief 按爬坡进度依次建立连接
+     */
+    void connectAll(Clock::time_point start) {
+        for (size_t i = 0; i < robots_.size() && running_ && !g_stop; ++i) {
+            const auto due = start + std::chrono::duration_cast<Clock::duration>(
+                std::chrono::duration<double>(options_.rampSeconds * static_cast<double>(i) /
+                                              static_cast<double>(robots_.size())));
+            while (Clock::now() < due && running_ && !g_stop) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+
+            const uint16_t port = options_.samePort ? options_.port : static_cast<uint16_t>(options_.port + i);
+            if (robots_[i]->sdk->connect(options_.host, port)) {
+                robots_[i]->connected = true;
+            } else {
+                std::cerr << "连接 " << options_.host << ":" << port << " 失败" << std::endl;
+            }
+        }
+    }
+
+    /**
+     * @brief 发出请求：定速模式下按目标速率轮流分配给各连接；闭环模式下补满每个连接的在途窗口
+     */
+    void drive(Clock::time_point start) {
+        uint64_t scheduled = 0;
+        size_t next = 0;
+        auto lastTick = start;
+
+        while (running_ && !g_stop) {
+            if (options_.rate <= 0.0) {
+                // 闭环模式：请求完成时在回调中立即补发，这里只负责新建立的连接和失败后的恢复
+                for (auto& robot : robots_) {
+                    while (robot->connected && issue(*robot)) {
+                    }
+                }
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                continue;
+            }
+
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+            // 定速模式：爬坡阶段速率线性增长，按积分计算截至当前应发出的请求数
+            const auto now = Clock::now();
+            const double dt = std::chrono::duration<double>(now - lastTick).count();
+            lastTick = now;
+            rateCredit_ += options_.rate * rampProgress(start) * dt;
+            const uint64_t due = static_cast<uint64_t>(rateCredit_);
+
+            for (; scheduled < due; ++scheduled) {
+                bool issued = false;
+                for (size_t tries = 0; tries < robots_.size() && !issued; ++tries) {
+                    Robot& robot = *robots_[next];
+                    next = (next + 1) % robots_.size();
+                    issued = robot.connected && issue(robot);
+                }
+                if (!issued) {
+                    // 所有连接的窗口都已满（或尚未建立），本轮剩余的请求都视为被服务端背压跳过
+                    skipped_ += due - scheduled;
+                    scheduled = due;
+                    break;
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief 在指定连接上发出一个请求
+     * @return 连接的在途窗口已满时返回 false
+     */
+    bool issue(Robot& robot) {
+        if (robot.inFlight.fetch_add(1) >= options_.inFlight) {
+            --robot.inFlight;
+            return false;
+        }
+        ++sent_;
+
+        auto done = [this, &robot](bool ok) {
+            --robot.inFlight;
+            if (ok) {
+                ++succeeded_;
+            } else {
+                ++failed_;
+            }
+
+            // 闭环模式下立即补发；未连接时回调在调用线程中同步执行，不补发以免递归
+            if (options_.rate <= 0.0 && running_ && !g_stop && robot.sdk->isConnected()) {
+                issue(robot);
+            }
+        };
+
+        if (options_.type == 1007) {
+            robot.sdk->request1007_NavTaskStatus([done](const TaskStatusResult& result) {
+                done(result.errorCode == ErrorCode_QueryStatus::COMPLETED ||
+                     result.errorCode == ErrorCode_QueryStatus::EXECUTING ||
+                     result.errorCode == ErrorCode_QueryStatus::FAILED);
+            }, options_.timeout);
+        } else {
+            robot.sdk->request1002_RunTimeStatus([done](const RealTimeStatus& status) {
+                done(status.errorCode == ErrorCode_RealTimeStatus::SUCCESS);
+            }, options_.timeout);
+        }
+        return true;
+    }
+
+    Histogram collectLatency() const {
+        Histogram histogram;
+        for (const auto& robot : robots_) {
+            const MetricsSnapshot metrics = robot->sdk->metrics();
+            addLatency(histogram, options_.type == 1007 ? metrics.latency1007 : metrics.latency1002);
+        }
+        return histogram;
+    }
+
+    size_t connectedCount() const {
+        return static_cast<size_t>(std::count_if(robots_.begin(), robots_.end(), [](const std::unique_ptr<Robot>& robot) {
+            return robot->sdk->isConnected();
+        }));
+    }
+
+    uint64_t totalInFlight() const {
+        uint64_t total = 0;
+        for (const auto& robot : robots_) {
+            total += robot->inFlight.load();
+        }
+        return total;
+    }
+
+    LoadOptions options_;
+    std::shared_ptr<IoThreadPool> pool_;
+    std::vector<std::unique_ptr<Robot>> robots_;
+    std::atomic<bool> running_{true};
+    double rateCredit_ = 0.0;           // 仅在 drive() 线程中访问
+    std::atomic<uint64_t> sent_{0};
+    std::atomic<uint64_t> succeeded_{0};
+    std::atomic<uint64_t> failed_{0};
+    std::atomic<uint64_t> skipped_{0};
+};
+
+void printUsage(const char* program) {
+    std::cerr << "用法: " << program << " [选项]\n"
+              << "  --host <地址>          服务端地址，默认 127.0.0.1\n"
+              << "  --port <端口>          第一台机器狗的端口，第 i 个连接到 port + i，默认 30000\n"
+              << "  --robots <台数>        连接数，默认 100\n"
+              << "  --same-port            所有连接都连接 --port\n"
+              << "  --threads <线程数>     共享 IO 线程数，默认为硬件并发数\n"
+              << "  --ramp <秒>            在这段时间内线性建立连接、提升请求速率，默认 0\n"
+              << "  --rate <次/秒>         总请求速率，0 表示闭环（每个连接保持 --in-flight 个请求在途），默认 0\n"
+              << "  --in-flight <个数>     每个连接同时在途的请求上限，默认 1\n"
+              << "  --duration <秒>        总运行时长（包括爬坡），默认 30\n"
+              << "  --timeout-ms <毫秒>    请求超时，默认 3000\n"
+              << "  --type <1002|1007>     请求类型，默认 1002\n";
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    LoadOptions options;
+
+    try {
+        for (int i = 1; i < argc; ++i) {
+            const std::string arg = argv[i];
+            if (arg == "--help" || arg == "-h") {
+                printUsage(argv[0]);
+                return 0;
+            }
+            if (arg == "--same-port") {
+                options.samePort = true;
+                continue;
+            }
+            if (i + 1 >= argc) {
+                std::cerr << "缺少选项的值: " << arg << std::endl;
+                printUsage(argv[0]);
+                return 1;
+            }
+
+            const std::string value = argv[++i];
+            if (arg == "--host") {
+                options.host = value;
+            } else if (arg == "--port") {
+                options.port = static_cast<uint16_t>(std::stoi(value));
+            } else if (arg == "--robots") {
+                options.robots = static_cast<size_t>(std::stoul(value));
+            } else if (arg == "--threads") {
+                options.threads = static_cast<size_t>(std::stoul(value));
+            } else if (arg == "--ramp") {
+                options.rampSeconds = std::stod(value);
+            } else if (arg == "--rate") {
+                options.rate = std::stod(value);
+            } else if (arg == "--in-flight") {
+                options.inFlight = static_cast<uint32_t>(std::max(1ul, std::stoul(value)));
+            } else if (arg == "--duration") {
+                options.durationSeconds = std::stoi(value);
+            } else if (arg == "--timeout-ms") {
+                options.timeout = std::chrono::milliseconds(std::stoi(value));
+            } else if (arg == "--type") {
+                options.type = std::stoi(value);
+            } else {
+                std::cerr << "未知的选项: " << arg << std::endl;
+                printUsage(argv[0]);
+                return 1;
+            }
+        }
+    } catch (const std::exception&) {
+        std::cerr << "选项的值无效" << std::endl;
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    if (options.robots == 0 || (options.type != 1002 && options.type != 1007)) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    raiseOpenFileLimit();
+    std::signal(SIGINT, onSignal);
+    std::signal(SIGTERM, onSignal);
+
+    LoadGenerator generator(options);
+    generator.run();
+    return 0;
+}
@@ -181,11 +181,16 @@ int main(int argc, char* argv[]) {
             navigationResponseReceived = true;
         });
 
-        // 轮询查询任务状态和实时状态，直到收到导航响应
+        // 轮询查询任务状态直到收到导航响应，实时状态由SDK按同样的周期推送
         int pollCount = 0;
         const int MAX_POLL_COUNT = 120; // 最多轮询120次
         const auto POLL_INTERVAL = std::chrono::milliseconds(1000); // 轮询间隔1秒
 
+        const uint32_t statusSubscription = sdk.subscribeRealTimeStatus(POLL_INTERVAL,
+            [](const robotserver_sdk::RealTimeStatus& status) {
+                printStatus(status);
+            });
+
         while (!navigationResponseReceived && pollCount < MAX_POLL_COUNT) {
             std::this_thread::sleep_for(POLL_INTERVAL);
             pollCount++;
@@ -195,12 +200,10 @@ int main(int argc, char* argv[]) {
             // 查询任务状态
             auto taskStatus = sdk.request1007_NavTaskStatus();
             printTaskStatus(taskStatus);
-
-            // 获取实时状态
-            auto status = sdk.request1002_RunTimeStatus();
-            printStatus(status);
         }
 
+        sdk.unsubscribeRealTimeStatus(statusSubscription);
+
         if (!navigationResponseReceived) {
             std::cout << "达到最大轮询次数，尝试取消任务..." << std::endl;
             if (sdk.request1004_CancelNavTask()) {
@@ -0,0 +1,153 @@
+#include "mock_server.hpp"
+#include <csignal>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <thread>
+
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+
+namespace {
+
+volatile std::sig_atomic_t g_stop = 0;
+
+void onSignal(int) {
+    g_stop = 1;
+}
+
+/**
+ * @brief 把打开文件数的软上限提高到硬上限，每台模拟机器狗占用一个监听套接字和若干连接
+ */
+void raiseOpenFileLimit() {
+#ifndef _WIN32
+    rlimit limit{};
+    if (getrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur < limit.rlim_max) {
+        limit.rlim_cur = limit.rlim_max;
+        setrlimit(RLIMIT_NOFILE, &limit);
+    }
+#endif
+}
+
+std::chrono::microseconds millisToMicros(const std::string& text) {
+    return std::chrono::microseconds(static_cast<int64_t>(std::stod(text) * 1000.0));
+}
+
+void printUsage(const char* program) {
+    std::cerr << "用法: " << program << " [选项]\n"
+              << "  --address <地址>       监听地址，默认 0.0.0.0\n"
+              << "  --port <端口>          第一台机器狗的端口，第 i 台监听 port + i，默认 30000\n"
+              << "  --robots <台数>        模拟的机器狗台数，默认 100\n"
+              << "  --threads <线程数>     IO 线程数，默认为硬件并发数\n"
+              << "  --latency-ms <毫秒>    每个响应的固定延迟，默认 0\n"
+              << "  --jitter-ms <毫秒>     叠加在固定延迟上的均匀随机延迟上限，默认 0\n"
+              << "  --drop <概率>          不回复请求的概率，取值 [0, 1]，默认 0\n"
+              << "  --segment <字节>       把写出的数据随机拆成不超过该长度的分段，0 表示不拆分\n"
+              << "  --coalesce-ms <毫秒>   把该窗口内就绪的响应合并为一次写出，0 表示不合并\n"
+              << "  --duration <秒>        运行时长，0 表示直到按 Ctrl+C，默认 0\n";
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    example::MockServerOptions options;
+    options.port = 30000;
+    options.robotCount = 100;
+    options.threadCount = std::max(1u, std::thread::hardware_concurrency());
+    options.verbose = false;
+    int duration = 0;
+
+    try {
+        for (int i = 1; i < argc; ++i) {
+            const std::string arg = argv[i];
+            if (arg == "--help" || arg == "-h") {
+                printUsage(argv[0]);
+                return 0;
+            }
+            if (i + 1 >= argc) {
+                std::cerr << "缺少选项的值: " << arg << std::endl;
+                printUsage(argv[0]);
+                return 1;
+            }
+
+            const std::string value = argv[++i];
+            if (arg == "--address") {
+                options.address = value;
+            } else if (arg == "--port") {
+                options.port = static_cast<uint16_t>(std::stoi(value));
+            } else if (arg == "--robots") {
+                options.robotCount = static_cast<size_t>(std::stoul(value));
+            } else if (arg == "--threads") {
+                options.threadCount = static_cast<size_t>(std::stoul(value));
+            } else if (arg == "--latency-ms") {
+                options.responseLatency = millisToMicros(value);
+            } else if (arg == "--jitter-ms") {
+                options.responseJitter = millisToMicros(value);
+            } else if (arg == "--drop") {
+                options.dropRate = std::stod(value);
+            } else if (arg == "--segment") {
+                options.maxSegmentSize = static_cast<size_t>(std::stoul(value));
+            } else if (arg == "--coalesce-ms") {
+                options.coalesceWindow = millisToMicros(value);
+            } else if (arg == "--duration") {
+                duration = std::stoi(value);
+            } else {
+                std::cerr << "未知的选项: " << arg << std::endl;
+                printUsage(argv[0]);
+                return 1;
+            }
+        }
+    } catch (const std::exception&) {
+        std::cerr << "选项的值无效" << std::endl;
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    raiseOpenFileLimit();
+    std::signal(SIGINT, onSignal);
+    std::signal(SIGTERM, onSignal);
+
+    try {
+        example::MockServer server(options);
+        server.start();
+
+        std::cout << "模拟 " << server.robotCount() << " 台机器狗，端口 " << server.port(0) << "-"
+                  << server.port(server.robotCount() - 1) << "，" << options.threadCount << " 个 IO 线程"
+                  << (duration > 0 ? "" : "，按 Ctrl+C 停止") << std::endl;
+
+        // 每秒打印一次统计
+        const example::MockServerStats& stats = server.stats();
+        uint64_t lastRequests = 0;
+        uint64_t lastResponses = 0;
+        uint64_t lastBytes = 0;
+        for (int second = 1; !g_stop && (duration <= 0 || second <= duration); ++second) {
+            std::this_thread::sleep_for(std::chrono::seconds(1));
+
+            const uint64_t requests = stats.requests.load();
+            const uint64_t responses = stats.responses.load();
+            const uint64_t bytes = stats.bytesSent.load();
+            std::printf("[%4ds] 连接 %6llu  请求 %8llu/s  响应 %8llu/s  发送 %8.2f MB/s  累计丢弃 %llu\n", second,
+                        static_cast<unsigned long long>(stats.connections.load()),
+                        static_cast<unsigned long long>(requests - lastRequests),
+                        static_cast<unsigned long long>(responses - lastResponses),
+                        static_cast<double>(bytes - lastBytes) / (1024.0 * 1024.0),
+                        static_cast<unsigned long long>(stats.dropped.load()));
+            std::fflush(stdout);
+            lastRequests = requests;
+            lastResponses = responses;
+            lastBytes = bytes;
+        }
+
+        server.stop();
+        std::printf("共收到请求 %llu，回复 %llu，丢弃 %llu\n",
+                    static_cast<unsigned long long>(stats.requests.load()),
+                    static_cast<unsigned long long>(stats.responses.load()),
+                    static_cast<unsigned long long>(stats.dropped.load()));
+    } catch (const std::exception& e) {
+        std::cerr << "发生异常: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,829 @@
+#pragma once
+
+#include <iostream>
+#include <boost/asio.hpp>
+#include <thread>
+#include <chrono>
+#include <nlohmann/json.hpp>
+#include <random>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <deque>
+#include <ctime>
+#include <iomanip>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <rapidxml/rapidxml.hpp>
+
+/**
+ * @brief 模拟机器狗服务端
+ *
+ * 既是独立的示例程序（mock_server.cpp）与机器狗集群模拟器（fleet_simulator.cpp），
+ * 也可以在进程内启动，供基准测试等场景使用：
+ *
+ *     example::MockServer server(0, "127.0.0.1", false);
+ *     server.start();
+ *     sdk.connect("127.0.0.1", server.port());
+ */
+namespace example {
+
+using boost::asio::ip::tcp;
+
+/**
+ * @brief 获取当前时间戳字符串
+ * @note 线程安全，多个 IO 线程可同时调用
+ */
+inline std::string getCurrentTimestamp() {
+    auto now = std::chrono::system_clock::now();
+    auto time_t_now = std::chrono::system_clock::to_time_t(now);
+    std::tm local{};
+#ifdef _WIN32
+    localtime_s(&local, &time_t_now);
+#else
+    localtime_r(&time_t_now, &local);
+#endif
+    std::stringstream ss;
+    ss << std::put_time(&local, "%Y-%m-%d %H:%M:%S");
+    return ss.str();
+}
+
+/**
+ * @brief 本线程的随机数引擎，只在首次使用时播种，避免每个请求都读取 std::random_device
+ */
+inline std::mt19937& randomEngine() {
+    thread_local std::mt19937 engine{std::random_device{}()};
+    return engine;
+}
+
+// XML 格式的请求处理方法，输入为请求消息体，返回响应消息体，失败时返回空字符串
+inline std::string handleGetRealTimeStatusRequestXml(const std::string& request_data) {
+    try {
+        rapidxml::xml_document<> doc;
+        std::vector<char> buffer(request_data.begin(), request_data.end());
+        buffer.push_back('\0');
+        doc.parse<rapidxml::parse_non_destructive>(&buffer[0]);
+
+        rapidxml::xml_node<>* root = doc.first_node("PatrolDevice");
+        if (!root) return "";
+
+        rapidxml::xml_node<>* time_node = root->first_node("Time");
+        std::string timestamp = time_node ? time_node->value() : getCurrentTimestamp();
+
+        // 生成随机数据
+        std::mt19937& gen = randomEngine();
+        std::uniform_real_distribution<> pos_dis(-10.0, 10.0);
+        std::uniform_real_distribution<> angle_dis(-3.14, 3.14);
+        std::uniform_real_distribution<> speed_dis(0.0, 5.0);
+        std::uniform_int_distribution<> int_dis(0, 100);
+
+        std::stringstream ss;
+        ss << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n";
+        ss << "<PatrolDevice>\n";
+        ss << "  <Type>1002</Type>\n";
+        ss << "  <Command>1</Command>\n";
+        ss << "  <Time>" << timestamp << "</Time>\n";
+        ss << "  <Items>\n";
+        ss << "    <MotionState>" << int_dis(gen) % 5 << "</MotionState>\n";
+        ss << "    <PosX>" << pos_dis(gen) << "</PosX>\n";
+        ss << "    <PosY>" << pos_dis(gen) << "</PosY>\n";
+        ss << "    <PosZ>" << pos_dis(gen) / 10.0 << "</PosZ>\n";
+        ss << "    <AngleYaw>" << angle_dis(gen) << "</AngleYaw>\n";
+        ss << "    <Roll>" << angle_dis(gen) / 10.0 << "</Roll>\n";
+        ss << "    <Pitch>" << angle_dis(gen) / 10.0 << "</Pitch>\n";
+        ss << "    <Yaw>" << angle_dis(gen) << "</Yaw>\n";
+        ss << "    <Speed>" << speed_dis(gen) << "</Speed>\n";
+        ss << "    <CurOdom>" << pos_dis(gen) + 10.0 << "</CurOdom>\n";
+        ss << "    <SumOdom>" << pos_dis(gen) + 100.0 << "</SumOdom>\n";
+        ss << "    <CurRuntime>" << int_dis(gen) * 100 << "</CurRuntime>\n";
+        ss << "    <SumRuntime>" << int_dis(gen) * 10000 << "</SumRuntime>\n";
+        ss << "    <Res>" << pos_dis(gen) / 100.0 + 0.1 << "</Res>\n";
+        ss << "    <X0>" << pos_dis(gen) << "</X0>\n";
+        ss << "    <Y0>" << pos_dis(gen) << "</Y0>\n";
+        ss << "    <H>" << int_dis(gen) + 200 << "</H>\n";
+        ss << "    <Electricity>" << int_dis(gen) << "</Electricity>\n";
+        ss << "    <Location>" << int_dis(gen) % 2 << "</Location>\n";
+        ss << "    <RTKState>" << int_dis(gen) % 2 << "</RTKState>\n";
+        ss << "    <OnDockState>" << int_dis(gen) % 2 << "</OnDockState>\n";
+        ss << "    <GaitState>" << int_dis(gen) % 3 << "</GaitState>\n";
+        ss << "    <MotorState>" << int_dis(gen) % 2 << "</MotorState>\n";
+        ss << "    <ChargeState>" << int_dis(gen) % 2 << "</ChargeState>\n";
+        ss << "    <ControlMode>" << int_dis(gen) % 3 << "</ControlMode>\n";
+        ss << "    <MapUpdateState>" << int_dis(gen) % 2 << "</MapUpdateState>\n";
+        ss << "  </Items>\n";
+        ss << "</PatrolDevice>";
+
+        return ss.str();
+    } catch (const std::exception& e) {
+        std::cerr << "处理获取实时状态请求异常: " << e.what() << std::endl;
+        return "";
+    }
+}
+
+inline std::string handleNavigationTaskRequestXml(const std::string& request_data) {
+    try {
+        rapidxml::xml_document<> doc;
+        std::vector<char> buffer(request_data.begin(), request_data.end());
+        buffer.push_back('\0');
+        doc.parse<rapidxml::parse_non_destructive>(&buffer[0]);
+
+        rapidxml::xml_node<>* root = doc.first_node("PatrolDevice");
+        if (!root) return "";
+
+        rapidxml::xml_node<>* time_node = root->first_node("Time");
+        std::string timestamp = time_node ? time_node->value() : getCurrentTimestamp();
+
+        // 获取第一个导航点的 Value
+        int value = 0;
+        for (rapidxml::xml_node<>* items_node = root->first_node("Items");
+             items_node;
+             items_node = items_node->next_sibling("Items")) {
+
+            rapidxml::xml_node<>* value_node = items_node->first_node("Value");
+            if (value_node) {
+                value = std::stoi(value_node->value());
+                break;
+            }
+        }
+
+        // 随机生成错误码
+        std::mt19937& gen = randomEngine();
+        std::uniform_int_distribution<> error_dis(0, 10);
+        int error_code = error_dis(gen) < 8 ? 0 : 1; // 80% 成功率
+
+        std::stringstream ss;
+        ss << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n";
+        ss << "<PatrolDevice>\n";
+        ss << "<Type>1003</Type>\n";
+        ss << "<Command>1</Command>\n";
+        ss << "<Time>" << timestamp << "</Time>\n";
+        ss << "<Items>\n";
+        ss << "  <Value>" << value << "</Value>\n";
+        ss << "  <ErrorCode>" << error_code << "</ErrorCode>\n";
+        ss << "  <ErrorStatus>0</ErrorStatus>\n";
+        ss << "</Items>\n";
+        ss << "</PatrolDevice>";
+
+        return ss.str();
+    } catch (const std::exception& e) {
+        std::cerr << "处理导航任务请求异常: " << e.what() << std::endl;
+        return "";
+    }
+}
+
+inline std::string handleQueryStatusRequestXml(const std::string& request_data) {
+    try {
+        rapidxml::xml_document<> doc;
+        std::vector<char> buffer(request_data.begin(), request_data.end());
+        buffer.push_back('\0');
+        doc.parse<rapidxml::parse_non_destructive>(&buffer[0]);
+
+        rapidxml::xml_node<>* root = doc.first_node("PatrolDevice");
+        if (!root) return "";
+
+        rapidxml::xml_node<>* time_node = root->first_node("Time");
+        std::string timestamp = time_node ? time_node->value() : getCurrentTimestamp();
+
+        // 随机生成状态
+        std::mt19937& gen = randomEngine();
+        std::uniform_int_distribution<> status_dis(0, 2);
+        int status = status_dis(gen);
+        if (status == 2) status = -1; // 将2映射为-1
+
+        std::stringstream ss;
+        ss << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n";
+        ss << "<PatrolDevice>\n";
+        ss << "<Type>1007</Type>\n";
+        ss << "<Command>1</Command>\n";
+        ss << "<Time>" << timestamp << "</Time>\n";
+        ss << "<Items>\n";
+        ss << "  <Value>0</Value>\n";
+        ss << "  <Status>" << status << "</Status>\n";
+        ss << "  <ErrorCode>0</ErrorCode>\n";
+        ss << "</Items>\n";
+        ss << "</PatrolDevice>";
+
+        return ss.str();
+    } catch (const std::exception& e) {
+        std::cerr << "处理查询状态请求异常: " << e.what() << std::endl;
+        return "";
+    }
+}
+
+inline std::string handleCancelTaskRequestXml(const std::string& request_data) {
+    try {
+        rapidxml::xml_document<> doc;
+        std::vector<char> buffer(request_data.begin(), request_data.end());
+        buffer.push_back('\0');
+        doc.parse<rapidxml::parse_non_destructive>(&buffer[0]);
+
+        rapidxml::xml_node<>* root = doc.first_node("PatrolDevice");
+        if (!root) return "";
+
+        rapidxml::xml_node<>* time_node = root->first_node("Time");
+        std::string timestamp = time_node ? time_node->value() : getCurrentTimestamp();
+
+        // 随机生成错误码
+        std::mt19937& gen = randomEngine();
+        std::uniform_int_distribution<> error_dis(0, 10);
+        int error_code = error_dis(gen) < 9 ? 0 : 1; // 90% 成功率
+
+        std::stringstream ss;
+        ss << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n";
+        ss << "<PatrolDevice>\n";
+        ss << "<Type>1004</Type>\n";
+        ss << "<Command>1</Command>\n";
+        ss << "<Time>" << timestamp << "</Time>\n";
+        ss << "<Items>\n";
+        ss << " <ErrorCode>" << error_code << "</ErrorCode>\n";
+        ss << "</Items>\n";
+        ss << "</PatrolDevice>";
+
+        return ss.str();
+    } catch (const std::exception& e) {
+        std::cerr << "处理取消任务请求异常: " << e.what() << std::endl;
+        return "";
+    }
+}
+
+/**
+ * @brief 模拟服务器配置
+ */
+struct MockServerOptions {
+    std::string address = "0.0.0.0";               ///< 监听地址
+    uint16_t port = 8080;                           ///< 第一台机器狗的监听端口，为 0 时每台都由系统分配
+    size_t robotCount = 1;                          ///< 模拟的机器狗台数，第 i 台监听 port + i
+    size_t threadCount = 1;                         ///< IO 线程数，所有机器狗共享
+    bool verbose = true;                            ///< 是否打印连接与请求日志，压测和基准测试中应关闭
+    std::chrono::microseconds responseLatency{0};   ///< 每个响应的固定延迟
+    std::chrono::microseconds responseJitter{0};    ///< 在固定延迟上叠加 [0, responseJitter] 的均匀随机延迟，响应可能因此乱序
+    double dropRate = 0.0;                          ///< 收到请求后不回复的概率，取值 [0, 1]
+    size_t maxSegmentSize = 0;                      ///< 大于 0 时把每次写出的数据随机拆成不超过该长度的多次写入，模拟帧跨越多个 TCP 分段
+    std::chrono::microseconds coalesceWindow{0};    ///< 大于 0 时把该窗口内就绪的响应合并为一次写入，模拟一个 TCP 分段包含多个帧
+};
+
+/**
+ * @brief 模拟服务器的统计计数，可在任意线程读取
+ */
+struct MockServerStats {
+    std::atomic<uint64_t> connections{0};   ///< 当前连接数
+    std::atomic<uint64_t> requests{0};      ///< 收到的请求数
+    std::atomic<uint64_t> responses{0};     ///< 进入发送队列的响应数
+    std::atomic<uint64_t> dropped{0};       ///< 按 dropRate 丢弃、未回复的请求数
+    std::atomic<uint64_t> bytesSent{0};     ///< 已写出的字节数
+};
+
+/**
+ * @brief 模拟服务器类
+ *
+ * 每台模拟机器狗一个监听端口，所有连接由一组 IO 线程处理，每个连接的处理在各自的 strand 上串行执行。
+ */
+class MockServer {
+public:
+    /**
+     * @brief 构造函数，按配置监听 robotCount 个端口
+     * @throws std::runtime_error 端口被占用或超出文件描述符上限时抛出
+     */
+    explicit MockServer(const MockServerOptions& options)
+        : options_(options),
+          running_(false) {
+        const auto address = boost::asio::ip::make_address(options_.address);
+        for (size_t i = 0; i < std::max<size_t>(options_.robotCount, 1); ++i) {
+            const uint16_t port = options_.port == 0 ? 0 : static_cast<uint16_t>(options_.port + i);
+            const tcp::endpoint endpoint(address, port);
+
+            auto acceptor = std::make_unique<tcp::acceptor>(io_context_);
+            try {
+                acceptor->open(endpoint.protocol());
+
+                // 设置地址重用选项，必须在 bind 之前设置才生效
+                boost::asio::socket_base::reuse_address option(true);
+                acceptor->set_option(option);
+                acceptor->bind(endpoint);
+                acceptor->listen();
+            } catch (const boost::system::system_error& e) {
+                throw std::runtime_error("无法监听 " + options_.address + ":" + std::to_string(port) + ": " + e.what());
+            }
+            acceptors_.push_back(std::move(acceptor));
+        }
+    }
+
+    /**
+     * @brief 构造函数，模拟一台机器狗、单个 IO 线程
+     * @param port 监听端口，为 0 时由系统分配，可通过 port() 查询
+     * @param address 监听地址
+     * @param verbose 是否打印连接与请求日志，基准测试中应关闭
+     */
+    explicit MockServer(uint16_t port, const std::string& address = "0.0.0.0", bool verbose = true)
+        : MockServer(makeOptions(port, address, verbose)) {
+    }
+
+    ~MockServer() {
+        stop();
+    }
+
+    void start() {
+        if (running_) {
+            return;
+        }
+
+        running_ = true;
+        if (options_.verbose) {
+            if (acceptors_.size() == 1) {
+                std::cout << "模拟服务器已启动，监听端口: " << port() << std::endl;
+            } else {
+                std::cout << "模拟服务器已启动，模拟 " << acceptors_.size() << " 台机器狗，监听端口: "
+                          << port(0) << "-" << port(acceptors_.size() - 1) << std::endl;
+            }
+        }
+
+        // 启动接受连接
+        for (auto& acceptor : acceptors_) {
+            startAccept(*acceptor);
+        }
+
+        // 启动IO线程
+        for (size_t i = 0; i < std::max<size_t>(options_.threadCount, 1); ++i) {
+            io_threads_.emplace_back([this]() {
+                try {
+                    io_context_.run();
+                } catch (const std::exception& e) {
+                    std::cerr << "IO线程异常: " << e.what() << std::endl;
+                }
+            });
+        }
+    }
+
+    void stop() {
+        if (!running_) {
+            return;
+        }
+
+        running_ = false;
+        io_context_.stop();
+
+        for (auto& thread : io_threads_) {
+            if (thread.joinable()) {
+                thread.join();
+            }
+        }
+        io_threads_.clear();
+
+        if (options_.verbose) {
+            std::cout << "模拟服务器已停止" << std::endl;
+        }
+    }
+
+    /**
+     * @brief 第 robot 台模拟机器狗实际监听的端口
+     */
+    uint16_t port(size_t robot = 0) const {
+        return acceptors_.at(robot)->local_endpoint().port();
+    }
+
+    /**
+     * @brief 模拟的机器狗台数
+     */
+    size_t robotCount() const {
+        return acceptors_.size();
+    }
+
+    /**
+     * @brief 统计计数
+     */
+    const MockServerStats& stats() const {
+        return stats_;
+    }
+
+private:
+    static MockServerOptions makeOptions(uint16_t port, const std::string& address, bool verbose) {
+        MockServerOptions options;
+        options.port = port;
+        options.address = address;
+        options.verbose = verbose;
+        return options;
+    }
+
+    void startAccept(tcp::acceptor& acceptor) {
+        // 每个连接的 socket 绑定独立的 strand，多个 IO 线程下同一连接的处理仍然串行
+        auto socket = std::make_shared<tcp::socket>(boost::asio::make_strand(io_context_));
+        acceptor.async_accept(*socket, [this, &acceptor, socket](const boost::system::error_code& error) {
+            if (!error) {
+                boost::system::error_code ec;
+                socket->set_option(tcp::no_delay(true), ec);
+                if (options_.verbose) {
+                    std::cout << "接受新连接: " << socket->remote_endpoint(ec) << std::endl;
+                }
+
+                // 启动会话
+                startSession(socket);
+            } else if (error != boost::asio::error::operation_aborted) {
+                std::cerr << "接受连接错误: " << error.message() << std::endl;
+            }
+
+            // 继续接受下一个连接
+            if (running_) {
+                startAccept(acceptor);
+            }
+        });
+    }
+
+    void startSession(std::shared_ptr<tcp::socket> socket) {
+        auto session = std::make_shared<Session>(socket, options_, stats_);
+        session->start();
+    }
+
+    /**
+     * @brief 会话类
+     *
+     * 按 SDK 使用的帧格式收发：16 字节协议头（4 字节同步字 EB 90 EB 90、2 字节小端消息体长度、
+     * 2 字节序列号、8 字节保留）后跟 XML 消息体。响应沿用请求的序列号，SDK 据此匹配请求。
+     * 所有处理都在 socket 的 strand 上执行。
+     */
+    class Session : public std::enable_shared_from_this<Session> {
+    public:
+        Session(std::shared_ptr<tcp::socket> socket, const MockServerOptions& options, MockServerStats& stats)
+            : socket_(socket),
+              options_(options),
+              stats_(stats),
+              verbose_(options.verbose),
+              coalesce_timer_(socket->get_executor()) {
+            ++stats_.connections;
+        }
+
+        ~Session() {
+            --stats_.connections;
+        }
+
+        void start() {
+            readHeader();
+        }
+
+    private:
+        static constexpr std::size_t HEADER_SIZE = 16;
+
+        void readHeader() {
+            auto self = shared_from_this();
+            boost::asio::async_read(
+                *socket_,
+                boost::asio::buffer(header_),
+                [this, self](const boost::system::error_code& error, std::size_t) {
+                    if (error) {
+                        reportReceiveError(error);
+                        return;
+                    }
+
+                    if (header_[0] != 0xeb || header_[1] != 0x90 || header_[2] != 0xeb || header_[3] != 0x90) {
+                        // 同步字错误，无法再确定帧边界，关闭连接
+                        std::cerr << "协议头同步字错误，关闭连接" << std::endl;
+                        boost::system::error_code ec;
+                        socket_->close(ec);
+                        return;
+                    }
+
+                    const std::size_t length = static_cast<std::size_t>(header_[4]) |
+                                               (static_cast<std::size_t>(header_[5]) << 8);
+                    readBody(length);
+                }
+            );
+        }
+
+        void readBody(std::size_t length) {
+            auto self = shared_from_this();
+            body_.resize(length);
+            boost::asio::async_read(
+                *socket_,
+                boost::asio::buffer(&body_[0], body_.size()),
+                [this, self](const boost::system::error_code& error, std::size_t) {
+                    if (error) {
+                        reportReceiveError(error);
+                        return;
+                    }
+
+                    // 处理接收到的请求
+                    ++stats_.requests;
+                    handleRequest(body_);
+
+                    // 继续接收下一帧
+                    readHeader();
+                }
+            );
+        }
+
+        void reportReceiveError(const boost::system::error_code& error) {
+            if (error != boost::asio::error::operation_aborted && error != boost::asio::error::eof) {
+                std::cerr << "接收数据错误: " << error.message() << std::endl;
+            }
+        }
+
+        void handleRequest(const std::string& request_data) {
+            try {
+                std::string response_data;
+
+                // 检查是否为 XML 格式
+                if (request_data.find("<?xml") != std::string::npos || request_data.find("<PatrolDevice>") != std::string::npos) {
+                    // 解析 XML
+                    rapidxml::xml_document<> doc;
+                    std::vector<char> buffer(request_data.begin(), request_data.end());
+                    buffer.push_back('\0');
+                    doc.parse<rapidxml::parse_non_destructive>(&buffer[0]);
+
+                    rapidxml::xml_node<>* root = doc.first_node("PatrolDevice");
+                    if (!root) {
+                        std::cerr << "无效的 XML 请求" << std::endl;
+                        return;
+                    }
+
+                    rapidxml::xml_node<>* type_node = root->first_node("Type");
+                    if (!type_node) {
+                        std::cerr << "XML 请求缺少 Type 字段" << std::endl;
+                        return;
+                    }
+
+                    int type = std::stoi(type_node->value());
+
+                    // 根据 Type 处理不同类型的请求
+                    switch (type) {
+                        case 1002: // 获取实时状态
+                            response_data = handleGetRealTimeStatusRequestXml(request_data);
+                            break;
+                        case 1003: // 导航任务
+                            response_data = handleNavigationTaskRequestXml(request_data);
+                            break;
+                        case 1004: // 取消任务
+                            response_data = handleCancelTaskRequestXml(request_data);
+                            break;
+                        case 1007: // 查询任务状态
+                            response_data = handleQueryStatusRequestXml(request_data);
+                            break;
+                        default:
+                            std::cerr << "未知的请求类型: " << type << std::endl;
+                            return;
+                    }
+                } else {
+                    // 尝试解析为 JSON 格式（兼容旧代码）
+                    auto j = nlohmann::json::parse(request_data);
+
+                    // 根据消息内容判断类型
+                    if (j.contains("points")) {
+                        response_data = handleNavigationTaskRequest(j);
+                    } else if (j.contains("timestamp") && j.size() == 1) {
+                        // 这里无法区分几种只有timestamp的请求，根据随机数决定
+                        std::uniform_int_distribution<> dis(0, 2);
+                        int req_type = dis(randomEngine());
+
+                        switch (req_type) {
+                            case 0:
+                                response_data = handleGetRealTimeStatusRequest(j);
+                                break;
+                            case 1:
+                                response_data = handleQueryStatusRequest(j);
+                                break;
+                            case 2:
+                                response_data = handleCancelTaskRequest(j);
+                                break;
+                        }
+                    }
+                }
+
+                if (!response_data.empty()) {
+                    // 发送响应
+                    sendResponse(response_data);
+                }
+            } catch (const std::exception& e) {
+                std::cerr << "处理请求异常: " << e.what() << std::endl;
+            }
+        }
+
+        std::string handleNavigationTaskRequest(const nlohmann::json&) {
+            if (verbose_) {
+                std::cout << "收到导航任务请求" << std::endl;
+            }
+
+            // 生成响应
+            nlohmann::json response;
+            response["value"] = 1; // 目标点编号
+            response["errorCode"] = 0; // 成功
+            response["errorStatus"] = 0;
+            response["timestamp"] = getCurrentTimestamp();
+
+            return response.dump();
+        }
+
+        std::string handleGetRealTimeStatusRequest(const nlohmann::json&) {
+            if (verbose_) {
+                std::cout << "收到获取实时状态请求" << std::endl;
+            }
+
+            // 生成随机状态
+            std::mt19937& gen = randomEngine();
+            std::uniform_real_distribution<> pos_dis(-100.0, 100.0);
+            std::uniform_real_distribution<> angle_dis(0.0, 360.0);
+            std::uniform_real_distribution<> speed_dis(0.0, 5.0);
+            std::uniform_int_distribution<> electricity_dis(0, 100);
+
+            // 生成响应
+            nlohmann::json response;
+            response["motionState"] = 1; // 运动中
+            response["posX"] = pos_dis(gen);
+            response["posY"] = pos_dis(gen);
+            response["posZ"] = 0.0;
+            response["angleYaw"] = angle_dis(gen);
+            response["roll"] = 0.0;
+            response["pitch"] = 0.0;
+            response["yaw"] = angle_dis(gen);
+            response["speed"] = speed_dis(gen);
+            response["curOdom"] = 0.0;
+            response["sumOdom"] = 0.0;
+            response["curRuntime"] = 0;
+            response["sumRuntime"] = 0;
+            response["res"] = 0.0;
+            response["x0"] = 0.0;
+            response["y0"] = 0.0;
+            response["h"] = 0;
+            response["electricity"] = electricity_dis(gen);
+            response["location"] = 0;
+            response["RTKState"] = 0;
+            response["onDockState"] = 0;
+            response["gaitState"] = 0;
+            response["motorState"] = 0;
+            response["chargeState"] = 0;
+            response["controlMode"] = 0;
+            response["mapUpdateState"] = 0;
+            response["timestamp"] = getCurrentTimestamp();
+
+            return response.dump();
+        }
+
+        std::string handleQueryStatusRequest(const nlohmann::json&) {
+            if (verbose_) {
+                std::cout << "收到查询任务状态请求" << std::endl;
+            }
+
+            // 生成随机状态
+            std::mt19937& gen = randomEngine();
+            std::uniform_int_distribution<> status_dis(0, 2);
+            int status = status_dis(gen);
+            if (status == 2) status = -1; // 失败状态
+
+            // 生成响应
+            nlohmann::json response;
+            response["value"] = 1; // 目标点编号
+            response["status"] = status;
+            response["errorCode"] = 0;
+            response["timestamp"] = getCurrentTimestamp();
+
+            return response.dump();
+        }
+
+        std::string handleCancelTaskRequest(const nlohmann::json&) {
+            if (verbose_) {
+                std::cout << "收到取消任务请求" << std::endl;
+            }
+
+            // 生成响应
+            nlohmann::json response;
+            response["errorCode"] = 0; // 成功
+            response["timestamp"] = getCurrentTimestamp();
+
+            return response.dump();
+        }
+
+        void sendResponse(const std::string& response_data) {
+            if (options_.dropRate > 0.0 &&
+                std::uniform_real_distribution<>(0.0, 1.0)(randomEngine()) < options_.dropRate) {
+                ++stats_.dropped;
+                return;
+            }
+
+            // 协议头 + 消息体，序列号沿用请求的序列号（header_ 中的原始字节）
+            std::string frame;
+            frame.reserve(HEADER_SIZE + response_data.size());
+            frame.push_back(static_cast<char>(0xeb));
+            frame.push_back(static_cast<char>(0x90));
+            frame.push_back(static_cast<char>(0xeb));
+            frame.push_back(static_cast<char>(0x90));
+            frame.push_back(static_cast<char>(response_data.size() & 0xff));
+            frame.push_back(static_cast<char>((response_data.size() >> 8) & 0xff));
+            frame.push_back(static_cast<char>(header_[6]));
+            frame.push_back(static_cast<char>(header_[7]));
+            frame.append(HEADER_SIZE - 8, '\0');
+            frame.append(response_data);
+
+            auto delay = options_.responseLatency;
+            if (options_.responseJitter.count() > 0) {
+                delay += std::chrono::microseconds(std::uniform_int_distribution<int64_t>(
+                    0, options_.responseJitter.count())(randomEngine()));
+            }
+            if (delay.count() <= 0) {
+                enqueue(std::move(frame));
+                return;
+            }
+
+            // 延迟期间继续接收后续请求，各响应按各自的到期时间发出
+            auto self = shared_from_this();
+            auto timer = std::make_shared<boost::asio::steady_timer>(socket_->get_executor(), delay);
+            timer->async_wait([this, self, timer, frame = std::move(frame)](const boost::system::error_code& error) mutable {
+                if (!error) {
+                    enqueue(std::move(frame));
+                }
+            });
+        }
+
+        void enqueue(std::string frame) {
+            ++stats_.responses;
+            if (options_.coalesceWindow.count() <= 0) {
+                write(std::move(frame));
+                return;
+            }
+
+            // 窗口内就绪的响应先攒在一起，窗口结束时一次写出
+            pending_ += frame;
+            if (coalescing_) {
+                return;
+            }
+            coalescing_ = true;
+            coalesce_timer_.expires_after(options_.coalesceWindow);
+            auto self = shared_from_this();
+            coalesce_timer_.async_wait([this, self](const boost::system::error_code&) {
+                coalescing_ = false;
+                std::string data;
+                data.swap(pending_);
+                write(std::move(data));
+            });
+        }
+
+        void write(std::string data) {
+            if (options_.maxSegmentSize > 0) {
+                // 随机拆成多次写入，对端会在多次读取中收到同一个帧
+                std::uniform_int_distribution<size_t> size_dis(1, options_.maxSegmentSize);
+                for (size_t offset = 0; offset < data.size();) {
+                    const size_t n = std::min(size_dis(randomEngine()), data.size() - offset);
+                    outbox_.push_back(std::make_shared<std::string>(data, offset, n));
+                    offset += n;
+                }
+            } else {
+                outbox_.push_back(std::make_shared<std::string>(std::move(data)));
+            }
+
+            // 同一会话的数据按顺序写出，前一次写完成之前不能开始下一次
+            if (!writing_) {
+                writeNext();
+            }
+        }
+
+        void writeNext() {
+            writing_ = true;
+            auto self = shared_from_this();
+            boost::asio::async_write(
+                *socket_,
+                boost::asio::buffer(*outbox_.front()),
+                [this, self](const boost::system::error_code& error, std::size_t bytes_transferred) {
+                    if (error) {
+                        if (error != boost::asio::error::operation_aborted) {
+                            std::cerr << "发送响应错误: " << error.message() << std::endl;
+                        }
+                        // 连接已不可用，关闭后接收链路随之结束
+                        outbox_.clear();
+                        boost::system::error_code ec;
+                        socket_->close(ec);
+                        return;
+                    }
+
+                    stats_.bytesSent += bytes_transferred;
+                    outbox_.pop_front();
+                    if (outbox_.empty()) {
+                        writing_ = false;
+                    } else {
+                        writeNext();
+                    }
+                }
+            );
+        }
+
+        std::shared_ptr<tcp::socket> socket_;
+        const MockServerOptions& options_;
+        MockServerStats& stats_;
+        bool verbose_;
+        std::array<uint8_t, HEADER_SIZE> header_{};
+        std::string body_;
+        std::deque<std::shared_ptr<std::string>> outbox_;
+        bool writing_ = false;
+        boost::asio::steady_timer coalesce_timer_;
+        std::string pending_;
+        bool coalescing_ = false;
+    };
+
+    // options_ 与 stats_ 被会话引用，必须先于 io_context_（及其中未完成的会话）构造、后于其析构
+    MockServerOptions options_;
+    MockServerStats stats_;
+    boost::asio::io_context io_context_;
+    std::vector<std::unique_ptr<tcp::acceptor>> acceptors_;
+    std::vector<std::thread> io_threads_;
+    std::atomic<bool> running_;
+};
+
+} // namespace example
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+
+namespace network {
+class IoService;
+}
+
+namespace robotserver_sdk {
+
+class RobotServerSdkImpl;
+
+/**
+ * @brief 多个 RobotServerSdk 连接共享的IO线程池
+ *
+ * 默认每个 RobotServerSdk 使用一个独占的IO线程。管理大量机器狗时，创建一个 IoThreadPool
+ * 并通过 SdkOptions::ioThreadPool 传给每个 RobotServerSdk，所有连接在同一个 io_context 上
+ * 由固定数量的IO线程处理，每个连接的收发和回调仍在各自的 strand 上串行执行。
+ *
+ * 线程池在最后一个使用它的 RobotServerSdk 析构后才真正停止。
+ */
+class IoThreadPool {
+public:
+    /**
+     * @brief 构造函数，立即启动IO线程
+     * @param threadCount IO线程数，0 表示使用硬件并发数
+     */
+    explicit IoThreadPool(size_t threadCount = 0);
+
+    /**
+     * @brief 析构函数
+     */
+    ~IoThreadPool();
+
+    /**
+     * @brief 禁用拷贝构造函数
+     */
+    IoThreadPool(const IoThreadPool&) = delete;
+
+    /**
+     * @brief 禁用赋值操作符
+     */
+    IoThreadPool& operator=(const IoThreadPool&) = delete;
+
+    /**
+     * @brief 获取IO线程数
+     * @return IO线程数
+     */
+    size_t threadCount() const;
+
+private:
+    friend class RobotServerSdkImpl;
+
+    std::shared_ptr<network::IoService> service_;
+};
+
+} // namespace robotserver_sdk
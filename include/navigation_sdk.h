@@ -1,6 +1,10 @@
 #pragma once
 
 #include "types.h"
+#include "io_thread_pool.h"
+#include "sdk_logging.h"
+#include "sdk_metrics.h"
+#include "request_awaitable.h"
 #include <memory>
 #include <string>
 #include <future>
@@ -64,6 +68,64 @@ public:
      */
     RealTimeStatus request1002_RunTimeStatus();
 
+    /**
+     * @brief request1002 基于回调的异步获取实时状态，不阻塞调用线程
+     * @param callback 结果回调函数，恰好调用一次；通常在IO线程中调用，不应执行长时间操作，
+     *                 也不应在其中调用同步接口。未连接时在调用线程中立即调用
+     * @param timeout 本请求的超时时间，为 0 时使用 SdkOptions::requestTimeout
+     * @note 设置了 SdkOptions::maxInFlightRequests 且窗口已满时，本函数阻塞到有请求完成为止，
+     *       等待时间计入 timeout；在回调（IO线程）中调用时不等待，窗口已满直接以超时结束
+     */
+    void request1002_RunTimeStatus(RealTimeStatusCallback callback,
+                                   std::chrono::milliseconds timeout = std::chrono::milliseconds::zero());
+
+    /**
+     * @brief request1002 基于 std::future 的异步获取实时状态
+     * @param timeout 本请求的超时时间，为 0 时使用 SdkOptions::requestTimeout
+     * @return 实时状态信息的 future，超时或断开连接时以对应错误码就绪
+     */
+    std::future<RealTimeStatus> request1002_RunTimeStatusAsync(
+        std::chrono::milliseconds timeout = std::chrono::milliseconds::zero());
+
+    /**
+     * @brief 读取最近一次收到的实时状态，不发出请求、不阻塞
+     * @param status 输出最近一次成功的 1002 结果（来自任意 1002 请求或订阅）
+     * @param updatedAt 输出收到该结果的时间
+     * @return 尚未收到过实时状态时返回 false
+     * @note 设置 SdkOptions::realTimeStatusMaxStaleness 后，1002 查询在缓存足够新时直接返回缓存
+     */
+    bool latestRealTimeStatus(RealTimeStatus& status, std::chrono::steady_clock::time_point& updatedAt) const;
+
+    /**
+     * @brief 读取本连接的指标快照：各请求类型的延迟分布和收发、超时、重连计数
+     * @note 不阻塞，可以在任意线程（包括回调）中调用；toPrometheusText() 可将其转换为 Prometheus 文本格式
+     */
+    MetricsSnapshot metrics() const;
+
+    /**
+     * @brief 读取连接健康状况：心跳往返时间和连续未应答的心跳数
+     * @note 只有设置 SdkOptions::heartbeatInterval 后才有心跳样本
+     */
+    ConnectionHealth connectionHealth() const;
+
+    /**
+     * @brief 订阅实时状态：由IO线程按固定周期发出 1002 请求，结果推送给回调
+     * @param interval 推送周期，必须大于 0
+     * @param callback 结果回调函数，连接期间每个周期调用一次（含超时等错误结果），在IO线程中调用；
+     *                 周期短于往返时间时请求流水线发出，结果按发出顺序到达
+     * @return 订阅ID，用于取消订阅；参数无效时返回 0
+     * @note 订阅与连接状态无关：断开期间跳过周期，重新连接后自动恢复。发出的请求占用
+     *       SdkOptions::maxInFlightRequests 窗口，窗口已满的周期以超时结果推送
+     */
+    uint32_t subscribeRealTimeStatus(std::chrono::milliseconds interval, RealTimeStatusCallback callback);
+
+    /**
+     * @brief 取消实时状态订阅
+     * @param subscriptionId subscribeRealTimeStatus() 返回的订阅ID
+     * @note 返回后回调不会再被调用；可以在订阅回调中调用
+     */
+    void unsubscribeRealTimeStatus(uint32_t subscriptionId);
+
     /**
      * @brief request1003 基于回调的异步开始导航任务
      * @param points 导航点列表
@@ -71,18 +133,97 @@ public:
      */
     void request1003_StartNavTask(const std::vector<NavigationPoint>& points, NavigationResultCallback callback);
 
+    /**
+     * @brief request1003 分段下发长路线
+     *
+     * 一个 1003 请求的消息体受协议头 length 字段（uint16_t）限制，导航点较多（约一百个以上）的路线无法用
+     * request1003_StartNavTask 一次下发。本接口按编码后的实际长度把路线切分为若干段，依次作为独立的 1003
+     * 任务下发，前一段成功完成后下发下一段；设置 RouteOptions::prefetchPoints 后，根据 1007 报告的进度在
+     * 当前段即将完成时预先下发下一段，缩短段间停顿（需要导航主机支持排队执行任务）。
+     *
+     * @param points 导航点列表，长度不受协议帧长度限制
+     * @param callback 整条路线的结果回调，恰好调用一次：全部分段成功时为最后一段的结果，否则为第一个失败分段的结果
+     * @param progress 进度回调，分段下发、完成以及 1007 报告的目标点变化时调用，可以为空
+     * @param options 分段与预取配置
+     * @note 调用 request1004_CancelNavTask 取消当前任务后，路线随当前段的结果以 CANCELLED 结束，不再下发后续分段
+     */
+    void request1003_StartNavRoute(const std::vector<NavigationPoint>& points, NavigationResultCallback callback,
+                                   RouteProgressCallback progress = nullptr, const RouteOptions& options = RouteOptions());
+
     /**
      * @brief request1004 取消当前导航任务
      * @return 操作是否成功
      */
     bool request1004_CancelNavTask();
 
+    /**
+     * @brief request1004 基于回调的异步取消当前导航任务
+     * @param callback 结果回调函数，参数为操作是否成功，调用约定同 request1002_RunTimeStatus(callback)
+     * @param timeout 本请求的超时时间，为 0 时使用 SdkOptions::requestTimeout
+     */
+    void request1004_CancelNavTask(CancelTaskCallback callback,
+                                   std::chrono::milliseconds timeout = std::chrono::milliseconds::zero());
+
+    /**
+     * @brief request1004 基于 std::future 的异步取消当前导航任务
+     * @param timeout 本请求的超时时间，为 0 时使用 SdkOptions::requestTimeout
+     * @return 操作是否成功的 future
+     */
+    std::future<bool> request1004_CancelNavTaskAsync(
+        std::chrono::milliseconds timeout = std::chrono::milliseconds::zero());
+
     /**
      * @brief request1007 查询当前导航任务状态
      * @return 任务状态查询结果
      */
     TaskStatusResult request1007_NavTaskStatus();
 
+    /**
+     * @brief request1007 基于回调的异步查询当前导航任务状态
+     * @param callback 结果回调函数，调用约定同 request1002_RunTimeStatus(callback)
+     * @param timeout 本请求的超时时间，为 0 时使用 SdkOptions::requestTimeout
+     */
+    void request1007_NavTaskStatus(TaskStatusCallback callback,
+                                   std::chrono::milliseconds timeout = std::chrono::milliseconds::zero());
+
+    /**
+     * @brief request1007 基于 std::future 的异步查询当前导航任务状态
+     * @param timeout 本请求的超时时间，为 0 时使用 SdkOptions::requestTimeout
+     * @return 任务状态查询结果的 future
+     */
+    std::future<TaskStatusResult> request1007_NavTaskStatusAsync(
+        std::chrono::milliseconds timeout = std::chrono::milliseconds::zero());
+
+#if ROBOTSERVER_SDK_HAS_COROUTINES
+    /**
+     * @brief request1002 协程版本：co_await sdk.co_request1002_RunTimeStatus()
+     * @note 协程在IO线程中恢复，见 RequestAwaitable
+     */
+    RequestAwaitable<RealTimeStatus> co_request1002_RunTimeStatus() {
+        return RequestAwaitable<RealTimeStatus>([this](RealTimeStatusCallback callback) {
+            request1002_RunTimeStatus(std::move(callback));
+        });
+    }
+
+    /**
+     * @brief request1004 协程版本：co_await sdk.co_request1004_CancelNavTask()
+     */
+    RequestAwaitable<bool> co_request1004_CancelNavTask() {
+        return RequestAwaitable<bool>([this](CancelTaskCallback callback) {
+            request1004_CancelNavTask(std::move(callback));
+        });
+    }
+
+    /**
+     * @brief request1007 协程版本：co_await sdk.co_request1007_NavTaskStatus()
+     */
+    RequestAwaitable<TaskStatusResult> co_request1007_NavTaskStatus() {
+        return RequestAwaitable<TaskStatusResult>([this](TaskStatusCallback callback) {
+            request1007_NavTaskStatus(std::move(callback));
+        });
+    }
+#endif
+
     /**
      * @brief 获取SDK版本
      * @return SDK版本字符串
@@ -0,0 +1,64 @@
+#pragma once
+
+/**
+ * @brief 编译器与标准库支持 C++20 协程时定义为 1，此时提供 co_request100x 系列接口
+ *
+ * SDK 本身按 C++17 编译，协程接口完全在头文件中基于回调接口实现，
+ * 应用以 -std=c++20 编译即可使用，无需重新编译 SDK。
+ */
+#if defined(__cpp_impl_coroutine) && __cpp_impl_coroutine >= 201902L && defined(__has_include)
+#if __has_include(<coroutine>)
+#define ROBOTSERVER_SDK_HAS_COROUTINES 1
+#endif
+#endif
+
+#ifndef ROBOTSERVER_SDK_HAS_COROUTINES
+#define ROBOTSERVER_SDK_HAS_COROUTINES 0
+#endif
+
+#if ROBOTSERVER_SDK_HAS_COROUTINES
+
+#include <coroutine>
+#include <functional>
+#include <utility>
+
+namespace robotserver_sdk {
+
+/**
+ * @brief 把回调式异步请求包装为可 co_await 的对象
+ * @tparam Result 请求结果类型
+ * @note 协程在结果回调所在的线程（通常是IO线程）中恢复执行，恢复后不应长时间阻塞；
+ *       结果回调保证恰好调用一次
+ */
+template <typename Result>
+class RequestAwaitable {
+public:
+    using Starter = std::function<void(std::function<void(const Result&)>)>;
+
+    /**
+     * @brief 构造函数
+     * @param start 发起请求的函数，参数为结果回调
+     */
+    explicit RequestAwaitable(Starter start) : start_(std::move(start)) {}
+
+    bool await_ready() const noexcept { return false; }
+
+    void await_suspend(std::coroutine_handle<> handle) {
+        // 回调可能在 start() 返回之前就恢复协程并销毁本对象，先把 start_ 移到栈上
+        Starter start = std::move(start_);
+        start([this, handle](const Result& result) {
+            result_ = result;
+            handle.resume();
+        });
+    }
+
+    Result await_resume() { return std::move(result_); }
+
+private:
+    Starter start_;
+    Result result_{};
+};
+
+} // namespace robotserver_sdk
+
+#endif // ROBOTSERVER_SDK_HAS_COROUTINES
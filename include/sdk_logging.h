@@ -0,0 +1,101 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+
+namespace robotserver_sdk {
+
+/**
+ * @brief 日志级别
+ * @note 枚举值不使用全大写，避免与 Windows 头文件的 ERROR 宏、常见的 DEBUG 编译宏冲突
+ */
+enum class LogLevel {
+    Trace = 0,
+    Debug = 1,
+    Info = 2,
+    Warning = 3,
+    Error = 4,
+    Fatal = 5,
+    Off = 6      ///< 只用于 setLogLevel()，关闭所有日志
+};
+
+/**
+ * @brief 一条日志
+ */
+struct LogRecord {
+    LogLevel level = LogLevel::Info;                  ///< 级别
+    std::chrono::system_clock::time_point timestamp;  ///< 记录时间
+    std::thread::id threadId;                         ///< 记录日志的线程
+    const char* file = "";                            ///< 源文件
+    int line = 0;                                     ///< 行号
+    std::string message;                              ///< 内容
+    uint32_t suppressed = 0;                          ///< 本条之前同一位置因限流被丢弃的日志条数
+};
+
+/**
+ * @brief 日志输出目标
+ *
+ * SDK 的日志先进入无锁队列，由一个后台线程依次交给输出目标，write()/flush() 只在该线程中调用，
+ * 不需要自己加锁，也不会阻塞 IO 线程。
+ */
+class LogSink {
+public:
+    virtual ~LogSink() = default;
+
+    /**
+     * @brief 输出一条日志
+     */
+    virtual void write(const LogRecord& record) = 0;
+
+    /**
+     * @brief 一批日志输出完毕，缓冲的内容应当落盘
+     */
+    virtual void flush() {}
+};
+
+/**
+ * @brief 默认的输出目标：按 formatLogRecord() 的格式写入标准错误
+ */
+class ConsoleLogSink : public LogSink {
+public:
+    void write(const LogRecord& record) override;
+    void flush() override;
+};
+
+/**
+ * @brief 默认的日志格式："[YYYY-MM-DD HH:MM:SS.mmm] [级别] 内容"，有限流丢弃时在末尾注明条数
+ * @note 线程安全
+ */
+std::string formatLogRecord(const LogRecord& record);
+
+/**
+ * @brief 设置最低日志级别，低于该级别的日志在调用处直接跳过，默认 Info
+ */
+void setLogLevel(LogLevel level);
+
+/**
+ * @brief 当前的最低日志级别
+ */
+LogLevel logLevel();
+
+/**
+ * @brief 替换日志输出目标，默认为 ConsoleLogSink
+ * @param sink 输出目标，为空时丢弃所有日志
+ */
+void setLogSink(std::shared_ptr<LogSink> sink);
+
+/**
+ * @brief 等待此前记录的日志全部交给输出目标并 flush()
+ * @note 不能在 LogSink 中调用
+ */
+void flushLog();
+
+/**
+ * @brief 因队列已满被丢弃的日志条数（不包括限流丢弃的）
+ */
+uint64_t droppedLogCount();
+
+} // namespace robotserver_sdk
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace robotserver_sdk {
+
+/**
+ * @brief 一种请求的延迟分布快照
+ */
+struct LatencySnapshot {
+    uint64_t count = 0;                 ///< 收到响应的请求数
+    std::chrono::microseconds sum{0};   ///< 延迟之和
+    std::chrono::microseconds max{0};   ///< 最大延迟
+    std::vector<std::pair<std::chrono::microseconds, uint64_t>> buckets; ///< 非空桶：(桶上界（含）, 桶内请求数)，按上界递增
+
+    /**
+     * @brief 估算分位数
+     * @param quantile 分位，取值 [0, 1]，例如 0.99
+     * @return 分位数所在桶的上界，相对误差不超过约 6%；没有样本时为 0
+     */
+    std::chrono::microseconds percentile(double quantile) const;
+};
+
+/**
+ * @brief 一个连接的指标快照
+ *
+ * 计数器从 RobotServerSdk 创建起单调递增，跨越断开和重连。延迟从请求发出到收到响应，
+ * 超时或断开的请求不计入延迟，只计入 timeouts（断开除外）。
+ */
+struct MetricsSnapshot {
+    LatencySnapshot latency1002;        ///< 1002 实时状态查询
+    LatencySnapshot latency1003;        ///< 1003 导航任务，从下发到收到任务结果
+    LatencySnapshot latency1004;        ///< 1004 取消导航任务
+    LatencySnapshot latency1007;        ///< 1007 任务状态查询
+
+    uint64_t bytesSent = 0;             ///< 已写入 socket 的字节数
+    uint64_t bytesReceived = 0;         ///< 从 socket 读取的字节数
+    uint64_t framesSent = 0;            ///< 进入发送队列的帧数
+    uint64_t framesDecoded = 0;         ///< 解码成功的帧数
+    uint64_t decodeFailures = 0;        ///< 分帧成功但消息体无法解码的帧数
+    uint64_t timeouts = 0;              ///< 超过截止时间仍未收到响应的请求数（包括 1003 导航任务）
+    uint64_t reconnects = 0;            ///< 自动重连成功的次数
+};
+
+/**
+ * @brief 把指标快照转换为 Prometheus 文本格式（text/plain; version=0.0.4）
+ * @param snapshot 指标快照
+ * @param labels 附加到每个样本的标签，例如 robot="dog-01"，为空时不加标签
+ * @return 以 x30_sdk_ 为前缀的指标文本，延迟为以秒为单位的直方图
+ */
+std::string toPrometheusText(const MetricsSnapshot& snapshot, const std::string& labels = std::string());
+
+} // namespace robotserver_sdk
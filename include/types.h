@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <functional>
 #include <string>
 #include <vector>
@@ -18,7 +19,8 @@ enum class ErrorCode_Navigation {
 
     INVALID_PARAM = 3,///< 无效参数
     NOT_CONNECTED = 4,///< 未连接
-    UNKNOWN_ERROR = 5 ///< 未知错误
+    UNKNOWN_ERROR = 5,///< 未知错误
+    TIMEOUT = 6       ///< 超过 SdkOptions::navigationTimeout 仍未收到结果
 };
 
 /**
@@ -182,6 +184,27 @@ struct NavigationResult {
     ErrorStatus_Navigation errorStatus = ErrorStatus_Navigation::DEFAULT;                 ///< 错误状态码; 导航任务失败的具体原因
 };
 
+/**
+ * @brief 分段下发长路线的配置
+ */
+struct RouteOptions {
+    size_t maxPointsPerChunk = 0;                      ///< 每段最多的导航点数，0 表示只受协议帧长度上限约束
+    size_t prefetchPoints = 0;                         ///< 当前段剩余不超过这么多导航点时预先下发下一段，0 表示当前段完成后才下发下一段
+    std::chrono::milliseconds progressInterval{1000};  ///< 以 1007 查询执行进度的周期，0 表示不查询（此时不会预取）
+};
+
+/**
+ * @brief 分段下发长路线的进度
+ */
+struct RouteProgress {
+    size_t totalPoints = 0;       ///< 路线的导航点总数
+    size_t totalChunks = 0;       ///< 分段数
+    size_t sentChunks = 0;        ///< 已下发的分段数
+    size_t completedChunks = 0;   ///< 已完成（收到成功的 1003 结果）的分段数
+    size_t reachedPoints = 0;     ///< 已经过的导航点数，根据分段结果与 1007 报告的当前目标点估算
+    int currentValue = 0;         ///< 1007 最近报告的当前目标点编号
+};
+
 /**
  * @brief 1007 任务状态查询结果
  */
@@ -191,12 +214,34 @@ struct TaskStatusResult {
     ErrorCode_QueryStatus errorCode = ErrorCode_QueryStatus::COMPLETED; ///< 错误码:   0:成功; 1:执行中; 2:失败
 };
 
+/**
+ * @brief 连接健康状况（心跳统计）
+ */
+struct ConnectionHealth {
+    std::chrono::microseconds lastRtt{0};      ///< 最近一次心跳的往返时间，0 表示尚无样本
+    std::chrono::microseconds smoothedRtt{0};  ///< 平滑往返时间（新样本权重 1/8）
+    uint32_t missedHeartbeats = 0;             ///< 连续未应答的心跳数
+};
+
+class IoThreadPool; // 见 io_thread_pool.h
+
 /**
  * @brief SDK配置选项
  */
 struct SdkOptions {
     std::chrono::milliseconds connectionTimeout{5000}; ///< 连接超时时间
     std::chrono::milliseconds requestTimeout{3000};    ///< 请求超时时间
+    std::chrono::milliseconds navigationTimeout{std::chrono::minutes(30)}; ///< 1003 导航任务等待结果的最长时间，0 表示不限制
+    uint32_t maxInFlightRequests = 0;                  ///< 1002/1004/1007 同时在途的请求上限（流水线窗口），0 表示不限制
+    std::shared_ptr<IoThreadPool> ioThreadPool;        ///< 共享的IO线程池，为空时使用独占的IO线程
+    std::chrono::milliseconds realTimeStatusMaxStaleness{0}; ///< 1002 查询直接返回不超过该时间的缓存结果，0 表示总是发出请求
+    bool coalesceQueries = true;                       ///< 并发的 1002/1007 查询合并为一个请求，共享同一个结果
+    bool autoReconnect = false;                        ///< 连接被动断开后自动重连，重连成功后重发断开时在途的 1002/1007 请求
+    std::chrono::milliseconds reconnectInitialDelay{100}; ///< 第一次重连前的等待时间，之后每次失败翻倍（带随机抖动）
+    std::chrono::milliseconds reconnectMaxDelay{5000};    ///< 重连等待时间的上限
+    std::chrono::milliseconds heartbeatInterval{0};    ///< 心跳周期，一个周期内没有收到任何消息时发出 1002 探测，0 表示不发心跳
+    uint32_t heartbeatMissLimit = 3;                   ///< 连续这么多次探测未应答时判定连接已失效并断开
+    bool tcpKeepAlive = false;                         ///< 开启 TCP keepalive（SO_KEEPALIVE），探测周期由操作系统决定
 };
 
 /**
@@ -204,4 +249,24 @@ struct SdkOptions {
  */
 using NavigationResultCallback = std::function<void(const NavigationResult&)>;
 
+/**
+ * @brief 分段下发长路线的进度回调函数类型
+ */
+using RouteProgressCallback = std::function<void(const RouteProgress&)>;
+
+/**
+ * @brief 1002 实时状态查询结果回调函数类型
+ */
+using RealTimeStatusCallback = std::function<void(const RealTimeStatus&)>;
+
+/**
+ * @brief 1004 取消导航任务结果回调函数类型，参数为操作是否成功
+ */
+using CancelTaskCallback = std::function<void(bool)>;
+
+/**
+ * @brief 1007 任务状态查询结果回调函数类型
+ */
+using TaskStatusCallback = std::function<void(const TaskStatusResult&)>;
+
 } // namespace robotserver_sdk
@@ -0,0 +1,122 @@
+#include "atomic_wait.hpp"
+
+#if defined(__linux__)
+#include <climits>
+#include <ctime>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#elif defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#endif
+
+namespace common {
+
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t), "等待原语要求原子变量与 uint32_t 布局一致");
+
+#if !defined(__linux__) && !defined(_WIN32)
+namespace {
+
+/**
+ * @brief 没有地址等待原语的平台上，按变量地址散列到固定数量的互斥锁与条件变量
+ *
+ * 唤醒方在持有同一把锁时通知，等待方在持锁状态下检查变量值，因此不会丢失唤醒。
+ */
+struct WaitStripe {
+    std::mutex mutex;
+    std::condition_variable cv;
+};
+
+constexpr size_t WAIT_STRIPE_COUNT = 64;
+
+WaitStripe& stripeOf(const void* address) {
+    static WaitStripe stripes[WAIT_STRIPE_COUNT];
+    return stripes[(std::hash<const void*>()(address) >> 4) % WAIT_STRIPE_COUNT];
+}
+
+} // namespace
+#endif
+
+bool atomicWaitFor(std::atomic<uint32_t>& word, uint32_t expected, std::chrono::nanoseconds timeout) {
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+
+#if defined(__linux__)
+    while (word.load(std::memory_order_acquire) == expected) {
+        const auto remaining = deadline - std::chrono::steady_clock::now();
+        if (remaining <= std::chrono::nanoseconds::zero()) {
+            return false;
+        }
+
+        const auto seconds = std::chrono::duration_cast<std::chrono::seconds>(remaining);
+        timespec ts{};
+        ts.tv_sec = static_cast<time_t>(seconds.count());
+        ts.tv_nsec = static_cast<long>((remaining - seconds).count());
+
+        // 值已不等于 expected 时内核立即返回 EAGAIN，不会丢失唤醒
+        syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAIT_PRIVATE, expected, &ts, nullptr, 0);
+    }
+    return true;
+#elif defined(_WIN32)
+    while (word.load(std::memory_order_acquire) == expected) {
+        const auto remaining = deadline - std::chrono::steady_clock::now();
+        if (remaining <= std::chrono::nanoseconds::zero()) {
+            return false;
+        }
+
+        // 向上取整到毫秒，避免剩余不足 1ms 时空转
+        const auto ms = std::chrono::ceil<std::chrono::milliseconds>(remaining);
+        WaitOnAddress(reinterpret_cast<volatile VOID*>(&word), &expected, sizeof(expected),
+                      static_cast<DWORD>(ms.count()));
+    }
+    return true;
+#else
+    WaitStripe& stripe = stripeOf(&word);
+    std::unique_lock<std::mutex> lock(stripe.mutex);
+    return stripe.cv.wait_until(lock, deadline, [&word, expected]() {
+        return word.load(std::memory_order_acquire) != expected;
+    });
+#endif
+}
+
+void atomicWait(std::atomic<uint32_t>& word, uint32_t expected) {
+#if defined(__linux__)
+    while (word.load(std::memory_order_acquire) == expected) {
+        syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAIT_PRIVATE, expected, nullptr, nullptr, 0);
+    }
+#elif defined(_WIN32)
+    while (word.load(std::memory_order_acquire) == expected) {
+        WaitOnAddress(reinterpret_cast<volatile VOID*>(&word), &expected, sizeof(expected), INFINITE);
+    }
+#else
+    WaitStripe& stripe = stripeOf(&word);
+    std::unique_lock<std::mutex> lock(stripe.mutex);
+    stripe.cv.wait(lock, [&word, expected]() {
+        return word.load(std::memory_order_acquire) != expected;
+    });
+#endif
+}
+
+void atomicNotifyAll(std::atomic<uint32_t>& word) {
+#if defined(__linux__)
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAKE_PRIVATE, INT_MAX, nullptr, nullptr, 0);
+#elif defined(_WIN32)
+    WakeByAddressAll(reinterpret_cast<PVOID>(&word));
+#else
+    WaitStripe& stripe = stripeOf(&word);
+    {
+        // 与等待方的“检查值后睡眠”串行化
+        std::lock_guard<std::mutex> lock(stripe.mutex);
+    }
+    stripe.cv.notify_all();
+#endif
+}
+
+} // namespace common
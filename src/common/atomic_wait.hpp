@@ -0,0 +1,34 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace common {
+
+/**
+ * @brief 在 32 位原子变量上等待，直到其值不再等于 expected 或超时
+ * @param word 原子变量
+ * @param expected 期望值，word 仍等于该值时继续等待
+ * @param timeout 最长等待时间
+ * @return word 的值已改变时返回 true，超时返回 false
+ * @note Linux 上使用 futex、Windows 上使用 WaitOnAddress 直接在该变量上睡眠；
+ *       其他平台（如 macOS）按地址散列到一组互斥锁与条件变量。允许虚假唤醒，调用方需重新检查状态
+ */
+bool atomicWaitFor(std::atomic<uint32_t>& word, uint32_t expected, std::chrono::nanoseconds timeout);
+
+/**
+ * @brief 在 32 位原子变量上等待，直到其值不再等于 expected，没有超时
+ * @param word 原子变量
+ * @param expected 期望值，word 仍等于该值时继续等待
+ * @note 不设置内核定时器；截止时间由调用方在别处（例如时间轮）负责，到期时修改 word 并唤醒
+ */
+void atomicWait(std::atomic<uint32_t>& word, uint32_t expected);
+
+/**
+ * @brief 唤醒所有在 atomicWaitFor()/atomicWait() 中等待该变量的线程
+ * @param word 原子变量
+ */
+void atomicNotifyAll(std::atomic<uint32_t>& word);
+
+} // namespace common
@@ -0,0 +1,42 @@
+#include "in_flight_window.hpp"
+#include "atomic_wait.hpp"
+
+namespace common {
+
+bool InFlightWindow::tryAcquire() {
+    uint32_t current = in_flight_.load(std::memory_order_relaxed);
+    while (limit_ == 0 || current < limit_) {
+        if (in_flight_.compare_exchange_weak(current, current + 1,
+                                             std::memory_order_acquire, std::memory_order_relaxed)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool InFlightWindow::acquireUntil(std::chrono::steady_clock::time_point deadline) {
+    while (true) {
+        if (tryAcquire()) {
+            return true;
+        }
+
+        const auto remaining = deadline - std::chrono::steady_clock::now();
+        if (remaining <= std::chrono::nanoseconds::zero()) {
+            return false;
+        }
+
+        // 计数仍为 limit_ 时睡眠；期间有名额归还则计数已变化，立即返回重试
+        atomicWaitFor(in_flight_, limit_, remaining);
+    }
+}
+
+void InFlightWindow::release() {
+    const uint32_t previous = in_flight_.fetch_sub(1, std::memory_order_release);
+
+    // 只有从满变为不满时才可能有等待方
+    if (limit_ != 0 && previous == limit_) {
+        atomicNotifyAll(in_flight_);
+    }
+}
+
+} // namespace common
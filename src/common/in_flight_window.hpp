@@ -0,0 +1,60 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace common {
+
+/**
+ * @brief 连接上同时在途请求数的上限（流水线窗口）
+ *
+ * 计数信号量：发出请求前取得一个名额，请求完成、超时或放弃后归还。窗口已满时
+ * acquireUntil() 阻塞调用方直到有名额归还或到达截止时间，形成背压；等待在计数本身
+ * 上进行（见 atomicWaitFor），不占用锁。上限为 0 时不做限制，只计数。
+ */
+class InFlightWindow {
+public:
+    /**
+     * @brief 构造函数
+     * @param limit 同时在途的请求上限，0 表示不限制
+     */
+    explicit InFlightWindow(uint32_t limit = 0) : limit_(limit) {}
+
+    InFlightWindow(const InFlightWindow&) = delete;
+    InFlightWindow& operator=(const InFlightWindow&) = delete;
+
+    /**
+     * @brief 不等待地取得一个名额
+     * @return 窗口已满时返回 false
+     */
+    bool tryAcquire();
+
+    /**
+     * @brief 取得一个名额，窗口已满时等待
+     * @param deadline 截止时间
+     * @return 截止时间之前没有名额归还时返回 false
+     */
+    bool acquireUntil(std::chrono::steady_clock::time_point deadline);
+
+    /**
+     * @brief 归还一个名额，唤醒等待的调用方
+     */
+    void release();
+
+    /**
+     * @brief 当前在途的请求数
+     */
+    uint32_t inFlight() const { return in_flight_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief 窗口上限，0 表示不限制
+     */
+    uint32_t limit() const { return limit_; }
+
+private:
+    std::atomic<uint32_t> in_flight_{0};
+    const uint32_t limit_;
+};
+
+} // namespace common
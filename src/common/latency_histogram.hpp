@@ -0,0 +1,127 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace common {
+
+/**
+ * @brief HDR 风格的对数线性延迟直方图，记录无锁
+ *
+ * 以微秒为单位，小于 16us 的值各占一个桶；更大的值按 2 的幂分段，每段再均分为 16 个子桶，
+ * 相对误差不超过 1/16（约 6%），最大可记录约 25 天。记录只是对应桶的一次 relaxed fetch_add，
+ * 任意线程可以并发记录和读取；读取得到的是近似一致的快照，足够用于统计。
+ */
+class LatencyHistogram {
+public:
+    static constexpr unsigned SUB_BUCKET_BITS = 4;
+    static constexpr uint64_t SUB_BUCKET_COUNT = uint64_t(1) << SUB_BUCKET_BITS;  ///< 每段的子桶数
+    static constexpr unsigned MAX_EXPONENT = 40;                                   ///< 最高一段为 [2^40, 2^41) us
+    static constexpr size_t BUCKET_COUNT = SUB_BUCKET_COUNT * (MAX_EXPONENT - SUB_BUCKET_BITS + 2);
+
+    LatencyHistogram() {
+        for (auto& bucket : buckets_) {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    LatencyHistogram(const LatencyHistogram&) = delete;
+    LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+
+    /**
+     * @brief 记录一个延迟样本，负值按 0 记录，超出范围的值记入最后一个桶
+     */
+    void record(std::chrono::microseconds latency) {
+        const uint64_t value = latency.count() > 0 ? static_cast<uint64_t>(latency.count()) : 0;
+        buckets_[indexOf(value)].fetch_add(1, std::memory_order_relaxed);
+        count_.fetch_add(1, std::memory_order_relaxed);
+        sum_.fetch_add(value, std::memory_order_relaxed);
+
+        uint64_t max = max_.load(std::memory_order_relaxed);
+        while (value > max && !max_.compare_exchange_weak(max, value, std::memory_order_relaxed)) {
+        }
+    }
+
+    /**
+     * @brief 样本数
+     */
+    uint64_t count() const { return count_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief 样本之和（微秒）
+     */
+    uint64_t sum() const { return sum_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief 最大样本（微秒）
+     */
+    uint64_t max() const { return max_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief 非空桶的快照
+     * @return (桶上界（微秒，含）, 桶内样本数)，按上界递增
+     */
+    std::vector<std::pair<uint64_t, uint64_t>> buckets() const {
+        std::vector<std::pair<uint64_t, uint64_t>> result;
+        for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+            const uint64_t n = buckets_[i].load(std::memory_order_relaxed);
+            if (n != 0) {
+                result.emplace_back(upperBoundOf(i), n);
+            }
+        }
+        return result;
+    }
+
+    /**
+     * @brief 值所在的桶
+     */
+    static size_t indexOf(uint64_t value) {
+        if (value < SUB_BUCKET_COUNT) {
+            return static_cast<size_t>(value);
+        }
+
+        unsigned exponent = 63 - countLeadingZeros(value);
+        if (exponent > MAX_EXPONENT) {
+            return BUCKET_COUNT - 1;
+        }
+        const uint64_t sub = (value >> (exponent - SUB_BUCKET_BITS)) & (SUB_BUCKET_COUNT - 1);
+        return static_cast<size_t>(SUB_BUCKET_COUNT * (exponent - SUB_BUCKET_BITS + 1) + sub);
+    }
+
+    /**
+     * @brief 桶内的最大值（含）
+     */
+    static uint64_t upperBoundOf(size_t index) {
+        if (index < SUB_BUCKET_COUNT) {
+            return index;
+        }
+
+        const unsigned exponent = static_cast<unsigned>(index / SUB_BUCKET_COUNT) + SUB_BUCKET_BITS - 1;
+        const uint64_t sub = index % SUB_BUCKET_COUNT;
+        return ((SUB_BUCKET_COUNT + sub + 1) << (exponent - SUB_BUCKET_BITS)) - 1;
+    }
+
+private:
+    static unsigned countLeadingZeros(uint64_t value) {
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<unsigned>(__builtin_clzll(value));
+#else
+        unsigned n = 0;
+        for (uint64_t bit = uint64_t(1) << 63; (value & bit) == 0; bit >>= 1) {
+            ++n;
+        }
+        return n;
+#endif
+    }
+
+    std::atomic<uint64_t> buckets_[BUCKET_COUNT];
+    std::atomic<uint64_t> count_{0};
+    std::atomic<uint64_t> sum_{0};
+    std::atomic<uint64_t> max_{0};
+};
+
+} // namespace common
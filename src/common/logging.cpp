@@ -0,0 +1,294 @@
+#include "logging.hpp"
+#include "atomic_wait.hpp"
+#include <cstdio>
+#include <ctime>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace common {
+
+namespace {
+
+using robotserver_sdk::LogLevel;
+using robotserver_sdk::LogRecord;
+using robotserver_sdk::LogSink;
+
+/**
+ * @brief 异步日志：有界无锁多生产者单消费者队列加一个后台输出线程
+ *
+ * 队列是按序号定位槽位的环形数组（Vyukov 有界队列）：生产者用 CAS 抢占写入位置，写入后发布
+ * 槽位序号；后台线程按顺序取出并交给输出目标。队列已满时丢弃日志，记录日志的线程（包括 IO 线程）
+ * 从不等待输出。后台线程空闲时在状态字上睡眠，生产者只在其睡眠时唤醒。
+ */
+class AsyncLogger {
+public:
+    static AsyncLogger& instance() {
+        static AsyncLogger logger;
+        return logger;
+    }
+
+    AsyncLogger()
+        : slots_(std::make_unique<Slot[]>(CAPACITY)),
+          sink_(std::make_shared<robotserver_sdk::ConsoleLogSink>()) {
+        for (uint64_t i = 0; i < CAPACITY; ++i) {
+            slots_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+        writer_ = std::thread(&AsyncLogger::run, this);
+    }
+
+    ~AsyncLogger() {
+        // 进程退出时输出剩余的日志
+        stopping_.store(true);
+        wake();
+        writer_.join();
+    }
+
+    AsyncLogger(const AsyncLogger&) = delete;
+    AsyncLogger& operator=(const AsyncLogger&) = delete;
+
+    bool enabled(LogLevel level) const {
+        return static_cast<int>(level) >= level_.load(std::memory_order_relaxed);
+    }
+
+    void setLevel(LogLevel level) { level_.store(static_cast<int>(level), std::memory_order_relaxed); }
+
+    LogLevel level() const { return static_cast<LogLevel>(level_.load(std::memory_order_relaxed)); }
+
+    void setSink(std::shared_ptr<LogSink> sink) {
+        std::lock_guard<std::mutex> lock(sink_mutex_);
+        sink_ = std::move(sink);
+    }
+
+    uint64_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+    void push(LogRecord&& record) {
+        uint64_t position = enqueue_position_.load(std::memory_order_relaxed);
+        Slot* slot = nullptr;
+        while (true) {
+            slot = &slots_[position & (CAPACITY - 1)];
+            const uint64_t sequence = slot->sequence.load(std::memory_order_acquire);
+            const int64_t diff = static_cast<int64_t>(sequence) - static_cast<int64_t>(position);
+            if (diff == 0) {
+                if (enqueue_position_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                // 后台线程还没有取走一整圈之前的日志：队列已满
+                dropped_.fetch_add(1, std::memory_order_relaxed);
+                return;
+            } else {
+                position = enqueue_position_.load(std::memory_order_relaxed);
+            }
+        }
+
+        slot->record = std::move(record);
+        slot->sequence.store(position + 1, std::memory_order_release);
+
+        // 与后台线程“置为睡眠后再检查队列”配对，保证不会错过唤醒
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (state_.load(std::memory_order_relaxed) == SLEEPING) {
+            wake();
+        }
+    }
+
+    void flush() {
+        const uint64_t target = enqueue_position_.load();
+        wake();
+        while (written_.load(std::memory_order_acquire) < target) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            wake();
+        }
+    }
+
+private:
+    static constexpr uint64_t CAPACITY = 8192;   ///< 队列容量，必须是 2 的幂
+    static constexpr uint32_t AWAKE = 0;
+    static constexpr uint32_t SLEEPING = 1;
+
+    struct Slot {
+        std::atomic<uint64_t> sequence{0};
+        LogRecord record;
+    };
+
+    void wake() {
+        state_.store(AWAKE);
+        atomicNotifyAll(state_);
+    }
+
+    /**
+     * @brief 取出一条日志，队列为空时返回 false（只在后台线程中调用）
+     */
+    bool pop(LogRecord& record) {
+        Slot& slot = slots_[dequeue_position_ & (CAPACITY - 1)];
+        if (slot.sequence.load(std::memory_order_acquire) != dequeue_position_ + 1) {
+            return false;
+        }
+        record = std::move(slot.record);
+        slot.sequence.store(dequeue_position_ + CAPACITY, std::memory_order_release);
+        ++dequeue_position_;
+        return true;
+    }
+
+    void run() {
+        LogRecord record;
+        while (true) {
+            std::shared_ptr<LogSink> sink;
+            {
+                std::lock_guard<std::mutex> lock(sink_mutex_);
+                sink = sink_;
+            }
+
+            // 一次取完队列中的所有日志，整批输出后才 flush
+            uint64_t batch = 0;
+            while (pop(record)) {
+                if (sink) {
+                    try {
+                        sink->write(record);
+                    } catch (...) {
+                        // 输出目标的异常不能结束后台线程
+                    }
+                }
+                ++batch;
+            }
+            if (batch != 0) {
+                if (sink) {
+                    try {
+                        sink->flush();
+                    } catch (...) {
+                    }
+                }
+                written_.fetch_add(batch, std::memory_order_release);
+            }
+
+            if (stopping_.load()) {
+                if (!hasPending()) {
+                    return;
+                }
+                continue;
+            }
+
+            state_.store(SLEEPING);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (hasPending() || stopping_.load()) {
+                state_.store(AWAKE);
+                continue;
+            }
+            atomicWaitFor(state_, SLEEPING, std::chrono::milliseconds(100));
+        }
+    }
+
+    bool hasPending() const {
+        const Slot& slot = slots_[dequeue_position_ & (CAPACITY - 1)];
+        return slot.sequence.load(std::memory_order_acquire) == dequeue_position_ + 1;
+    }
+
+    static_assert((CAPACITY & (CAPACITY - 1)) == 0, "CAPACITY 必须是 2 的幂");
+
+    std::unique_ptr<Slot[]> slots_;
+    std::atomic<uint64_t> enqueue_position_{0};
+    uint64_t dequeue_position_ = 0;                     // 仅在后台线程中访问
+    std::atomic<uint64_t> written_{0};                  // 已交给输出目标的条数
+    std::atomic<uint64_t> dropped_{0};
+    std::atomic<int> level_{static_cast<int>(LogLevel::Info)};
+    std::atomic<uint32_t> state_{AWAKE};
+    std::atomic<bool> stopping_{false};
+
+    std::mutex sink_mutex_;                             // 只在替换与后台线程读取输出目标时持有
+    std::shared_ptr<LogSink> sink_;
+    std::thread writer_;
+};
+
+const char* levelName(LogLevel level) {
+    switch (level) {
+        case LogLevel::Trace: return "TRACE";
+        case LogLevel::Debug: return "DEBUG";
+        case LogLevel::Info: return "INFO";
+        case LogLevel::Warning: return "WARN";
+        case LogLevel::Error: return "ERROR";
+        case LogLevel::Fatal: return "FATAL";
+        default: return "OFF";
+    }
+}
+
+} // namespace
+
+bool logEnabled(LogLevel level) {
+    return AsyncLogger::instance().enabled(level);
+}
+
+void submitLog(LogLevel level, const char* file, int line, std::string message, uint32_t suppressed) {
+    LogRecord record;
+    record.level = level;
+    record.timestamp = std::chrono::system_clock::now();
+    record.threadId = std::this_thread::get_id();
+    record.file = file;
+    record.line = line;
+    record.message = std::move(message);
+    record.suppressed = suppressed;
+    AsyncLogger::instance().push(std::move(record));
+}
+
+} // namespace common
+
+namespace robotserver_sdk {
+
+void ConsoleLogSink::write(const LogRecord& record) {
+    const std::string text = formatLogRecord(record);
+    std::fwrite(text.data(), 1, text.size(), stderr);
+}
+
+void ConsoleLogSink::flush() {
+    std::fflush(stderr);
+}
+
+std::string formatLogRecord(const LogRecord& record) {
+    const auto sinceEpoch = record.timestamp.time_since_epoch();
+    const std::time_t seconds = static_cast<std::time_t>(
+        std::chrono::duration_cast<std::chrono::seconds>(sinceEpoch).count());
+    const int millis = static_cast<int>(
+        std::chrono::duration_cast<std::chrono::milliseconds>(sinceEpoch).count() % 1000);
+
+    std::tm local{};
+#ifdef _WIN32
+    localtime_s(&local, &seconds);
+#else
+    localtime_r(&seconds, &local);
+#endif
+
+    char prefix[64];
+    std::snprintf(prefix, sizeof(prefix), "[%04d-%02d-%02d %02d:%02d:%02d.%03d] [%s] ",
+                  local.tm_year + 1900, local.tm_mon + 1, local.tm_mday,
+                  local.tm_hour, local.tm_min, local.tm_sec, millis,
+                  common::levelName(record.level));
+
+    std::string text(prefix);
+    text += record.message;
+    if (record.suppressed != 0) {
+        text += " (此前 " + std::to_string(record.suppressed) + " 条同类日志因限流被丢弃)";
+    }
+    text += '\n';
+    return text;
+}
+
+void setLogLevel(LogLevel level) {
+    common::AsyncLogger::instance().setLevel(level);
+}
+
+LogLevel logLevel() {
+    return common::AsyncLogger::instance().level();
+}
+
+void setLogSink(std::shared_ptr<LogSink> sink) {
+    common::AsyncLogger::instance().setSink(std::move(sink));
+}
+
+void flushLog() {
+    common::AsyncLogger::instance().flush();
+}
+
+uint64_t droppedLogCount() {
+    return common::AsyncLogger::instance().dropped();
+}
+
+} // namespace robotserver_sdk
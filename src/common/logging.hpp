@@ -0,0 +1,82 @@
+#pragma once
+
+#include "sdk_logging.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <sstream>
+#include <string>
+
+namespace common {
+
+/**
+ * @brief 指定级别的日志是否需要记录
+ */
+bool logEnabled(robotserver_sdk::LogLevel level);
+
+/**
+ * @brief 把一条日志放入无锁队列，由后台线程输出；队列已满时丢弃并计数，从不阻塞
+ */
+void submitLog(robotserver_sdk::LogLevel level, const char* file, int line, std::string message, uint32_t suppressed);
+
+/**
+ * @brief 单个日志位置的限流：每秒最多输出 BURST 条，其余丢弃并计数，下一条输出的日志注明丢弃的条数
+ *
+ * 防止持续发送错误帧的机器狗把同一条错误刷满日志。只用几个 relaxed 原子变量，
+ * 跨秒时的竞争只影响计数的精确性。
+ */
+class LogRateLimiter {
+public:
+    static constexpr uint32_t BURST = 10;  ///< 每秒最多输出的条数
+
+    /**
+     * @brief 本条日志是否输出
+     * @param suppressed 输出时写入此前被丢弃的条数
+     */
+    bool allow(uint32_t& suppressed) {
+        const int64_t second = std::chrono::duration_cast<std::chrono::seconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+        int64_t window = window_.load(std::memory_order_relaxed);
+        if (second != window && window_.compare_exchange_strong(window, second, std::memory_order_relaxed)) {
+            count_.store(0, std::memory_order_relaxed);
+        }
+
+        if (count_.fetch_add(1, std::memory_order_relaxed) >= BURST) {
+            suppressed_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        suppressed = suppressed_.exchange(0, std::memory_order_relaxed);
+        return true;
+    }
+
+private:
+    std::atomic<int64_t> window_{-1};
+    std::atomic<uint32_t> count_{0};
+    std::atomic<uint32_t> suppressed_{0};
+};
+
+} // namespace common
+
+/**
+ * @brief 记录一条日志：级别未启用时不求值 expr；expr 按 std::ostream 的 << 语法拼接，
+ *        例如 SDK_LOG(Error, "接收数据错误: " << error.message())
+ */
+#define SDK_LOG(level, expr)                                                                          \
+    do {                                                                                              \
+        if (::common::logEnabled(::robotserver_sdk::LogLevel::level)) {                               \
+            static ::common::LogRateLimiter sdkLogLimiter;                                            \
+            uint32_t sdkLogSuppressed = 0;                                                            \
+            if (sdkLogLimiter.allow(sdkLogSuppressed)) {                                              \
+                std::ostringstream sdkLogStream;                                                      \
+                sdkLogStream << expr;                                                                 \
+                ::common::submitLog(::robotserver_sdk::LogLevel::level, __FILE__, __LINE__,           \
+                                    sdkLogStream.str(), sdkLogSuppressed);                            \
+            }                                                                                         \
+        }                                                                                             \
+    } while (0)
+
+#define LOG_TRACE(expr) SDK_LOG(Trace, expr)
+#define LOG_DEBUG(expr) SDK_LOG(Debug, expr)
+#define LOG_INFO(expr)  SDK_LOG(Info, expr)
+#define LOG_WARN(expr)  SDK_LOG(Warning, expr)
+#define LOG_ERROR(expr) SDK_LOG(Error, expr)
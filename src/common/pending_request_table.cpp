@@ -0,0 +1,250 @@
+#include "pending_request_table.hpp"
+#include "atomic_wait.hpp"
+#include <thread>
+
+namespace common {
+
+PendingRequestTable::PendingRequestTable()
+    : slots_(std::make_unique<Slot[]>(SLOT_COUNT)) {
+}
+
+PendingRequestTable::~PendingRequestTable() = default;
+
+uint16_t PendingRequestTable::nextSequenceNumber() {
+    return static_cast<uint16_t>(next_sequence_.fetch_add(1, std::memory_order_relaxed) + 1);
+}
+
+bool PendingRequestTable::acquire(protocol::MessageType expectedType, uint16_t& sequenceNumber) {
+    for (size_t attempt = 0; attempt < SLOT_COUNT; ++attempt) {
+        const uint16_t seq = nextSequenceNumber();
+        Slot& slot = slotOf(seq);
+
+        uint32_t word = slot.word.load(std::memory_order_relaxed);
+        if (stateOf(word) != FREE) {
+            continue;
+        }
+
+        if (slot.word.compare_exchange_strong(word, makeWord(expectedType, WAITING, seq),
+                                              std::memory_order_acq_rel, std::memory_order_relaxed)) {
+            sequenceNumber = seq;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool PendingRequestTable::acquireAsync(protocol::MessageType expectedType, CompletionHandler handler,
+                                       uint16_t& sequenceNumber) {
+    for (size_t attempt = 0; attempt < SLOT_COUNT; ++attempt) {
+        const uint16_t seq = nextSequenceNumber();
+        Slot& slot = slotOf(seq);
+
+        uint32_t word = slot.word.load(std::memory_order_relaxed);
+        if (stateOf(word) != FREE) {
+            continue;
+        }
+
+        // 先占住槽位再写入回调，发布 WAITING 之后 IO 线程才可能认领
+        if (slot.word.compare_exchange_strong(word, makeWord(expectedType, RESERVED, seq),
+                                              std::memory_order_acq_rel, std::memory_order_relaxed)) {
+            slot.handler = std::move(handler);
+            slot.word.store(makeWord(expectedType, WAITING, seq) | (ASYNC_FLAG << 16), std::memory_order_release);
+            sequenceNumber = seq;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool PendingRequestTable::expire(uint16_t sequenceNumber) {
+    Slot& slot = slotOf(sequenceNumber);
+
+    uint32_t word = slot.word.load(std::memory_order_acquire);
+    if (stateOf(word) != WAITING || sequenceOf(word) != sequenceNumber) {
+        return false;
+    }
+
+    // 同步请求：释放槽位并唤醒等待方，与响应写入的竞争由 CAS 裁决
+    if (!isAsync(word)) {
+        if (!slot.word.compare_exchange_strong(word, withState(word, FREE),
+                                               std::memory_order_acq_rel, std::memory_order_relaxed)) {
+            return false;
+        }
+        atomicNotifyAll(slot.word);
+        return true;
+    }
+
+    CompletionHandler handler;
+    if (!claimHandler(slot, word, handler)) {
+        return false;
+    }
+    if (handler) {
+        handler(nullptr);
+    }
+    return true;
+}
+
+void PendingRequestTable::cancelAll(const std::function<bool(protocol::MessageType)>& keep) {
+    for (size_t i = 0; i < SLOT_COUNT; ++i) {
+        Slot& slot = slots_[i];
+        uint32_t word = slot.word.load(std::memory_order_acquire);
+        if (stateOf(word) != WAITING || (keep && keep(typeOf(word)))) {
+            continue;
+        }
+
+        if (isAsync(word)) {
+            CompletionHandler handler;
+            if (claimHandler(slot, word, handler) && handler) {
+                handler(nullptr);
+            }
+        } else if (slot.word.compare_exchange_strong(word, withState(word, FREE),
+                                                     std::memory_order_acq_rel, std::memory_order_relaxed)) {
+            atomicNotifyAll(slot.word);
+        }
+    }
+}
+
+void PendingRequestTable::forEachWaiting(const std::function<void(uint16_t, protocol::MessageType)>& visitor) const {
+    for (size_t i = 0; i < SLOT_COUNT; ++i) {
+        const uint32_t word = slots_[i].word.load(std::memory_order_acquire);
+        if (stateOf(word) == WAITING) {
+            visitor(sequenceOf(word), typeOf(word));
+        }
+    }
+}
+
+bool PendingRequestTable::complete(uint16_t sequenceNumber, protocol::MessageType type,
+                                   std::unique_ptr<protocol::IMessage>& message) {
+    Slot& slot = slotOf(sequenceNumber);
+
+    uint32_t word = slot.word.load(std::memory_order_acquire);
+    if (stateOf(word) != WAITING || sequenceOf(word) != sequenceNumber || typeOf(word) != type) {
+        return false;
+    }
+
+    if (isAsync(word)) {
+        CompletionHandler handler;
+        if (!claimHandler(slot, word, handler)) {
+            return false;
+        }
+        if (handler) {
+            handler(std::move(message));
+        }
+        return true;
+    }
+
+    // 抢占写入权；失败说明请求方已超时放弃
+    if (!slot.word.compare_exchange_strong(word, withState(word, FILLING),
+                                           std::memory_order_acq_rel, std::memory_order_relaxed)) {
+        return false;
+    }
+
+    slot.response = std::move(message);
+    slot.word.store(withState(word, READY), std::memory_order_release);
+    atomicNotifyAll(slot.word);
+    return true;
+}
+
+std::unique_ptr<protocol::IMessage> PendingRequestTable::wait(uint16_t sequenceNumber, std::chrono::milliseconds timeout) {
+    Slot& slot = slotOf(sequenceNumber);
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+
+    while (true) {
+        uint32_t word = slot.word.load(std::memory_order_acquire);
+        if (sequenceOf(word) != sequenceNumber || stateOf(word) == FREE || isAsync(word)) {
+            return nullptr;
+        }
+
+        if (stateOf(word) == READY) {
+            return take(slot, word);
+        }
+
+        const auto remaining = deadline - std::chrono::steady_clock::now();
+        if (stateOf(word) == WAITING && remaining <= std::chrono::nanoseconds::zero()) {
+            // 超时：放弃槽位；CAS 失败说明响应恰好到达，重新检查
+            if (slot.word.compare_exchange_strong(word, withState(word, FREE),
+                                                  std::memory_order_acq_rel, std::memory_order_relaxed)) {
+                return nullptr;
+            }
+            continue;
+        }
+
+        if (stateOf(word) == FILLING) {
+            // IO线程正在写入响应，很快就会变为 READY
+            std::this_thread::yield();
+            continue;
+        }
+
+        atomicWaitFor(slot.word, word, remaining);
+    }
+}
+
+std::unique_ptr<protocol::IMessage> PendingRequestTable::wait(uint16_t sequenceNumber) {
+    Slot& slot = slotOf(sequenceNumber);
+
+    while (true) {
+        uint32_t word = slot.word.load(std::memory_order_acquire);
+        if (sequenceOf(word) != sequenceNumber || stateOf(word) == FREE || isAsync(word)) {
+            return nullptr;
+        }
+
+        if (stateOf(word) == READY) {
+            return take(slot, word);
+        }
+
+        if (stateOf(word) == FILLING) {
+            // IO线程正在写入响应，很快就会变为 READY
+            std::this_thread::yield();
+            continue;
+        }
+
+        atomicWait(slot.word, word);
+    }
+}
+
+void PendingRequestTable::release(uint16_t sequenceNumber) {
+    Slot& slot = slotOf(sequenceNumber);
+
+    while (true) {
+        uint32_t word = slot.word.load(std::memory_order_acquire);
+        if (sequenceOf(word) != sequenceNumber || stateOf(word) == FREE || isAsync(word)) {
+            return;
+        }
+
+        if (stateOf(word) == READY) {
+            take(slot, word);
+            return;
+        }
+
+        if (stateOf(word) == FILLING) {
+            std::this_thread::yield();
+            continue;
+        }
+
+        if (slot.word.compare_exchange_strong(word, withState(word, FREE),
+                                              std::memory_order_acq_rel, std::memory_order_relaxed)) {
+            return;
+        }
+    }
+}
+
+std::unique_ptr<protocol::IMessage> PendingRequestTable::take(Slot& slot, uint32_t word) {
+    std::unique_ptr<protocol::IMessage> response = std::move(slot.response);
+    slot.word.store(withState(word, FREE), std::memory_order_release);
+    return response;
+}
+
+bool PendingRequestTable::claimHandler(Slot& slot, uint32_t word, CompletionHandler& handler) {
+    if (!slot.word.compare_exchange_strong(word, withState(word, FILLING),
+                                           std::memory_order_acq_rel, std::memory_order_relaxed)) {
+        return false;
+    }
+
+    // 先释放槽位再调用回调，回调中可以立即发起新的请求
+    handler = std::move(slot.handler);
+    slot.handler = nullptr;
+    slot.word.store(withState(word, FREE), std::memory_order_release);
+    return true;
+}
+
+} // namespace common
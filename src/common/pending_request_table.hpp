@@ -0,0 +1,169 @@
+#pragma once
+
+#include "protocol/message_interface.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+namespace common {
+
+/**
+ * @brief 按 16 位序列号索引的无锁待处理请求表
+ *
+ * 预先分配固定数量（2 的幂）的槽位，序列号的低位即槽位下标，登记、投递响应和等待
+ * 都不需要全局锁，也不会为每个请求分配 map 节点或条件变量。每个槽位用一个 32 位原子
+ * 状态字描述：
+ *
+ *     [31..24] 期望的响应类型  [23..16] 槽位状态  [15..0] 序列号
+ *
+ * 状态转换：FREE -> WAITING（请求方登记）-> FILLING（IO线程写入响应）-> READY -> FREE（请求方取走）。
+ * 请求方超时可直接 WAITING -> FREE，与响应写入的竞争由 CAS 裁决。等待在状态字本身上进行
+ * （见 atomicWaitFor），没有共享锁。
+ *
+ * 异步请求（acquireAsync）在登记时存入完成回调，状态字带 ASYNC 标志：FREE -> RESERVED（写入回调）
+ * -> WAITING|ASYNC -> FILLING -> FREE，响应到达或超时（expire）时由赢得 CAS 的一方调用回调，
+ * 不需要任何线程阻塞等待。
+ */
+class PendingRequestTable {
+public:
+    static constexpr size_t SLOT_COUNT = 4096;  ///< 槽位数，即同时在途的请求上限
+
+    /**
+     * @brief 异步请求的完成回调，参数为响应消息；超时或被取消时为 nullptr
+     */
+    using CompletionHandler = std::function<void(std::unique_ptr<protocol::IMessage>)>;
+
+    PendingRequestTable();
+    ~PendingRequestTable();
+
+    PendingRequestTable(const PendingRequestTable&) = delete;
+    PendingRequestTable& operator=(const PendingRequestTable&) = delete;
+
+    /**
+     * @brief 生成下一个序列号，从0到65535后溢出回到0
+     */
+    uint16_t nextSequenceNumber();
+
+    /**
+     * @brief 分配序列号并登记一个等待响应的请求
+     * @param expectedType 期望的响应类型
+     * @param sequenceNumber 输出分配到的序列号
+     * @return 所有槽位都被占用时返回 false
+     * @note 若序列号对应的槽位仍被占用则跳过该序列号，保证在途请求的序列号互不冲突
+     */
+    bool acquire(protocol::MessageType expectedType, uint16_t& sequenceNumber);
+
+    /**
+     * @brief 分配序列号并登记一个异步请求
+     * @param expectedType 期望的响应类型
+     * @param handler 完成回调，响应到达、expire() 或 cancelAll() 时恰好调用一次
+     * @param sequenceNumber 输出分配到的序列号
+     * @return 所有槽位都被占用时返回 false，此时 handler 不会被调用
+     */
+    bool acquireAsync(protocol::MessageType expectedType, CompletionHandler handler, uint16_t& sequenceNumber);
+
+    /**
+     * @brief 使仍在等待的请求超时：异步请求以 nullptr 调用其完成回调，同步等待方从 wait() 返回 nullptr
+     * @param sequenceNumber acquire()/acquireAsync() 分配的序列号
+     * @return 请求已完成、已超时或槽位已被复用时返回 false
+     * @note 由管理截止时间的时间轮在IO线程中调用
+     */
+    bool expire(uint16_t sequenceNumber);
+
+    /**
+     * @brief 放弃所有在途请求：异步请求以 nullptr 调用完成回调，同步等待方立即返回 nullptr
+     * @param keep 为空时放弃所有请求；否则对其返回 true 的响应类型保持等待（例如断线重连后重发的幂等查询）
+     * @note 用于断开连接，避免调用方等到超时
+     */
+    void cancelAll(const std::function<bool(protocol::MessageType)>& keep = nullptr);
+
+    /**
+     * @brief 遍历所有仍在等待响应的请求
+     * @param visitor 参数为序列号和期望的响应类型
+     * @note 只是某一时刻的快照，遍历期间请求可能已经完成
+     */
+    void forEachWaiting(const std::function<void(uint16_t, protocol::MessageType)>& visitor) const;
+
+    /**
+     * @brief 投递响应（由IO线程调用）
+     * @param sequenceNumber 响应的序列号
+     * @param type 响应的消息类型
+     * @param message 响应消息，被认领时所有权转移
+     * @return 存在匹配的等待请求时返回 true
+     * @note 异步请求的完成回调在本函数中、槽位释放之后调用
+     */
+    bool complete(uint16_t sequenceNumber, protocol::MessageType type, std::unique_ptr<protocol::IMessage>& message);
+
+    /**
+     * @brief 等待响应并释放槽位
+     * @param sequenceNumber acquire() 分配的序列号
+     * @param timeout 超时时间
+     * @return 响应消息，超时返回 nullptr
+     */
+    std::unique_ptr<protocol::IMessage> wait(uint16_t sequenceNumber, std::chrono::milliseconds timeout);
+
+    /**
+     * @brief 等待响应并释放槽位，没有超时
+     * @param sequenceNumber acquire() 分配的序列号
+     * @return 响应消息；被 expire() 或 cancelAll() 结束时返回 nullptr
+     * @note 调用方必须保证请求最终会被 expire() 结束（例如在时间轮中登记截止时间），等待不设内核定时器
+     */
+    std::unique_ptr<protocol::IMessage> wait(uint16_t sequenceNumber);
+
+    /**
+     * @brief 放弃请求并释放槽位，槽位已被释放或已分配给其他序列号时不做任何事
+     * @param sequenceNumber acquire() 分配的序列号
+     */
+    void release(uint16_t sequenceNumber);
+
+private:
+    enum SlotState : uint32_t {
+        FREE = 0,
+        WAITING = 1,
+        FILLING = 2,
+        READY = 3,
+        RESERVED = 4     ///< 异步请求正在写入完成回调
+    };
+
+    static constexpr uint32_t ASYNC_FLAG = 0x80;  ///< 状态字节中的异步请求标志
+
+    struct Slot {
+        std::atomic<uint32_t> word{0};
+        std::unique_ptr<protocol::IMessage> response;
+        CompletionHandler handler;
+    };
+
+    static constexpr uint32_t makeWord(protocol::MessageType type, SlotState state, uint16_t sequenceNumber) {
+        return (static_cast<uint32_t>(type) << 24) | (static_cast<uint32_t>(state) << 16) | sequenceNumber;
+    }
+    static constexpr SlotState stateOf(uint32_t word) { return static_cast<SlotState>((word >> 16) & 0x7f); }
+    static constexpr bool isAsync(uint32_t word) { return ((word >> 16) & ASYNC_FLAG) != 0; }
+    static constexpr uint16_t sequenceOf(uint32_t word) { return static_cast<uint16_t>(word & 0xffff); }
+    static constexpr protocol::MessageType typeOf(uint32_t word) { return static_cast<protocol::MessageType>(word >> 24); }
+    static constexpr uint32_t withState(uint32_t word, SlotState state) {
+        return (word & 0xff00ffffu) | (static_cast<uint32_t>(state) << 16);
+    }
+
+    Slot& slotOf(uint16_t sequenceNumber) { return slots_[sequenceNumber & (SLOT_COUNT - 1)]; }
+
+    /**
+     * @brief 取走 READY 槽位中的响应并释放槽位
+     */
+    std::unique_ptr<protocol::IMessage> take(Slot& slot, uint32_t word);
+
+    /**
+     * @brief 抢占仍在等待的异步槽位，取出完成回调并释放槽位
+     * @return 抢占失败（响应已到达或已超时）时返回 false
+     */
+    static bool claimHandler(Slot& slot, uint32_t word, CompletionHandler& handler);
+
+    static_assert((SLOT_COUNT & (SLOT_COUNT - 1)) == 0, "SLOT_COUNT 必须是 2 的幂");
+    static_assert(SLOT_COUNT <= 65536, "SLOT_COUNT 不能超过序列号空间");
+
+    std::unique_ptr<Slot[]> slots_;  ///< 预分配的槽位数组
+    std::atomic<uint16_t> next_sequence_{0};
+};
+
+} // namespace common
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <type_traits>
+
+namespace common {
+
+/**
+ * @brief 顺序锁保护的单个值，用于“写少读多”的最新值缓存
+ *
+ * 写者先把序列号改为奇数，写入数据后再改回偶数；读者在序列号为偶数且读取前后不变时
+ * 得到一致的快照，否则重试。读者不写任何共享状态，读者数量不影响写者，也不会互相影响。
+ * 数据按 64 位字保存在原子变量中，读写的并发访问没有数据竞争。
+ *
+ * @tparam T 值类型，必须可平凡复制
+ */
+template <typename T>
+class Seqlock {
+    static_assert(std::is_trivially_copyable<T>::value, "Seqlock 只能保存可平凡复制的类型");
+
+public:
+    Seqlock() {
+        for (auto& word : data_) {
+            word.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    Seqlock(const Seqlock&) = delete;
+    Seqlock& operator=(const Seqlock&) = delete;
+
+    /**
+     * @brief 写入新值；多个写者之间互斥（自旋等待）
+     */
+    void store(const T& value) {
+        uint64_t sequence = sequence_.load(std::memory_order_relaxed);
+        while (true) {
+            if (sequence & 1) {
+                std::this_thread::yield();
+                sequence = sequence_.load(std::memory_order_relaxed);
+                continue;
+            }
+            if (sequence_.compare_exchange_weak(sequence, sequence + 1,
+                                                std::memory_order_acquire, std::memory_order_relaxed)) {
+                break;
+            }
+        }
+        // 数据的写入不能早于序列号变为奇数
+        std::atomic_thread_fence(std::memory_order_release);
+
+        uint64_t words[WORD_COUNT] = {};
+        std::memcpy(words, &value, sizeof(T));
+        for (size_t i = 0; i < WORD_COUNT; ++i) {
+            data_[i].store(words[i], std::memory_order_relaxed);
+        }
+
+        sequence_.store(sequence + 2, std::memory_order_release);
+    }
+
+    /**
+     * @brief 读取一致的快照
+     * @param value 输出值
+     * @return 从未写入过时返回 false
+     */
+    bool load(T& value) const {
+        while (true) {
+            const uint64_t before = sequence_.load(std::memory_order_acquire);
+            if (before == 0) {
+                return false;
+            }
+            if (before & 1) {
+                std::this_thread::yield();
+                continue;
+            }
+
+            uint64_t words[WORD_COUNT];
+            for (size_t i = 0; i < WORD_COUNT; ++i) {
+                words[i] = data_[i].load(std::memory_order_relaxed);
+            }
+            // 序列号的再次读取不能早于数据的读取
+            std::atomic_thread_fence(std::memory_order_acquire);
+
+            if (sequence_.load(std::memory_order_relaxed) == before) {
+                std::memcpy(&value, words, sizeof(T));
+                return true;
+            }
+        }
+    }
+
+    /**
+     * @brief 是否已写入过值
+     */
+    bool hasValue() const { return sequence_.load(std::memory_order_acquire) != 0; }
+
+private:
+    static constexpr size_t WORD_COUNT = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+    std::atomic<uint64_t> sequence_{0};
+    std::atomic<uint64_t> data_[WORD_COUNT];
+};
+
+} // namespace common
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <functional>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace common {
+
+/**
+ * @brief 相同查询的请求合并（single-flight）
+ *
+ * 同一时刻只让一个调用方（发起者）真正发出请求，期间到达的其他调用方登记回调，
+ * 发起者得到结果后通过 complete() 把同一个结果交给所有登记的调用方。只适用于幂等的查询。
+ *
+ * @tparam Result 结果类型
+ */
+template <typename Result>
+class SingleFlight {
+public:
+    using Callback = std::function<void(const Result&)>;
+
+    SingleFlight() = default;
+    SingleFlight(const SingleFlight&) = delete;
+    SingleFlight& operator=(const SingleFlight&) = delete;
+
+    /**
+     * @brief 加入在途的请求
+     * @param callback 结果回调，只在返回 true 时登记
+     * @return 已有请求在途时登记回调并返回 true；否则调用方成为发起者，返回 false，
+     *         发起者必须在请求结束（包括失败）时调用 complete()
+     */
+    bool join(Callback callback) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (in_flight_) {
+            followers_.push_back(std::move(callback));
+            return true;
+        }
+        in_flight_ = true;
+        return false;
+    }
+
+    /**
+     * @brief 发起者的请求结束，把结果交给所有登记的调用方
+     * @note 回调在调用线程中、锁外调用；此后到达的调用方开始新的一轮
+     */
+    void complete(const Result& result) {
+        std::vector<Callback> followers;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            followers.swap(followers_);
+            in_flight_ = false;
+        }
+
+        for (auto& follower : followers) {
+            follower(result);
+        }
+    }
+
+private:
+    std::mutex mutex_;
+    bool in_flight_ = false;
+    std::vector<Callback> followers_;
+};
+
+} // namespace common
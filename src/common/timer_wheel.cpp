@@ -0,0 +1,148 @@
+#include "timer_wheel.hpp"
+#include "logging.hpp"
+#include <algorithm>
+
+namespace common {
+
+TimerWheel::TimerWheel(std::chrono::milliseconds tick)
+    : tick_(std::max(tick, std::chrono::milliseconds(1))),
+      start_(Clock::now()) {
+    levels_[0].resize(size_t(1) << LEVEL0_BITS);
+    for (unsigned level = 1; level < LEVEL_COUNT; ++level) {
+        levels_[level].resize(size_t(1) << LEVEL_BITS);
+    }
+}
+
+uint64_t TimerWheel::tickOf(Clock::time_point time) const {
+    if (time <= start_) {
+        return 0;
+    }
+    const auto elapsed = time - start_;
+    const auto tick = std::chrono::duration_cast<Clock::duration>(tick_);
+    return static_cast<uint64_t>((elapsed + tick - Clock::duration(1)) / tick);
+}
+
+uint64_t TimerWheel::elapsedTicks(Clock::time_point now) const {
+    if (now <= start_) {
+        return 0;
+    }
+    return static_cast<uint64_t>((now - start_) / std::chrono::duration_cast<Clock::duration>(tick_));
+}
+
+void TimerWheel::place(TimerId id, uint64_t expireTick) {
+    // 超出最高层范围的任务先放在最高层最远的位置，级联时再按真实的到期刻度重新分配
+    const uint64_t delta = std::min(expireTick - current_tick_, MAX_DELTA);
+    const uint64_t position = current_tick_ + delta;
+
+    unsigned level = 0;
+    while (level + 1 < LEVEL_COUNT && delta >= (uint64_t(1) << shiftOf(level + 1))) {
+        ++level;
+    }
+
+    auto& slots = levels_[level];
+    slots[(position >> shiftOf(level)) & (slots.size() - 1)].push_back(id);
+}
+
+void TimerWheel::cascade(unsigned level, size_t index) {
+    std::vector<TimerId> ids;
+    ids.swap(levels_[level][index]);
+
+    for (const TimerId id : ids) {
+        auto it = timers_.find(id);
+        if (it != timers_.end()) {
+            place(id, it->second.expireTick);
+        }
+    }
+}
+
+void TimerWheel::step(std::vector<Task>& expired) {
+    ++current_tick_;
+
+    // 低层转完一圈时从高到低级联，使高层任务在本刻度之前落到正确的低层槽位
+    for (unsigned level = LEVEL_COUNT - 1; level >= 1; --level) {
+        if ((current_tick_ & ((uint64_t(1) << shiftOf(level)) - 1)) == 0) {
+            cascade(level, (current_tick_ >> shiftOf(level)) & (levels_[level].size() - 1));
+        }
+    }
+
+    std::vector<TimerId> ids;
+    ids.swap(levels_[0][current_tick_ & (levels_[0].size() - 1)]);
+    for (const TimerId id : ids) {
+        auto it = timers_.find(id);
+        if (it == timers_.end()) {
+            continue;
+        }
+        if (it->second.expireTick <= current_tick_) {
+            expired.push_back(std::move(it->second.task));
+            timers_.erase(it);
+        } else {
+            place(id, it->second.expireTick);
+        }
+    }
+}
+
+TimerWheel::TimerId TimerWheel::schedule(Clock::time_point deadline, Task task) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    // 时间轮为空时驱动定时器已停止，current_tick_ 停在上次推进的位置；先跳到当前刻度再放置，
+    // 否则下一次 advance() 要在锁内逐个刻度追赶整个空闲期
+    if (timers_.empty()) {
+        current_tick_ = std::max(current_tick_, elapsedTicks(Clock::now()));
+    }
+
+    // 已过期或落在当前刻度内的任务在下一个刻度执行
+    const uint64_t expireTick = std::max(tickOf(deadline), current_tick_ + 1);
+    const TimerId id = ++next_id_;
+    timers_.emplace(id, Timer{expireTick, std::move(task)});
+    place(id, expireTick);
+    return id;
+}
+
+bool TimerWheel::cancel(TimerId id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    // 槽位中的ID在该槽位下次被处理时丢弃
+    return timers_.erase(id) != 0;
+}
+
+size_t TimerWheel::advance(Clock::time_point now) {
+    std::vector<Task> expired;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        // 只处理已经完整经过的刻度
+        const uint64_t target = elapsedTicks(now);
+
+        while (current_tick_ < target) {
+            // 没有定时任务时直接跳到目标刻度（空闲期间没有推进的情况由 schedule() 处理）
+            if (timers_.empty()) {
+                current_tick_ = target;
+                break;
+            }
+            step(expired);
+        }
+    }
+
+    for (auto& task : expired) {
+        try {
+            task();
+        } catch (const std::exception& e) {
+            LOG_ERROR("定时任务异常: " << e.what());
+        } catch (...) {
+            LOG_ERROR("定时任务未知异常");
+        }
+    }
+    return expired.size();
+}
+
+uint64_t TimerWheel::currentTick() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return current_tick_;
+}
+
+size_t TimerWheel::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return timers_.size();
+}
+
+} // namespace common
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace common {
+
+/**
+ * @brief 分层哈希时间轮，集中管理大量截止时间
+ *
+ * 时间按固定的刻度（tick）离散化。第 0 层有 256 个槽位，每个槽位对应一个刻度；第 1..3 层
+ * 各有 64 个槽位，每个槽位分别对应 256、256*64、256*64*64 个刻度。定时任务按距到期的刻度数
+ * 放入能容纳它的最低一层；低层转完一圈时把高一层当前槽位中的任务重新分配到低层（级联）。
+ * 登记和取消都是 O(1)，推进一个刻度只访问第 0 层的一个槽位（级联时再加一个高层槽位），
+ * 同一刻度到期的任务成批执行，远期任务不会在每一圈被重复访问。
+ *
+ * schedule()/cancel() 可以在任意线程调用；advance() 由驱动时间轮的线程（IO线程）调用，
+ * 到期任务在 advance() 中、锁外执行。任务的实际执行时间不早于截止时间，最多晚一个刻度。
+ */
+class TimerWheel {
+public:
+    using Clock = std::chrono::steady_clock;
+    using TimerId = uint64_t;
+    using Task = std::function<void()>;
+
+    /**
+     * @brief 构造函数
+     * @param tick 刻度，即定时精度；10ms 刻度下最高层一圈约 7.7 天，更远的任务到时会重新分配
+     */
+    explicit TimerWheel(std::chrono::milliseconds tick = std::chrono::milliseconds(10));
+
+    TimerWheel(const TimerWheel&) = delete;
+    TimerWheel& operator=(const TimerWheel&) = delete;
+
+    /**
+     * @brief 登记定时任务
+     * @param deadline 截止时间，已过期时在下一次 advance() 中执行
+     * @param task 到期时执行的任务
+     * @return 定时任务ID，用于取消，从不为 0
+     */
+    TimerId schedule(Clock::time_point deadline, Task task);
+
+    /**
+     * @brief 取消尚未执行的定时任务
+     * @return 任务已执行、已取消或不存在时返回 false
+     */
+    bool cancel(TimerId id);
+
+    /**
+     * @brief 推进到 now，执行所有已到期的任务
+     * @return 执行的任务数
+     */
+    size_t advance(Clock::time_point now);
+
+    /**
+     * @brief 尚未执行的定时任务数
+     */
+    size_t size() const;
+
+    /**
+     * @brief 刻度
+     */
+    std::chrono::milliseconds tick() const { return tick_; }
+
+    /**
+     * @brief 已处理到的刻度（自构造起的刻度数）
+     */
+    uint64_t currentTick() const;
+
+private:
+    struct Timer {
+        uint64_t expireTick;
+        Task task;
+    };
+
+    static constexpr unsigned LEVEL_COUNT = 4;
+    static constexpr unsigned LEVEL0_BITS = 8;   ///< 第 0 层 256 个槽位
+    static constexpr unsigned LEVEL_BITS = 6;    ///< 第 1..3 层各 64 个槽位
+    static constexpr uint64_t MAX_DELTA = (uint64_t(1) << (LEVEL0_BITS + LEVEL_BITS * (LEVEL_COUNT - 1))) - 1;
+
+    /**
+     * @brief 时间点所在的刻度，向上取整，保证任务不会提前执行
+     */
+    uint64_t tickOf(Clock::time_point time) const;
+
+    /**
+     * @brief 截至 now 已完整经过的刻度数，向下取整
+     */
+    uint64_t elapsedTicks(Clock::time_point now) const;
+
+    /**
+     * @brief 按距到期的刻度数把任务放入对应层的槽位（持锁调用）
+     */
+    void place(TimerId id, uint64_t expireTick);
+
+    /**
+     * @brief 把某一层一个槽位中的任务重新分配到低层（持锁调用）
+     */
+    void cascade(unsigned level, size_t index);
+
+    /**
+     * @brief 推进一个刻度，收集到期任务（持锁调用）
+     */
+    void step(std::vector<Task>& expired);
+
+    static unsigned shiftOf(unsigned level) { return level == 0 ? 0 : LEVEL0_BITS + LEVEL_BITS * (level - 1); }
+
+    const std::chrono::milliseconds tick_;
+    const Clock::time_point start_;
+
+    mutable std::mutex mutex_;
+    uint64_t current_tick_ = 0;                                  // 已处理到的刻度
+    TimerId next_id_ = 0;
+    std::vector<std::vector<TimerId>> levels_[LEVEL_COUNT];      // 槽位中的ID可能已被取消，处理时跳过
+    std::unordered_map<TimerId, Timer> timers_;
+};
+
+} // namespace common
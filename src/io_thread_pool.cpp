@@ -0,0 +1,16 @@
+#include "io_thread_pool.h"
+#include "network/io_service.hpp"
+
+namespace robotserver_sdk {
+
+IoThreadPool::IoThreadPool(size_t threadCount)
+    : service_(std::make_shared<network::IoService>(threadCount)) {
+}
+
+IoThreadPool::~IoThreadPool() = default;
+
+size_t IoThreadPool::threadCount() const {
+    return service_->threadCount();
+}
+
+} // namespace robotserver_sdk
@@ -1,15 +1,18 @@
 #include <navigation_sdk.h>
 #include <chrono>
 #include <mutex>
-#include <condition_variable>
 #include <atomic>
-#include <iostream>
-#include <sstream>
-#include <iomanip>
-#include <ctime>
-
+#include <random>
+
+#include "common/in_flight_window.hpp"
+#include "common/logging.hpp"
+#include "common/latency_histogram.hpp"
+#include "common/pending_request_table.hpp"
+#include "common/seqlock.hpp"
+#include "common/single_flight.hpp"
 #include "network/asio_network_model.hpp"
 #include "protocol/messages.hpp"
+#include "protocol/message_registry.hpp"
 
 namespace robotserver_sdk {
 
@@ -50,11 +53,11 @@ ScopeGuard<F> makeScopeGuard(F f) {
  * @tparam Callback 回调函数类型
  * @tparam Args 回调函数参数类型
  * @param callback 用户回调函数
- * @param callbackType 回调函数类型描述，用于日志记录
+ * @param callbackType 回调函数类型描述，用于日志记录；字面量不构造 std::string，热点路径上不分配内存
  * @param args 回调函数参数
  */
 template<typename Callback, typename... Args>
-void safeCallback(const Callback& callback, const std::string& callbackType, Args&&... args) {
+void safeCallback(const Callback& callback, const char* callbackType, Args&&... args) {
     if (!callback) {
         return;
     }
@@ -62,22 +65,31 @@ void safeCallback(const Callback& callback, const std::string& callbackType, Arg
     try {
         callback(std::forward<Args>(args)...);
     } catch (const std::exception& e) {
-        auto now = std::chrono::system_clock::now();
-        auto time_t_now = std::chrono::system_clock::to_time_t(now);
-        std::stringstream ss;
-        ss << std::put_time(std::localtime(&time_t_now), "%Y-%m-%d %H:%M:%S");
-
-        std::cerr << "[" << ss.str() << "] " << callbackType << " 回调函数异常: " << e.what() << std::endl;
+        LOG_ERROR(callbackType << " 回调函数异常: " << e.what());
     } catch (...) {
-        auto now = std::chrono::system_clock::now();
-        auto time_t_now = std::chrono::system_clock::to_time_t(now);
-        std::stringstream ss;
-        ss << std::put_time(std::localtime(&time_t_now), "%Y-%m-%d %H:%M:%S");
-
-        std::cerr << "[" << ss.str() << "] " << callbackType << " 回调函数发生未知异常" << std::endl;
+        LOG_ERROR(callbackType << " 回调函数发生未知异常");
     }
 }
 
+protocol::NavigationPoint toProtocolPoint(const NavigationPoint& point) {
+    protocol::NavigationPoint proto_point;
+    proto_point.mapId = point.mapId;
+    proto_point.value = point.value;
+    proto_point.posX = point.posX;
+    proto_point.posY = point.posY;
+    proto_point.posZ = point.posZ;
+    proto_point.angleYaw = point.angleYaw;
+    proto_point.pointInfo = point.pointInfo;
+    proto_point.gait = point.gait;
+    proto_point.speed = point.speed;
+    proto_point.manner = point.manner;
+    proto_point.obsMode = point.obsMode;
+    proto_point.navMode = point.navMode;
+    proto_point.terrain = point.terrain;
+    proto_point.posture = point.posture;
+    return proto_point;
+}
+
 RealTimeStatus convertToRealTimeStatus(const protocol::GetRealTimeStatusResponse& realTimeResp) {
     RealTimeStatus status;
     status.motionState = realTimeResp.motionState;
@@ -110,18 +122,95 @@ RealTimeStatus convertToRealTimeStatus(const protocol::GetRealTimeStatusResponse
     return status;
 }
 
+/**
+ * @brief 把 1002 响应转换为 RealTimeStatus
+ * @param response 响应消息，为空表示没有收到响应
+ * @param missing 没有收到响应时的错误码
+ */
+RealTimeStatus makeRealTimeStatus(const protocol::IMessage* response, ErrorCode_RealTimeStatus missing) {
+    RealTimeStatus status;
+    if (!response) {
+        status.errorCode = missing;
+        return status;
+    }
+
+    auto* realTimeResp = protocol::messageCast<protocol::GetRealTimeStatusResponse>(response);
+    if (!realTimeResp) {
+        status.errorCode = ErrorCode_RealTimeStatus::INVALID_RESPONSE;
+        return status;
+    }
+
+    // 转换为SDK的RealTimeStatus
+    return convertToRealTimeStatus(*realTimeResp);
+}
+
+/**
+ * @brief 把 1004 响应转换为操作是否成功
+ */
+bool isCancelSucceeded(const protocol::IMessage* response) {
+    auto* cancelResp = protocol::messageCast<protocol::CancelTaskResponse>(response);
+    return cancelResp && cancelResp->errorCode == protocol::ErrorCode_CancelTask::SUCCESS;
+}
+
+/**
+ * @brief 把 1007 响应转换为 TaskStatusResult
+ * @param response 响应消息，为空表示没有收到响应
+ * @param missing 没有收到响应时的错误码
+ */
+TaskStatusResult makeTaskStatusResult(const protocol::IMessage* response, ErrorCode_QueryStatus missing) {
+    TaskStatusResult result;
+    if (!response) {
+        result.errorCode = missing;
+        return result;
+    }
+
+    auto* statusResp = protocol::messageCast<protocol::QueryStatusResponse>(response);
+    if (!statusResp) {
+        result.errorCode = ErrorCode_QueryStatus::INVALID_RESPONSE;
+        return result;
+    }
+
+    // 转换为SDK的TaskStatusResult
+    result.status = static_cast<Status_QueryStatus>(statusResp->status);
+    result.errorCode = static_cast<ErrorCode_QueryStatus>(statusResp->errorCode);
+    result.value = statusResp->value;
+    return result;
+}
+
+/**
+ * @brief 用回调式接口构造 std::future
+ * @tparam Result 结果类型
+ * @param start 发起请求的函数，参数为结果回调
+ */
+template <typename Result, typename Start>
+std::future<Result> makeFuture(Start start) {
+    auto promise = std::make_shared<std::promise<Result>>();
+    std::future<Result> future = promise->get_future();
+    start([promise](const Result& result) {
+        promise->set_value(result);
+    });
+    return future;
+}
+
 // SDK实现类
 class RobotServerSdkImpl : public network::INetworkCallback {
 public:
     RobotServerSdkImpl(const SdkOptions& options)
         : options_(options),
-          network_model_(std::make_unique<network::AsioNetworkModel>(*this)) {
+          network_model_(std::make_unique<network::AsioNetworkModel>(
+              *this, options.ioThreadPool ? options.ioThreadPool->service_ : nullptr)),
+          request_window_(options.maxInFlightRequests) {
         // 设置网络模型的连接超时时间
         network_model_->setConnectionTimeout(options_.connectionTimeout);
+        network_model_->setKeepAlive(options_.tcpKeepAlive);
     }
 
     ~RobotServerSdkImpl() {
         disconnect();
+
+        // 先释放网络模型：其析构等待IO线程上正在执行的处理函数结束，之后定时任务和响应都不再
+        // 访问本对象，其余成员才能安全析构
+        network_model_.reset();
     }
 
     bool connect(const std::string& host, uint16_t port) {
@@ -130,26 +219,38 @@ public:
                 return true;
             }
 
-            return network_model_->connect(host, port);
+            // 先开启托管会话再连接，连接建立后立即断开也能触发重连
+            session_active_ = options_.autoReconnect;
+            const bool connected = network_model_->connect(host, port);
+            if (!connected) {
+                session_active_ = false;
+            } else {
+                startHeartbeat();
+            }
+            return connected;
         } catch (const std::exception& e) {
-            std::cerr << "connect 异常: " << e.what() << std::endl;
+            LOG_ERROR("connect 异常: " << e.what());
             return false;
         } catch (...) {
-            std::cerr << "connect 未知异常" << std::endl;
+            LOG_ERROR("connect 未知异常");
             return false;
         }
     }
     void disconnect() {
         try {
-            if (!isConnected()) {
-                return;
+            // 结束托管会话；正在进行的重连由 disconnect() 关闭 socket 中止
+            const bool reconnecting = session_active_.exchange(false);
+            ++heartbeat_epoch_;
+            if (isConnected() || reconnecting) {
+                network_model_->disconnect();
             }
 
-            network_model_->disconnect();
+            // 连接可能已被动断开，无论如何都要结束在途请求，异步请求以 NOT_CONNECTED 完成
+            pending_requests_.cancelAll();
         } catch (const std::exception& e) {
-            std::cerr << "disconnect 异常: " << e.what() << std::endl;
+            LOG_ERROR("disconnect 异常: " << e.what());
         } catch (...) {
-            std::cerr << "disconnect 未知异常" << std::endl;
+            LOG_ERROR("disconnect 未知异常");
         }
     }
 
@@ -157,14 +258,40 @@ public:
         try {
             return network_model_->isConnected();
         } catch (const std::exception& e) {
-            std::cerr << "isConnected 异常: " << e.what() << std::endl;
+            LOG_ERROR("isConnected 异常: " << e.what());
             return false;
         } catch (...) {
-            std::cerr << "isConnected 未知异常" << std::endl;
+            LOG_ERROR("isConnected 未知异常");
             return false;
         }
     }
 
+    ConnectionHealth connectionHealth() const {
+        ConnectionHealth health;
+        health.lastRtt = std::chrono::microseconds(last_rtt_us_.load());
+        health.smoothedRtt = std::chrono::microseconds(smoothed_rtt_us_.load());
+        health.missedHeartbeats = missed_heartbeats_.load();
+        return health;
+    }
+
+    MetricsSnapshot metrics() const {
+        MetricsSnapshot snapshot;
+        snapshot.latency1002 = latencySnapshotOf(latency_1002_);
+        snapshot.latency1003 = latencySnapshotOf(latency_1003_);
+        snapshot.latency1004 = latencySnapshotOf(latency_1004_);
+        snapshot.latency1007 = latencySnapshotOf(latency_1007_);
+
+        const network::TrafficCounters& traffic = network_model_->trafficCounters();
+        snapshot.bytesSent = traffic.bytesSent.load(std::memory_order_relaxed);
+        snapshot.bytesReceived = traffic.bytesReceived.load(std::memory_order_relaxed);
+        snapshot.framesSent = traffic.framesSent.load(std::memory_order_relaxed);
+        snapshot.framesDecoded = traffic.framesDecoded.load(std::memory_order_relaxed);
+        snapshot.decodeFailures = traffic.decodeFailures.load(std::memory_order_relaxed);
+        snapshot.timeouts = timeouts_.load(std::memory_order_relaxed);
+        snapshot.reconnects = reconnects_.load(std::memory_order_relaxed);
+        return snapshot;
+    }
+
     RealTimeStatus request1002_RunTimeStatus() {
         try {
             if (!isConnected()) {
@@ -173,68 +300,154 @@ public:
                 return status;
             }
 
-            // 创建请求消息
-            protocol::GetRealTimeStatusRequest request;
-            request.timestamp = getCurrentTimestamp();
-
-            // 生成并设置序列号
-            uint16_t seqNum = generateSequenceNumber();
-            request.setSequenceNumber(seqNum);
-
-            // 添加到待处理请求，标记为同步请求
-            addPendingRequest(seqNum, protocol::MessageType::GET_REAL_TIME_STATUS_RESP);
+            RealTimeStatus cached;
+            if (freshCachedRealTimeStatus(cached)) {
+                return cached;
+            }
 
-            // 创建ScopeGuard，在函数结束时自动移除请求
-            auto guard = makeScopeGuard([this, seqNum]() {
-                removePendingRequest(seqNum);
-            });
+            if (!options_.coalesceQueries) {
+                return sendRealTimeStatusRequest();
+            }
 
-            // 发送请求
-            network_model_->sendMessage(request);
+            // 已有 1002 在途时等待它的结果，不再发出新的请求
+            auto shared = std::make_shared<std::promise<RealTimeStatus>>();
+            auto sharedResult = shared->get_future();
+            if (status_flight_.join([shared](const RealTimeStatus& status) { shared->set_value(status); })) {
+                if (sharedResult.wait_for(options_.requestTimeout) == std::future_status::ready) {
+                    return sharedResult.get();
+                }
+                RealTimeStatus status;
+                status.errorCode = missingRealTimeStatusError();
+                return status;
+            }
 
-            // 等待响应
-            std::unique_ptr<protocol::GetRealTimeStatusResponse> realTimeResp;
-            {
-                std::unique_lock<std::mutex> lock(pending_requests_mutex_);
-                auto& pendingReq = pendingRequests_[seqNum];
+            // 本调用是发起者，把结果交给期间合并进来的调用方
+            const RealTimeStatus status = sendRealTimeStatusRequest();
+            status_flight_.complete(status);
+            return status;
+        } catch (const std::exception& e) {
+            LOG_ERROR("request1002_RunTimeStatus 异常: " << e.what());
+            RealTimeStatus status;
+            status.errorCode = ErrorCode_RealTimeStatus::UNKNOWN_ERROR;
+            return status;
+        } catch (...) {
+            LOG_ERROR("request1002_RunTimeStatus 未知异常");
+            RealTimeStatus status;
+            status.errorCode = ErrorCode_RealTimeStatus::UNKNOWN_ERROR;
+            return status;
+        }
+    }
 
-                if (!pendingReq.responseReceived) {
-                    pendingReq.cv->wait_for(lock, options_.requestTimeout,
-                        [&pendingReq]() { return pendingReq.responseReceived; });
-                }
+    void request1002_RunTimeStatus(RealTimeStatusCallback callback, std::chrono::milliseconds timeout) {
+        try {
+            if (!isConnected()) {
+                RealTimeStatus status;
+                status.errorCode = ErrorCode_RealTimeStatus::NOT_CONNECTED;
+                safeCallback(callback, "实时状态", status);
+                return;
+            }
 
-                if (!pendingReq.responseReceived) {
-                    RealTimeStatus status;
-                    status.errorCode = ErrorCode_RealTimeStatus::TIMEOUT;
-                    return status;
-                }
+            RealTimeStatus cached;
+            if (freshCachedRealTimeStatus(cached)) {
+                safeCallback(callback, "实时状态", cached);
+                return;
+            }
 
-                auto* castedPtr = dynamic_cast<protocol::GetRealTimeStatusResponse*>(pendingReq.response.get());
-                if (castedPtr) {
-                    realTimeResp = std::unique_ptr<protocol::GetRealTimeStatusResponse>(castedPtr);
-                    pendingReq.response.release();  // 释放所有权但不删除对象
+            // 已有 1002 在途时合并到该请求；否则本请求的结果同时交给之后合并进来的调用方
+            if (options_.coalesceQueries) {
+                if (status_flight_.join([callback](const RealTimeStatus& status) {
+                        safeCallback(callback, "实时状态", status);
+                    })) {
+                    return;
                 }
+                callback = [this, callback = std::move(callback)](const RealTimeStatus& status) {
+                    status_flight_.complete(status);
+                    safeCallback(callback, "实时状态", status);
+                };
             }
 
-            if (!realTimeResp) {
+            auto onComplete = [this, callback](std::unique_ptr<protocol::IMessage> response) {
+                safeCallback(callback, "实时状态", makeRealTimeStatus(response.get(), missingRealTimeStatusError()));
+            };
+            if (!startAsyncRequest<protocol::GetRealTimeStatusRequest>(
+                    protocol::MessageType::GET_REAL_TIME_STATUS_RESP, timeout, std::move(onComplete))) {
                 RealTimeStatus status;
-                status.errorCode = ErrorCode_RealTimeStatus::INVALID_RESPONSE;
-                return status;
+                status.errorCode = ErrorCode_RealTimeStatus::UNKNOWN_ERROR;
+                safeCallback(callback, "实时状态", status);
             }
-
-            // 转换为SDK的RealTimeStatus
-            return convertToRealTimeStatus(*realTimeResp);
-
         } catch (const std::exception& e) {
-            std::cerr << "request1002_RunTimeStatus 异常: " << e.what() << std::endl;
+            LOG_ERROR("request1002_RunTimeStatus 异常: " << e.what());
             RealTimeStatus status;
             status.errorCode = ErrorCode_RealTimeStatus::UNKNOWN_ERROR;
-            return status;
+            safeCallback(callback, "实时状态", status);
         } catch (...) {
-            std::cerr << "request1002_RunTimeStatus 未知异常" << std::endl;
+            LOG_ERROR("request1002_RunTimeStatus 未知异常");
             RealTimeStatus status;
             status.errorCode = ErrorCode_RealTimeStatus::UNKNOWN_ERROR;
-            return status;
+            safeCallback(callback, "实时状态", status);
+        }
+    }
+
+    bool latestRealTimeStatus(RealTimeStatus& status, std::chrono::steady_clock::time_point& updatedAt) const {
+        CachedRealTimeStatus cached;
+        if (!status_cache_.load(cached)) {
+            return false;
+        }
+        status = cached.status;
+        updatedAt = cached.updatedAt;
+        return true;
+    }
+
+    uint32_t subscribeRealTimeStatus(std::chrono::milliseconds interval, RealTimeStatusCallback callback) {
+        try {
+            if (interval <= std::chrono::milliseconds::zero() || !callback) {
+                return 0;
+            }
+
+            auto subscription = std::make_shared<StatusSubscription>();
+            subscription->interval = interval;
+            subscription->callback = std::move(callback);
+            subscription->nextTick = std::chrono::steady_clock::now();
+            {
+                std::lock_guard<std::mutex> lock(subscriptions_mutex_);
+                subscription->id = ++next_subscription_id_;
+                subscriptions_[subscription->id] = subscription;
+            }
+
+            // 第一个周期立即开始，之后由IO线程自行调度
+            network_model_->scheduleAfter(std::chrono::milliseconds::zero(), [this, subscription]() {
+                pollSubscription(subscription);
+            });
+            return subscription->id;
+        } catch (const std::exception& e) {
+            LOG_ERROR("subscribeRealTimeStatus 异常: " << e.what());
+            return 0;
+        } catch (...) {
+            LOG_ERROR("subscribeRealTimeStatus 未知异常");
+            return 0;
+        }
+    }
+
+    void unsubscribeRealTimeStatus(uint32_t subscriptionId) {
+        try {
+            std::shared_ptr<StatusSubscription> subscription;
+            {
+                std::lock_guard<std::mutex> lock(subscriptions_mutex_);
+                auto it = subscriptions_.find(subscriptionId);
+                if (it == subscriptions_.end()) {
+                    return;
+                }
+                subscription = it->second;
+                subscriptions_.erase(it);
+            }
+
+            // 等待其他线程中正在执行的回调结束，保证返回后不再调用；在回调中调用时锁可重入
+            std::lock_guard<std::recursive_mutex> lock(subscription->mutex);
+            subscription->active = false;
+        } catch (const std::exception& e) {
+            LOG_ERROR("unsubscribeRealTimeStatus 异常: " << e.what());
+        } catch (...) {
+            LOG_ERROR("unsubscribeRealTimeStatus 未知异常");
         }
     }
 
@@ -257,47 +470,131 @@ public:
 
             // 创建请求消息
             protocol::NavigationTaskRequest request;
-            request.timestamp = getCurrentTimestamp();
-
-            // 生成并设置序列号
-            uint16_t seqNum = generateSequenceNumber();
-            request.setSequenceNumber(seqNum);
 
             // 转换导航点
+            request.points.reserve(points.size());
             for (const auto& point : points) {
-                protocol::NavigationPoint proto_point;
-                proto_point.mapId = point.mapId;
-                proto_point.value = point.value;
-                proto_point.posX = point.posX;
-                proto_point.posY = point.posY;
-                proto_point.posZ = point.posZ;
-                proto_point.angleYaw = point.angleYaw;
-                proto_point.pointInfo = point.pointInfo;
-                proto_point.gait = point.gait;
-                proto_point.speed = point.speed;
-                proto_point.manner = point.manner;
-                proto_point.obsMode = point.obsMode;
-                proto_point.navMode = point.navMode;
-                proto_point.terrain = point.terrain;
-                proto_point.posture = point.posture;
-                request.points.push_back(proto_point);
-            }
-
-            // 保存回调函数
+                request.points.push_back(toProtocolPoint(point));
+            }
+
+            startNavigationTask(std::move(request), std::move(callback));
+        } catch (const std::exception& e) {
+            LOG_ERROR("request1003_StartNavTask 异常: " << e.what());
+            NavigationResult failResult;
+            failResult.errorCode = ErrorCode_Navigation::UNKNOWN_ERROR;
+            safeCallback(callback, "导航结果", failResult);
+        } catch (...) {
+            LOG_ERROR("request1003_StartNavTask 未知异常");
+            NavigationResult failResult;
+            failResult.errorCode = ErrorCode_Navigation::UNKNOWN_ERROR;
+            safeCallback(callback, "导航结果", failResult);
+        }
+    }
+
+    void request1003_StartNavRoute(const std::vector<NavigationPoint>& points, NavigationResultCallback callback,
+                                   RouteProgressCallback progress, const RouteOptions& options) {
+        std::shared_ptr<RouteSession> route;
+        try {
+            if (!callback || points.empty()) {
+                NavigationResult failResult;
+                failResult.errorCode = ErrorCode_Navigation::INVALID_PARAM;
+                safeCallback(callback, "导航结果", failResult);
+                return;
+            }
+
+            if (!isConnected()) {
+                NavigationResult failResult;
+                failResult.errorCode = ErrorCode_Navigation::NOT_CONNECTED;
+                safeCallback(callback, "导航结果", failResult);
+                return;
+            }
+
+            route = std::make_shared<RouteSession>();
+            route->points.reserve(points.size());
+            for (const auto& point : points) {
+                route->points.push_back(toProtocolPoint(point));
+            }
+            route->chunks = protocol::NavigationTaskRequest::splitRoute(route->points, options.maxPointsPerChunk);
+            route->options = options;
+            route->callback = std::move(callback);
+            route->progress = std::move(progress);
+            route->state.totalPoints = route->points.size();
+            route->state.totalChunks = route->chunks.size();
+            route->state.sentChunks = 1;
+
+            safeCallback(route->progress, "路线进度", route->state);
+            sendRouteChunk(route, 0);
+            scheduleRoutePoll(route);
+        } catch (const std::exception& e) {
+            LOG_ERROR("request1003_StartNavRoute 异常: " << e.what());
+            failRouteStart(route, callback);
+        } catch (...) {
+            LOG_ERROR("request1003_StartNavRoute 未知异常");
+            failRouteStart(route, callback);
+        }
+    }
+
+
+    /**
+     * @brief 下发一个 1003 导航任务并登记结果回调
+     * @param request 已填好导航点的请求，序列号在此分配
+     * @param callback 结果回调，恰好调用一次
+     */
+    void startNavigationTask(protocol::NavigationTaskRequest request, NavigationResultCallback callback) {
+        try {
+            // 分配序列号并保存回调函数；序列号回绕后可能与仍在等待结果的任务相同，跳过这些序列号
+            uint16_t seqNum = 0;
+            uint64_t ticket = 0;
             {
                 std::lock_guard<std::mutex> lock(navigation_result_callbacks_mutex_);
-                navigation_result_callbacks_[seqNum] = std::move(callback);
+                do {
+                    seqNum = pending_requests_.nextSequenceNumber();
+                } while (navigation_result_callbacks_.count(seqNum) != 0);
+
+                ticket = ++next_navigation_ticket_;
+                NavigationWaiter& waiter = navigation_result_callbacks_[seqNum];
+                waiter.callback = std::move(callback);
+                waiter.ticket = ticket;
+                waiter.sentAt = std::chrono::steady_clock::now();
             }
+            request.setSequenceNumber(seqNum);
 
-            // 发送请求
-            network_model_->sendMessage(request);
+            // 结果迟迟不到时由时间轮以 TIMEOUT 结束任务，回调不会无限期滞留
+            if (options_.navigationTimeout > std::chrono::milliseconds::zero()) {
+                const auto timer = network_model_->scheduleAfter(options_.navigationTimeout, [this, seqNum, ticket]() {
+                    NavigationWaiter expired;
+                    if (takeNavigationWaiter(seqNum, ticket, expired)) {
+                        timeouts_.fetch_add(1, std::memory_order_relaxed);
+                        NavigationResult timeoutResult;
+                        timeoutResult.errorCode = ErrorCode_Navigation::TIMEOUT;
+                        safeCallback(expired.callback, "导航结果", timeoutResult);
+                    }
+                });
+
+                std::lock_guard<std::mutex> lock(navigation_result_callbacks_mutex_);
+                auto it = navigation_result_callbacks_.find(seqNum);
+                if (it != navigation_result_callbacks_.end() && it->second.ticket == ticket) {
+                    it->second.timer = timer;
+                }
+            }
+
+            // 发送请求；失败时（例如导航点过多，消息体超出协议长度字段的范围）取回回调并立即报告
+            if (!network_model_->sendMessage(request)) {
+                NavigationWaiter failed;
+                if (takeNavigationWaiter(seqNum, ticket, failed)) {
+                    NavigationResult failResult;
+                    failResult.errorCode = isConnected() ? ErrorCode_Navigation::INVALID_PARAM
+                                                         : ErrorCode_Navigation::NOT_CONNECTED;
+                    safeCallback(failed.callback, "导航结果", failResult);
+                }
+            }
         } catch (const std::exception& e) {
-            std::cerr << "request1003_StartNavTask 异常: " << e.what() << std::endl;
+            LOG_ERROR("request1003_StartNavTask 异常: " << e.what());
             NavigationResult failResult;
             failResult.errorCode = ErrorCode_Navigation::UNKNOWN_ERROR;
             safeCallback(callback, "导航结果", failResult);
         } catch (...) {
-            std::cerr << "request1003_StartNavTask 未知异常" << std::endl;
+            LOG_ERROR("request1003_StartNavTask 未知异常");
             NavigationResult failResult;
             failResult.errorCode = ErrorCode_Navigation::UNKNOWN_ERROR;
             safeCallback(callback, "导航结果", failResult);
@@ -310,236 +607,934 @@ public:
                 return false;
             }
 
+            // 取得流水线窗口名额，窗口已满时等待，等待时间计入请求超时
+            const auto deadline = std::chrono::steady_clock::now() + options_.requestTimeout;
+            if (!request_window_.acquireUntil(deadline)) {
+                return false;
+            }
+            auto permit = makeScopeGuard([this]() {
+                request_window_.release();
+            });
+
             // 创建请求消息
             protocol::CancelTaskRequest request;
-            request.timestamp = getCurrentTimestamp();
 
-            // 生成并设置序列号
-            uint16_t seqNum = generateSequenceNumber();
+            // 分配序列号并登记到待处理请求表
+            uint16_t seqNum = 0;
+            if (!pending_requests_.acquire(protocol::MessageType::CANCEL_TASK_RESP, seqNum)) {
+                return false;
+            }
             request.setSequenceNumber(seqNum);
 
-            // 添加到待处理请求，标记为同步请求
-            addPendingRequest(seqNum, protocol::MessageType::CANCEL_TASK_RESP);
-
             // 创建ScopeGuard，在函数结束时自动移除请求
             auto guard = makeScopeGuard([this, seqNum]() {
-                removePendingRequest(seqNum);
+                pending_requests_.release(seqNum);
             });
 
             // 发送请求
             network_model_->sendMessage(request);
 
             // 等待响应
-            std::unique_ptr<protocol::CancelTaskResponse> cancelResp;
-            {
-                std::unique_lock<std::mutex> lock(pending_requests_mutex_);
-                auto& pendingReq = pendingRequests_[seqNum];
+            auto response = waitResponse(seqNum, protocol::MessageType::CANCEL_TASK_RESP, deadline);
+            return isCancelSucceeded(response.get());
+
+        } catch (const std::exception& e) {
+            LOG_ERROR("request1004_CancelNavTask 异常: " << e.what());
+            return false;
+        } catch (...) {
+            LOG_ERROR("request1004_CancelNavTask 未知异常");
+            return false;
+        }
+    }
 
-                if (!pendingReq.responseReceived) {
-                    pendingReq.cv->wait_for(lock, options_.requestTimeout,
-                        [&pendingReq]() { return pendingReq.responseReceived; });
+    void request1004_CancelNavTask(CancelTaskCallback callback, std::chrono::milliseconds timeout) {
+        try {
+            if (!isConnected()) {
+                safeCallback(callback, "取消任务", false);
+                return;
+            }
+
+            auto onComplete = [callback](std::unique_ptr<protocol::IMessage> response) {
+                safeCallback(callback, "取消任务", isCancelSucceeded(response.get()));
+            };
+            if (!startAsyncRequest<protocol::CancelTaskRequest>(
+                    protocol::MessageType::CANCEL_TASK_RESP, timeout, std::move(onComplete))) {
+                safeCallback(callback, "取消任务", false);
+            }
+        } catch (const std::exception& e) {
+            LOG_ERROR("request1004_CancelNavTask 异常: " << e.what());
+            safeCallback(callback, "取消任务", false);
+        } catch (...) {
+            LOG_ERROR("request1004_CancelNavTask 未知异常");
+            safeCallback(callback, "取消任务", false);
+        }
+    }
+
+    TaskStatusResult request1007_NavTaskStatus() {
+        try {
+            if (!isConnected()) {
+                TaskStatusResult result;
+                result.errorCode = ErrorCode_QueryStatus::NOT_CONNECTED;
+                return result;
+            }
+
+            if (!options_.coalesceQueries) {
+                return sendTaskStatusRequest();
+            }
+
+            // 已有 1007 在途时等待它的结果，不再发出新的请求
+            auto shared = std::make_shared<std::promise<TaskStatusResult>>();
+            auto sharedResult = shared->get_future();
+            if (task_status_flight_.join([shared](const TaskStatusResult& result) { shared->set_value(result); })) {
+                if (sharedResult.wait_for(options_.requestTimeout) == std::future_status::ready) {
+                    return sharedResult.get();
                 }
+                TaskStatusResult result;
+                result.errorCode = missingTaskStatusError();
+                return result;
+            }
 
-                if (!pendingReq.responseReceived) {
-                    return false;
+            // 本调用是发起者，把结果交给期间合并进来的调用方
+            const TaskStatusResult result = sendTaskStatusRequest();
+            task_status_flight_.complete(result);
+            return result;
+        } catch (const std::exception& e) {
+            LOG_ERROR("request1007_NavTaskStatus 异常: " << e.what());
+            TaskStatusResult result;
+            result.errorCode = ErrorCode_QueryStatus::UNKNOWN_ERROR;
+            return result;
+        } catch (...) {
+            LOG_ERROR("request1007_NavTaskStatus 未知异常");
+            TaskStatusResult result;
+            result.errorCode = ErrorCode_QueryStatus::UNKNOWN_ERROR;
+            return result;
+        }
+    }
+
+    void request1007_NavTaskStatus(TaskStatusCallback callback, std::chrono::milliseconds timeout) {
+        try {
+            if (!isConnected()) {
+                TaskStatusResult result;
+                result.errorCode = ErrorCode_QueryStatus::NOT_CONNECTED;
+                safeCallback(callback, "任务状态", result);
+                return;
+            }
+
+            // 已有 1007 在途时合并到该请求；否则本请求的结果同时交给之后合并进来的调用方
+            if (options_.coalesceQueries) {
+                if (task_status_flight_.join([callback](const TaskStatusResult& result) {
+                        safeCallback(callback, "任务状态", result);
+                    })) {
+                    return;
                 }
+                callback = [this, callback = std::move(callback)](const TaskStatusResult& result) {
+                    task_status_flight_.complete(result);
+                    safeCallback(callback, "任务状态", result);
+                };
+            }
+
+            auto onComplete = [this, callback](std::unique_ptr<protocol::IMessage> response) {
+                safeCallback(callback, "任务状态", makeTaskStatusResult(response.get(), missingTaskStatusError()));
+            };
+            if (!startAsyncRequest<protocol::QueryStatusRequest>(
+                    protocol::MessageType::QUERY_STATUS_RESP, timeout, std::move(onComplete))) {
+                TaskStatusResult result;
+                result.errorCode = ErrorCode_QueryStatus::UNKNOWN_ERROR;
+                safeCallback(callback, "任务状态", result);
+            }
+        } catch (const std::exception& e) {
+            LOG_ERROR("request1007_NavTaskStatus 异常: " << e.what());
+            TaskStatusResult result;
+            result.errorCode = ErrorCode_QueryStatus::UNKNOWN_ERROR;
+            safeCallback(callback, "任务状态", result);
+        } catch (...) {
+            LOG_ERROR("request1007_NavTaskStatus 未知异常");
+            TaskStatusResult result;
+            result.errorCode = ErrorCode_QueryStatus::UNKNOWN_ERROR;
+            safeCallback(callback, "任务状态", result);
+        }
+    }
+
+    // 实现网络回调接口
+    void onMessageReceived(std::unique_ptr<protocol::IMessage> message) override {
+        try {
+            if (!message) {
+                return;
+            }
+
+            // 任何消息都说明连接仍然存活，心跳周期内有消息时不必探测
+            last_receive_time_ = std::chrono::steady_clock::now().time_since_epoch().count();
+
+            uint16_t seqNum = message->getSequenceNumber();
+            protocol::MessageType msgType = message->getType();
 
-                auto* castedPtr = dynamic_cast<protocol::CancelTaskResponse*>(pendingReq.response.get());
-                if (castedPtr) {
-                    cancelResp = std::unique_ptr<protocol::CancelTaskResponse>(castedPtr);
-                    pendingReq.response.release();  // 释放所有权但不删除对象
+            if (msgType == protocol::MessageType::NAVIGATION_TASK_RESP) {
+
+                // 检查是否有等待此响应的请求
+                NavigationWaiter waiter;
+                if (takeNavigationWaiter(seqNum, 0, waiter)) {
+                    recordLatency(msgType, waiter.sentAt);
+                    auto* resp = protocol::messageCast<protocol::NavigationTaskResponse>(message.get());
+                    if (resp) {
+                        NavigationResult result;
+                        result.value = resp->value;
+                        result.errorCode = static_cast<ErrorCode_Navigation>(resp->errorCode);
+                        result.errorStatus = static_cast<ErrorStatus_Navigation>(resp->errorStatus);
+                        safeCallback(waiter.callback, "导航结果", result);
+                    }
                 }
+
+                return;
             }
 
-            return cancelResp && cancelResp->errorCode == protocol::ErrorCode_CancelTask::SUCCESS;
+            // 任何 1002 请求（包括订阅）的成功结果都更新实时状态缓存
+            if (msgType == protocol::MessageType::GET_REAL_TIME_STATUS_RESP) {
+                CachedRealTimeStatus cached;
+                cached.status = makeRealTimeStatus(message.get(), ErrorCode_RealTimeStatus::INVALID_RESPONSE);
+                cached.updatedAt = std::chrono::steady_clock::now();
+                if (cached.status.errorCode == ErrorCode_RealTimeStatus::SUCCESS) {
+                    status_cache_.store(cached);
+                }
+            }
 
+            // 处理其他类型的响应消息，交给等待该序列号的同步请求
+            pending_requests_.complete(seqNum, msgType, message);
         } catch (const std::exception& e) {
-            std::cerr << "request1004_CancelNavTask 异常: " << e.what() << std::endl;
-            return false;
+            LOG_ERROR("onMessageReceived 异常: " << e.what());
         } catch (...) {
-            std::cerr << "request1004_CancelNavTask 未知异常" << std::endl;
+            LOG_ERROR("onMessageReceived 未知异常");
+        }
+    }
+
+    void onDisconnected() override {
+        ++heartbeat_epoch_;
+
+        if (!session_active_) {
+            // 连接被动断开后响应不会再到达，立即结束所有在途请求
+            pending_requests_.cancelAll();
+            return;
+        }
+
+        // 托管会话：幂等查询保持等待，重连成功后重发，截止时间不变；其余请求立即结束
+        pending_requests_.cancelAll(isReplayable);
+        reconnect_delay_ = options_.reconnectInitialDelay;
+        scheduleReconnect();
+    }
+
+private:
+    /**
+     * @brief 发出固定消息体的异步请求
+     * @tparam Request 请求消息类型
+     * @param responseType 期望的响应类型
+     * @param timeout 本请求的超时时间（包括等待窗口名额的时间），为 0 时使用 SdkOptions::requestTimeout
+     * @param onComplete 完成回调，响应到达、超时或断开连接时恰好调用一次，超时或断开时参数为空
+     * @return 待处理请求表已满时返回 false，此时 onComplete 不会被调用
+     * @note 窗口已满时阻塞调用线程直到有名额归还（背压）；在IO线程中调用时不能等待，直接按超时处理
+     */
+    template <typename Request>
+    bool startAsyncRequest(protocol::MessageType responseType, std::chrono::milliseconds timeout,
+                           common::PendingRequestTable::CompletionHandler onComplete) {
+        if (timeout <= std::chrono::milliseconds::zero()) {
+            timeout = options_.requestTimeout;
+        }
+        const auto deadline = std::chrono::steady_clock::now() + timeout;
+
+        const bool acquired = network_model_->runningInIoThread() ? request_window_.tryAcquire()
+                                                                  : request_window_.acquireUntil(deadline);
+        if (!acquired) {
+            timeouts_.fetch_add(1, std::memory_order_relaxed);
+            onComplete(nullptr);
+            return true;
+        }
+
+        // 请求结束时先取消超时定时任务、归还窗口名额，再调用完成回调，回调中可以立即发出下一个请求。
+        // 超时定时任务执行时先清除 timer，完成回调据此区分超时与断开
+        auto timer = std::make_shared<std::atomic<common::TimerWheel::TimerId>>(0);
+        auto handler = [this, timer, responseType, sentAt = std::chrono::steady_clock::now(),
+                        onComplete = std::move(onComplete)](std::unique_ptr<protocol::IMessage> response) {
+            const auto id = timer->exchange(0);
+            if (id != 0) {
+                network_model_->cancelScheduled(id);
+            }
+            if (response) {
+                recordLatency(responseType, sentAt);
+            } else if (id == 0) {
+                timeouts_.fetch_add(1, std::memory_order_relaxed);
+            }
+            request_window_.release();
+            onComplete(std::move(response));
+        };
+
+        uint16_t seqNum = 0;
+        if (!pending_requests_.acquireAsync(responseType, std::move(handler), seqNum)) {
+            request_window_.release();
             return false;
         }
+
+        // 回调已登记，之后的任何失败都通过 expire() 结束请求，保证回调只调用一次
+        try {
+            timer->store(network_model_->scheduleAfter(remainingUntil(deadline), [this, seqNum, timer]() {
+                timer->store(0);
+                pending_requests_.expire(seqNum);
+            }));
+
+            Request request;
+            request.setSequenceNumber(seqNum);
+            if (!network_model_->sendMessage(request)) {
+                pending_requests_.expire(seqNum);
+            }
+        } catch (const std::exception& e) {
+            LOG_ERROR("异步请求发送异常: " << e.what());
+            pending_requests_.expire(seqNum);
+        }
+        return true;
     }
 
-    TaskStatusResult request1007_NavTaskStatus() {
+    /**
+     * @brief 发出一个 1002 请求并等待响应（同步接口的实际请求部分，不会抛出异常）
+     */
+    RealTimeStatus sendRealTimeStatusRequest() {
         try {
             if (!isConnected()) {
-                TaskStatusResult result;
-                result.errorCode = ErrorCode_QueryStatus::NOT_CONNECTED;
-                return result;
+                RealTimeStatus status;
+                status.errorCode = ErrorCode_RealTimeStatus::NOT_CONNECTED;
+                return status;
+            }
+
+            // 取得流水线窗口名额，窗口已满时等待，等待时间计入请求超时
+            const auto deadline = std::chrono::steady_clock::now() + options_.requestTimeout;
+            if (!request_window_.acquireUntil(deadline)) {
+                RealTimeStatus status;
+                status.errorCode = ErrorCode_RealTimeStatus::TIMEOUT;
+                return status;
             }
+            auto permit = makeScopeGuard([this]() {
+                request_window_.release();
+            });
 
             // 创建请求消息
-            protocol::QueryStatusRequest request;
-            request.timestamp = getCurrentTimestamp();
+            protocol::GetRealTimeStatusRequest request;
 
-            // 生成并设置序列号
-            uint16_t seqNum = generateSequenceNumber();
+            // 分配序列号并登记到待处理请求表
+            uint16_t seqNum = 0;
+            if (!pending_requests_.acquire(protocol::MessageType::GET_REAL_TIME_STATUS_RESP, seqNum)) {
+                RealTimeStatus status;
+                status.errorCode = ErrorCode_RealTimeStatus::UNKNOWN_ERROR;
+                return status;
+            }
             request.setSequenceNumber(seqNum);
 
-            // 添加到待处理请求，标记为同步请求
-            addPendingRequest(seqNum, protocol::MessageType::QUERY_STATUS_RESP);
-
             // 创建ScopeGuard，在函数结束时自动移除请求
             auto guard = makeScopeGuard([this, seqNum]() {
-                removePendingRequest(seqNum);
+                pending_requests_.release(seqNum);
             });
 
             // 发送请求
             network_model_->sendMessage(request);
 
             // 等待响应
-            std::unique_ptr<protocol::QueryStatusResponse> statusResp;
-            {
-                std::unique_lock<std::mutex> lock(pending_requests_mutex_);
-                auto& pendingReq = pendingRequests_[seqNum];
+            auto response = waitResponse(seqNum, protocol::MessageType::GET_REAL_TIME_STATUS_RESP, deadline);
+            return makeRealTimeStatus(response.get(), missingRealTimeStatusError());
 
-                if (!pendingReq.responseReceived) {
-                    pendingReq.cv->wait_for(lock, options_.requestTimeout,
-                        [&pendingReq]() { return pendingReq.responseReceived; });
-                }
+        } catch (const std::exception& e) {
+            LOG_ERROR("request1002_RunTimeStatus 异常: " << e.what());
+            RealTimeStatus status;
+            status.errorCode = ErrorCode_RealTimeStatus::UNKNOWN_ERROR;
+            return status;
+        } catch (...) {
+            LOG_ERROR("request1002_RunTimeStatus 未知异常");
+            RealTimeStatus status;
+            status.errorCode = ErrorCode_RealTimeStatus::UNKNOWN_ERROR;
+            return status;
+        }
+    }
 
-                if (!pendingReq.responseReceived) {
-                    TaskStatusResult result;
-                    result.errorCode = ErrorCode_QueryStatus::TIMEOUT;
-                    return result;
-                }
+    /**
+     * @brief 发出一个 1007 请求并等待响应（同步接口的实际请求部分，不会抛出异常）
+     */
+    TaskStatusResult sendTaskStatusRequest() {
+        try {
+            if (!isConnected()) {
+                TaskStatusResult result;
+                result.errorCode = ErrorCode_QueryStatus::NOT_CONNECTED;
+                return result;
+            }
 
-                auto* castedPtr = dynamic_cast<protocol::QueryStatusResponse*>(pendingReq.response.get());
-                if (castedPtr) {
-                    statusResp = std::unique_ptr<protocol::QueryStatusResponse>(castedPtr);
-                    pendingReq.response.release();  // 释放所有权但不删除对象
-                }
+            // 取得流水线窗口名额，窗口已满时等待，等待时间计入请求超时
+            const auto deadline = std::chrono::steady_clock::now() + options_.requestTimeout;
+            if (!request_window_.acquireUntil(deadline)) {
+                TaskStatusResult result;
+                result.errorCode = ErrorCode_QueryStatus::TIMEOUT;
+                return result;
             }
+            auto permit = makeScopeGuard([this]() {
+                request_window_.release();
+            });
+
+            // 创建请求消息
+            protocol::QueryStatusRequest request;
 
-            if (!statusResp) {
+            // 分配序列号并登记到待处理请求表
+            uint16_t seqNum = 0;
+            if (!pending_requests_.acquire(protocol::MessageType::QUERY_STATUS_RESP, seqNum)) {
                 TaskStatusResult result;
-                result.errorCode = ErrorCode_QueryStatus::INVALID_RESPONSE;
+                result.errorCode = ErrorCode_QueryStatus::UNKNOWN_ERROR;
                 return result;
             }
+            request.setSequenceNumber(seqNum);
 
-            // 转换为SDK的TaskStatusResult
-            TaskStatusResult result;
-            result.status = static_cast<Status_QueryStatus>(statusResp->status);
-            result.errorCode = static_cast<ErrorCode_QueryStatus>(statusResp->errorCode);
-            result.value = statusResp->value;
+            // 创建ScopeGuard，在函数结束时自动移除请求
+            auto guard = makeScopeGuard([this, seqNum]() {
+                pending_requests_.release(seqNum);
+            });
 
-            return result;
+            // 发送请求
+            network_model_->sendMessage(request);
+
+            // 等待响应
+            auto response = waitResponse(seqNum, protocol::MessageType::QUERY_STATUS_RESP, deadline);
+            return makeTaskStatusResult(response.get(), missingTaskStatusError());
 
         } catch (const std::exception& e) {
-            std::cerr << "request1007_NavTaskStatus 异常: " << e.what() << std::endl;
+            LOG_ERROR("request1007_NavTaskStatus 异常: " << e.what());
             TaskStatusResult result;
             result.errorCode = ErrorCode_QueryStatus::UNKNOWN_ERROR;
             return result;
         } catch (...) {
-            std::cerr << "request1007_NavTaskStatus 未知异常" << std::endl;
+            LOG_ERROR("request1007_NavTaskStatus 未知异常");
             TaskStatusResult result;
             result.errorCode = ErrorCode_QueryStatus::UNKNOWN_ERROR;
             return result;
         }
     }
 
-    // 实现网络回调接口
-    void onMessageReceived(std::unique_ptr<protocol::IMessage> message) override {
-        try {
-            if (!message) {
+    /**
+     * @brief 等待 1003 结果的导航任务
+     */
+    struct NavigationWaiter {
+        NavigationResultCallback callback;
+        uint64_t ticket = 0;                        // 登记编号，区分先后使用同一序列号的任务
+        common::TimerWheel::TimerId timer = 0;      // 超时定时任务，0 表示没有
+        std::chrono::steady_clock::time_point sentAt; // 下发时间，用于记录延迟
+    };
+
+    /**
+     * @brief 取出等待结果的导航任务并取消其超时定时任务
+     * @param seqNum 序列号
+     * @param ticket 登记编号，0 表示不检查
+     * @return 没有对应的任务时返回 false
+     */
+    bool takeNavigationWaiter(uint16_t seqNum, uint64_t ticket, NavigationWaiter& waiter) {
+        {
+            std::lock_guard<std::mutex> lock(navigation_result_callbacks_mutex_);
+            auto it = navigation_result_callbacks_.find(seqNum);
+            if (it == navigation_result_callbacks_.end() || (ticket != 0 && it->second.ticket != ticket)) {
+                return false;
+            }
+            waiter = std::move(it->second);
+            navigation_result_callbacks_.erase(it);
+        }
+
+        if (waiter.timer != 0) {
+            network_model_->cancelScheduled(waiter.timer);
+        }
+        return true;
+    }
+
+    /**
+     * @brief 一条分段下发的路线
+     */
+    struct RouteSession {
+        std::vector<protocol::NavigationPoint> points;
+        std::vector<std::pair<size_t, size_t>> chunks;  // 每段在 points 中的下标范围
+        RouteOptions options;
+        NavigationResultCallback callback;
+        RouteProgressCallback progress;
+
+        std::mutex mutex;
+        RouteProgress state;     // 受 mutex 保护
+        size_t cursor = 0;       // 1007 报告的当前目标点在 points 中的下标，受 mutex 保护
+        bool finished = false;   // 受 mutex 保护
+    };
+
+    /**
+     * @brief 启动路线时发生异常，以 UNKNOWN_ERROR 结束路线
+     * @param route 已创建的路线，可以为空
+     * @param callback 结果回调，尚未移入路线时在这里
+     */
+    void failRouteStart(const std::shared_ptr<RouteSession>& route, const NavigationResultCallback& callback) {
+        NavigationResult failResult;
+        failResult.errorCode = ErrorCode_Navigation::UNKNOWN_ERROR;
+        if (!route || !route->callback) {
+            safeCallback(callback, "导航结果", failResult);
+            return;
+        }
+
+        // 第一段可能已经有了结果，回调只调用一次
+        {
+            std::lock_guard<std::mutex> lock(route->mutex);
+            if (route->finished) {
                 return;
             }
+            route->finished = true;
+        }
+        safeCallback(route->callback, "导航结果", failResult);
+    }
 
-            uint16_t seqNum = message->getSequenceNumber();
-            protocol::MessageType msgType = message->getType();
+    /**
+     * @brief 下发路线的第 chunk 段，结果交给 onRouteChunkResult()
+     */
+    void sendRouteChunk(const std::shared_ptr<RouteSession>& route, size_t chunk) {
+        const auto range = route->chunks[chunk];
+        protocol::NavigationTaskRequest request;
+        request.points.assign(route->points.begin() + static_cast<std::ptrdiff_t>(range.first),
+                              route->points.begin() + static_cast<std::ptrdiff_t>(range.second));
+
+        startNavigationTask(std::move(request), [this, route, chunk](const NavigationResult& result) {
+            onRouteChunkResult(route, chunk, result);
+        });
+    }
 
-            if (msgType == protocol::MessageType::NAVIGATION_TASK_RESP) {
+    void onRouteChunkResult(const std::shared_ptr<RouteSession>& route, size_t chunk, const NavigationResult& result) {
+        bool finish = false;
+        bool sendNext = false;
+        size_t next = 0;
+        RouteProgress snapshot;
+        {
+            std::lock_guard<std::mutex> lock(route->mutex);
+            if (route->finished) {
+                return;
+            }
 
-                NavigationResultCallback callback;
-                // 检查是否有等待此响应的请求
-                {
-                    std::lock_guard<std::mutex> lock(navigation_result_callbacks_mutex_);
-                    auto it = navigation_result_callbacks_.find(seqNum);
-                    if (it != navigation_result_callbacks_.end()) {
-                        callback = it->second;
-                        navigation_result_callbacks_.erase(it);
-                    }
+            if (result.errorCode != ErrorCode_Navigation::SUCCESS) {
+                finish = true;
+            } else {
+                RouteProgress& state = route->state;
+                state.completedChunks = std::max(state.completedChunks, chunk + 1);
+                state.reachedPoints = std::max(state.reachedPoints, route->chunks[chunk].second);
+                route->cursor = std::max(route->cursor, route->chunks[chunk].second);
+                if (state.completedChunks == state.totalChunks) {
+                    finish = true;
+                } else if (state.sentChunks == state.completedChunks) {
+                    // 没有预取，当前段完成后才下发下一段
+                    next = state.sentChunks++;
+                    sendNext = true;
+                }
+            }
+            route->finished = finish;
+            snapshot = route->state;
+        }
+
+        if (sendNext) {
+            sendRouteChunk(route, next);
+        }
+        safeCallback(route->progress, "路线进度", snapshot);
+        if (finish) {
+            safeCallback(route->callback, "导航结果", result);
+        }
+    }
+
+    /**
+     * @brief 按 RouteOptions::progressInterval 以 1007 查询路线的执行进度，路线结束后停止
+     */
+    void scheduleRoutePoll(const std::shared_ptr<RouteSession>& route) {
+        if (route->options.progressInterval <= std::chrono::milliseconds::zero()) {
+            return;
+        }
+
+        network_model_->scheduleAfter(route->options.progressInterval, [this, route]() {
+            {
+                std::lock_guard<std::mutex> lock(route->mutex);
+                if (route->finished) {
+                    return;
                 }
+            }
+            request1007_NavTaskStatus([this, route](const TaskStatusResult& status) {
+                onRouteStatus(route, status);
+            }, std::chrono::milliseconds::zero());
+        });
+    }
 
-                // 如果有回调，则使用安全回调包装函数调用
-                if (callback) {
-                    auto* resp = dynamic_cast<protocol::NavigationTaskResponse*>(message.get());
-                    if (resp) {
-                        NavigationResult result;
-                        result.value = resp->value;
-                        result.errorCode = static_cast<ErrorCode_Navigation>(resp->errorCode);
-                        result.errorStatus = static_cast<ErrorStatus_Navigation>(resp->errorStatus);
-                        safeCallback(callback, "导航结果", result);
+    void onRouteStatus(const std::shared_ptr<RouteSession>& route, const TaskStatusResult& status) {
+        bool changed = false;
+        bool sendNext = false;
+        size_t next = 0;
+        RouteProgress snapshot;
+        {
+            std::lock_guard<std::mutex> lock(route->mutex);
+            if (route->finished) {
+                return;
+            }
+
+            RouteProgress& state = route->state;
+            if (status.errorCode == ErrorCode_QueryStatus::EXECUTING ||
+                status.status == Status_QueryStatus::EXECUTING) {
+                // 从上次的位置起在已下发的分段中查找当前目标点，路线中编号重复时取最近的一个
+                const size_t end = route->chunks[state.sentChunks - 1].second;
+                for (size_t i = route->cursor; i < end; ++i) {
+                    if (route->points[i].value == status.value) {
+                        changed = i != route->cursor || state.currentValue != status.value;
+                        route->cursor = i;
+                        state.reachedPoints = std::max(state.reachedPoints, i);
+                        state.currentValue = status.value;
+                        break;
                     }
                 }
 
-                return;
+                // 当前段即将完成时预先下发下一段
+                const size_t prefetch = route->options.prefetchPoints;
+                if (prefetch != 0 && state.sentChunks < state.totalChunks &&
+                    state.sentChunks == state.completedChunks + 1 &&
+                    route->chunks[state.completedChunks].second - route->cursor <= prefetch) {
+                    next = state.sentChunks++;
+                    sendNext = true;
+                    changed = true;
+                }
             }
+            snapshot = state;
+        }
+
+        if (sendNext) {
+            sendRouteChunk(route, next);
+        }
+        if (changed) {
+            safeCallback(route->progress, "路线进度", snapshot);
+        }
+        scheduleRoutePoll(route);
+    }
+
+    /**
+     * @brief 实时状态缓存中的一项
+     */
+    struct CachedRealTimeStatus {
+        RealTimeStatus status;
+        std::chrono::steady_clock::time_point updatedAt;
+    };
+
+    /**
+     * @brief 已连接且缓存不超过 SdkOptions::realTimeStatusMaxStaleness 时取出缓存
+     * @return 未启用缓存或缓存过旧时返回 false
+     */
+    bool freshCachedRealTimeStatus(RealTimeStatus& status) const {
+        if (options_.realTimeStatusMaxStaleness <= std::chrono::milliseconds::zero()) {
+            return false;
+        }
+
+        CachedRealTimeStatus cached;
+        if (!status_cache_.load(cached) ||
+            std::chrono::steady_clock::now() - cached.updatedAt > options_.realTimeStatusMaxStaleness) {
+            return false;
+        }
+        status = cached.status;
+        return true;
+    }
+
+    /**
+     * @brief 实时状态订阅
+     */
+    struct StatusSubscription {
+        uint32_t id = 0;
+        std::chrono::milliseconds interval{0};
+        RealTimeStatusCallback callback;
+        std::chrono::steady_clock::time_point nextTick;  // 下一个周期的开始时间，仅在IO线程中访问
+        std::atomic<bool> active{true};
+        std::recursive_mutex mutex;                      // 回调执行期间持有，取消订阅时等待回调结束
+    };
 
-            // 处理其他类型的响应消息
-            std::lock_guard<std::mutex> lock(pending_requests_mutex_);
-            auto it = pendingRequests_.find(seqNum);
-            if (it != pendingRequests_.end() && it->second.expectedResponseType == msgType) {
-                it->second.response = std::move(message);
-                it->second.responseReceived = true;
-                it->second.cv->notify_one();
+    /**
+     * @brief 订阅的一个周期（在IO线程中执行）：已连接时发出 1002 请求，然后调度下一个周期
+     * @note 按固定频率调度，单个周期的延迟不会累积；落后超过一个周期时跳过错过的周期
+     */
+    void pollSubscription(const std::shared_ptr<StatusSubscription>& subscription) {
+        if (!subscription->active) {
+            return;
+        }
+
+        if (isConnected()) {
+            auto onComplete = [this, subscription](std::unique_ptr<protocol::IMessage> response) {
+                const RealTimeStatus status = makeRealTimeStatus(response.get(), missingRealTimeStatusError());
+                std::lock_guard<std::recursive_mutex> lock(subscription->mutex);
+                if (subscription->active) {
+                    safeCallback(subscription->callback, "实时状态订阅", status);
+                }
+            };
+            if (!startAsyncRequest<protocol::GetRealTimeStatusRequest>(
+                    protocol::MessageType::GET_REAL_TIME_STATUS_RESP, options_.requestTimeout, std::move(onComplete))) {
+                LOG_WARN("实时状态订阅: 待处理请求过多，跳过本周期");
             }
-        } catch (const std::exception& e) {
-            std::cerr << "onMessageReceived 异常: " << e.what() << std::endl;
-        } catch (...) {
-            std::cerr << "onMessageReceived 未知异常" << std::endl;
         }
+
+        const auto now = std::chrono::steady_clock::now();
+        subscription->nextTick += subscription->interval;
+        if (subscription->nextTick <= now) {
+            const auto behind = (now - subscription->nextTick) / subscription->interval + 1;
+            subscription->nextTick += behind * subscription->interval;
+        }
+        network_model_->scheduleAfter(remainingUntil(subscription->nextTick), [this, subscription]() {
+            pollSubscription(subscription);
+        });
     }
 
-private:
+    /**
+     * @brief 同步等待响应：截止时间登记在IO线程的时间轮中，到期时由时间轮结束等待
+     * @param seqNum acquire() 分配的序列号
+     * @param responseType 期望的响应类型，用于记录延迟
+     * @param deadline 截止时间
+     * @return 响应消息，超时或断开连接时返回 nullptr
+     * @note 在IO线程中调用时时间轮无法推进，退化为带超时的等待
+     */
+    std::unique_ptr<protocol::IMessage> waitResponse(uint16_t seqNum, protocol::MessageType responseType,
+                                                     std::chrono::steady_clock::time_point deadline) {
+        const auto sentAt = std::chrono::steady_clock::now();
+        std::unique_ptr<protocol::IMessage> response;
+        if (network_model_->runningInIoThread()) {
+            response = pending_requests_.wait(seqNum, remainingUntil(deadline));
+            if (!response && isConnected()) {
+                timeouts_.fetch_add(1, std::memory_order_relaxed);
+            }
+        } else {
+            // 超时计数由等待方记录，返回前计数已经可见
+            auto expired = std::make_shared<std::atomic<bool>>(false);
+            const auto timer = network_model_->scheduleAfter(remainingUntil(deadline), [this, seqNum, expired]() {
+                expired->store(true);
+                pending_requests_.expire(seqNum);
+            });
+            response = pending_requests_.wait(seqNum);
+            network_model_->cancelScheduled(timer);
+            if (!response && expired->load()) {
+                timeouts_.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
 
-    void addPendingRequest(uint16_t sequenceNumber, protocol::MessageType expectedType) {
-        std::lock_guard<std::mutex> lock(pending_requests_mutex_);
-        PendingRequest req;
-        req.expectedResponseType = expectedType;
-        req.responseReceived = false;
-        req.cv = std::make_shared<std::condition_variable>();
-        pendingRequests_.emplace(sequenceNumber, std::move(req));
+        if (response) {
+            recordLatency(responseType, sentAt);
+        }
+        return response;
     }
 
-    void removePendingRequest(uint16_t sequenceNumber) {
-        std::lock_guard<std::mutex> lock(pending_requests_mutex_);
-        pendingRequests_.erase(sequenceNumber);
+    /**
+     * @brief 记录一个请求从发出到收到响应的延迟
+     */
+    void recordLatency(protocol::MessageType responseType, std::chrono::steady_clock::time_point sentAt) {
+        const auto latency = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - sentAt);
+        switch (responseType) {
+            case protocol::MessageType::GET_REAL_TIME_STATUS_RESP: latency_1002_.record(latency); break;
+            case protocol::MessageType::NAVIGATION_TASK_RESP: latency_1003_.record(latency); break;
+            case protocol::MessageType::CANCEL_TASK_RESP: latency_1004_.record(latency); break;
+            case protocol::MessageType::QUERY_STATUS_RESP: latency_1007_.record(latency); break;
+            default: break;
+        }
     }
 
-    // 获取当前时间戳
-    std::string getCurrentTimestamp() const {
-        auto now = std::chrono::system_clock::now();
-        auto time_t_now = std::chrono::system_clock::to_time_t(now);
-        std::stringstream ss;
-        ss << std::put_time(std::localtime(&time_t_now), "%Y-%m-%d %H:%M:%S");
-        return ss.str();
+    static LatencySnapshot latencySnapshotOf(const common::LatencyHistogram& histogram) {
+        LatencySnapshot snapshot;
+        snapshot.count = histogram.count();
+        snapshot.sum = std::chrono::microseconds(histogram.sum());
+        snapshot.max = std::chrono::microseconds(histogram.max());
+        for (const auto& bucket : histogram.buckets()) {
+            snapshot.buckets.emplace_back(std::chrono::microseconds(bucket.first), bucket.second);
+        }
+        return snapshot;
+    }
+
+    /**
+     * @brief 为新建立的连接启动心跳（SdkOptions::heartbeatInterval 为 0 时不启动）
+     * @note 每次启动递增心跳代数，断开连接时同样递增，上一次连接的心跳定时任务和探测结果随之失效
+     */
+    void startHeartbeat() {
+        const uint64_t epoch = ++heartbeat_epoch_;
+        missed_heartbeats_ = 0;
+        last_receive_time_ = std::chrono::steady_clock::now().time_since_epoch().count();
+        if (options_.heartbeatInterval <= std::chrono::milliseconds::zero()) {
+            return;
+        }
+
+        network_model_->scheduleAfter(options_.heartbeatInterval, [this, epoch]() {
+            heartbeatTick(epoch);
+        });
+    }
+
+    /**
+     * @brief 心跳的一个周期（在IO线程中执行）
+     *
+     * 一个周期内收到过任何消息时不发探测；否则发出一个以心跳周期为超时的 1002 探测，记录往返时间。
+     * 连续 heartbeatMissLimit 次探测未应答时断开连接（开启自动重连时随即重连），
+     * 因此失效的连接最迟约 (heartbeatMissLimit + 1) 个心跳周期后被发现。
+     */
+    void heartbeatTick(uint64_t epoch) {
+        if (epoch != heartbeat_epoch_ || !isConnected()) {
+            return;
+        }
+
+        const auto now = std::chrono::steady_clock::now();
+        const auto lastReceive = std::chrono::steady_clock::time_point(
+            std::chrono::steady_clock::duration(last_receive_time_.load()));
+        if (now - lastReceive < options_.heartbeatInterval) {
+            missed_heartbeats_ = 0;
+        } else {
+            auto onComplete = [this, epoch, sentAt = now](std::unique_ptr<protocol::IMessage> response) {
+                if (epoch != heartbeat_epoch_) {
+                    return;
+                }
+                if (response) {
+                    recordHeartbeatRtt(std::chrono::duration_cast<std::chrono::microseconds>(
+                        std::chrono::steady_clock::now() - sentAt));
+                    missed_heartbeats_ = 0;
+                } else if (++missed_heartbeats_ >= options_.heartbeatMissLimit && isConnected()) {
+                    LOG_WARN("连续 " << missed_heartbeats_.load() << " 次心跳未应答，断开连接");
+                    network_model_->dropConnection();
+                }
+            };
+            startAsyncRequest<protocol::GetRealTimeStatusRequest>(
+                protocol::MessageType::GET_REAL_TIME_STATUS_RESP, options_.heartbeatInterval, std::move(onComplete));
+        }
+
+        network_model_->scheduleAfter(options_.heartbeatInterval, [this, epoch]() {
+            heartbeatTick(epoch);
+        });
+    }
+
+    /**
+     * @brief 记录一个心跳往返时间样本，平滑值按 RFC 6298 的 SRTT 方式更新（仅在IO线程中调用）
+     */
+    void recordHeartbeatRtt(std::chrono::microseconds rtt) {
+        last_rtt_us_ = rtt.count();
+        const int64_t smoothed = smoothed_rtt_us_.load();
+        smoothed_rtt_us_ = smoothed == 0 ? rtt.count() : smoothed + (rtt.count() - smoothed) / 8;
+    }
+
+    /**
+     * @brief 断线后可以在重连后重发的请求（按期望的响应类型）：只有幂等的 1002/1007 查询
+     */
+    static bool isReplayable(protocol::MessageType responseType) {
+        return responseType == protocol::MessageType::GET_REAL_TIME_STATUS_RESP ||
+               responseType == protocol::MessageType::QUERY_STATUS_RESP;
+    }
+
+    /**
+     * @brief 等待一段带抖动的退避时间后重连（在IO线程中调用）
+     * @note 实际等待时间在 [delay/2, delay] 内均匀分布，避免大量机器狗在网络恢复时同时重连
+     */
+    void scheduleReconnect() {
+        const auto delay = reconnect_delay_.count();
+        std::uniform_int_distribution<std::chrono::milliseconds::rep> jitter(delay / 2, delay);
+        network_model_->scheduleAfter(std::chrono::milliseconds(jitter(reconnect_rng_)), [this]() {
+            attemptReconnect();
+        });
+    }
+
+    /**
+     * @brief 一次重连尝试（在IO线程中调用），失败时退避时间翻倍后再次尝试
+     */
+    void attemptReconnect() {
+        if (!session_active_) {
+            return;
+        }
+
+        network_model_->reconnect([this](bool connected) {
+            if (!session_active_) {
+                // 会话已由 disconnect() 结束，socket 也已由其关闭
+                return;
+            }
+
+            if (connected) {
+                reconnects_.fetch_add(1, std::memory_order_relaxed);
+                reconnect_delay_ = options_.reconnectInitialDelay;
+                replayInFlightRequests();
+                startHeartbeat();
+                return;
+            }
+
+            reconnect_delay_ = std::min(reconnect_delay_ * 2, options_.reconnectMaxDelay);
+            scheduleReconnect();
+        });
+    }
+
+    /**
+     * @brief 重发断线时在途的 1002/1007 请求，沿用原序列号，响应照常交给原来的等待方
+     */
+    void replayInFlightRequests() {
+        pending_requests_.forEachWaiting([this](uint16_t seqNum, protocol::MessageType responseType) {
+            if (responseType == protocol::MessageType::GET_REAL_TIME_STATUS_RESP) {
+                protocol::GetRealTimeStatusRequest request;
+                request.setSequenceNumber(seqNum);
+                network_model_->sendMessage(request);
+            } else if (responseType == protocol::MessageType::QUERY_STATUS_RESP) {
+                protocol::QueryStatusRequest request;
+                request.setSequenceNumber(seqNum);
+                network_model_->sendMessage(request);
+            }
+        });
+    }
+
+    /**
+     * @brief 距截止时间的剩余时间，向上取整到毫秒，已过期时为 0
+     */
+    static std::chrono::milliseconds remainingUntil(std::chrono::steady_clock::time_point deadline) {
+        const auto remaining = deadline - std::chrono::steady_clock::now();
+        if (remaining <= std::chrono::steady_clock::duration::zero()) {
+            return std::chrono::milliseconds::zero();
+        }
+        return std::chrono::duration_cast<std::chrono::milliseconds>(remaining + std::chrono::milliseconds(1) -
+                                                                     std::chrono::steady_clock::duration(1));
+    }
+
+    /**
+     * @brief 没有收到响应时的错误码：连接已断开为 NOT_CONNECTED，否则为 TIMEOUT
+     */
+    ErrorCode_RealTimeStatus missingRealTimeStatusError() const {
+        return isConnected() ? ErrorCode_RealTimeStatus::TIMEOUT : ErrorCode_RealTimeStatus::NOT_CONNECTED;
+    }
+
+    ErrorCode_QueryStatus missingTaskStatusError() const {
+        return isConnected() ? ErrorCode_QueryStatus::TIMEOUT : ErrorCode_QueryStatus::NOT_CONNECTED;
     }
 
     SdkOptions options_;
     std::unique_ptr<network::AsioNetworkModel> network_model_;
 
-    // 生成序列号， 从0到65535后溢出回到0
-    uint16_t generateSequenceNumber() {
-        static std::atomic<uint16_t> sequenceNumber = 0;
-        return ++sequenceNumber;
-    }
+    // 1002/1004/1007 的流水线窗口，限制同时在途的请求数
+    common::InFlightWindow request_window_;
 
-    struct PendingRequest {
-        protocol::MessageType expectedResponseType{};
-        std::unique_ptr<protocol::IMessage> response{};
-        bool responseReceived{false};
-        std::shared_ptr<std::condition_variable> cv;
-    };
+    // 待处理的同步与异步请求，按序列号索引，无全局锁
+    common::PendingRequestTable pending_requests_;
+
+    // 1002/1007 的请求合并，同一时刻每种查询最多一个请求在途
+    common::SingleFlight<RealTimeStatus> status_flight_;
+    common::SingleFlight<TaskStatusResult> task_status_flight_;
 
-    std::mutex pending_requests_mutex_;  // 保护 pendingRequests_ 的互斥锁
-    std::map<uint16_t, PendingRequest> pendingRequests_;
+    // 最近一次成功的 1002 结果，IO线程写入，任意线程无锁读取
+    common::Seqlock<CachedRealTimeStatus> status_cache_;
 
-    // TODO: 没有超时清理
+    // 实时状态订阅，按订阅ID索引
+    std::mutex subscriptions_mutex_;
+    std::map<uint32_t, std::shared_ptr<StatusSubscription>> subscriptions_;
+    uint32_t next_subscription_id_ = 0;
+
+    // 等待 1003 结果的导航任务，按序列号索引；超过 SdkOptions::navigationTimeout 的任务由时间轮清理
     std::mutex navigation_result_callbacks_mutex_;
-    std::map<uint16_t, NavigationResultCallback> navigation_result_callbacks_;
+    std::map<uint16_t, NavigationWaiter> navigation_result_callbacks_;
+    uint64_t next_navigation_ticket_ = 0;
+
+    // 托管会话（SdkOptions::autoReconnect）：connect() 成功后到 disconnect() 之前，被动断开时自动重连
+    std::atomic<bool> session_active_{false};
+    std::chrono::milliseconds reconnect_delay_{0};          // 当前退避时间，仅在IO线程中访问
+    std::mt19937 reconnect_rng_{std::random_device{}()};   // 退避抖动，仅在IO线程中访问
+
+    // 心跳（SdkOptions::heartbeatInterval）：每次建立连接递增代数，旧连接的心跳随之停止
+    std::atomic<uint64_t> heartbeat_epoch_{0};
+    std::atomic<std::chrono::steady_clock::rep> last_receive_time_{0};  // 最近一次收到消息的时间
+    std::atomic<uint32_t> missed_heartbeats_{0};
+    std::atomic<int64_t> last_rtt_us_{0};
+    std::atomic<int64_t> smoothed_rtt_us_{0};
+
+    // 指标：每种请求的延迟分布和事件计数，记录无锁；收发计数由网络层维护
+    common::LatencyHistogram latency_1002_;
+    common::LatencyHistogram latency_1003_;
+    common::LatencyHistogram latency_1004_;
+    common::LatencyHistogram latency_1007_;
+    std::atomic<uint64_t> timeouts_{0};
+    std::atomic<uint64_t> reconnects_{0};
 };
 
 // RobotServerSdk类的实现
@@ -565,19 +1560,74 @@ RealTimeStatus RobotServerSdk::request1002_RunTimeStatus() {
     return impl_->request1002_RunTimeStatus();
 }
 
+void RobotServerSdk::request1002_RunTimeStatus(RealTimeStatusCallback callback, std::chrono::milliseconds timeout) {
+    impl_->request1002_RunTimeStatus(std::move(callback), timeout);
+}
+
+std::future<RealTimeStatus> RobotServerSdk::request1002_RunTimeStatusAsync(std::chrono::milliseconds timeout) {
+    return makeFuture<RealTimeStatus>([this, timeout](RealTimeStatusCallback callback) {
+        impl_->request1002_RunTimeStatus(std::move(callback), timeout);
+    });
+}
+
 // 添加基于回调的异步方法实现
+bool RobotServerSdk::latestRealTimeStatus(RealTimeStatus& status, std::chrono::steady_clock::time_point& updatedAt) const {
+    return impl_->latestRealTimeStatus(status, updatedAt);
+}
+
+MetricsSnapshot RobotServerSdk::metrics() const {
+    return impl_->metrics();
+}
+
+ConnectionHealth RobotServerSdk::connectionHealth() const {
+    return impl_->connectionHealth();
+}
+
+uint32_t RobotServerSdk::subscribeRealTimeStatus(std::chrono::milliseconds interval, RealTimeStatusCallback callback) {
+    return impl_->subscribeRealTimeStatus(interval, std::move(callback));
+}
+
+void RobotServerSdk::unsubscribeRealTimeStatus(uint32_t subscriptionId) {
+    impl_->unsubscribeRealTimeStatus(subscriptionId);
+}
+
 void RobotServerSdk::request1003_StartNavTask(const std::vector<NavigationPoint>& points, NavigationResultCallback callback) {
     impl_->request1003_StartNavTask(points, std::move(callback));
 }
 
+void RobotServerSdk::request1003_StartNavRoute(const std::vector<NavigationPoint>& points, NavigationResultCallback callback,
+                                               RouteProgressCallback progress, const RouteOptions& options) {
+    impl_->request1003_StartNavRoute(points, std::move(callback), std::move(progress), options);
+}
+
 bool RobotServerSdk::request1004_CancelNavTask() {
     return impl_->request1004_CancelNavTask();
 }
 
+void RobotServerSdk::request1004_CancelNavTask(CancelTaskCallback callback, std::chrono::milliseconds timeout) {
+    impl_->request1004_CancelNavTask(std::move(callback), timeout);
+}
+
+std::future<bool> RobotServerSdk::request1004_CancelNavTaskAsync(std::chrono::milliseconds timeout) {
+    return makeFuture<bool>([this, timeout](CancelTaskCallback callback) {
+        impl_->request1004_CancelNavTask(std::move(callback), timeout);
+    });
+}
+
 TaskStatusResult RobotServerSdk::request1007_NavTaskStatus() {
     return impl_->request1007_NavTaskStatus();
 }
 
+void RobotServerSdk::request1007_NavTaskStatus(TaskStatusCallback callback, std::chrono::milliseconds timeout) {
+    impl_->request1007_NavTaskStatus(std::move(callback), timeout);
+}
+
+std::future<TaskStatusResult> RobotServerSdk::request1007_NavTaskStatusAsync(std::chrono::milliseconds timeout) {
+    return makeFuture<TaskStatusResult>([this, timeout](TaskStatusCallback callback) {
+        impl_->request1007_NavTaskStatus(std::move(callback), timeout);
+    });
+}
+
 std::string RobotServerSdk::getVersion() {
     return SDK_VERSION;
 }
@@ -1,135 +1,268 @@
 #include "asio_network_model.hpp"
+#include "common/logging.hpp"
 #include "protocol/serializer.hpp"
-#include <iostream>
 #include <chrono>
-#include <sstream>
-#include <iomanip>
+#include <future>
 
 namespace network {
 
-AsioNetworkModel::AsioNetworkModel(INetworkCallback& callback)
-    : socket_(io_context_),
-      strand_(io_context_),
+AsioNetworkModel::AsioNetworkModel(INetworkCallback& callback, std::shared_ptr<IoService> ioService)
+    : io_service_(ioService ? std::move(ioService) : std::make_shared<IoService>(1)),
+      socket_(io_service_->context()),
+      strand_(io_service_->context()),
       connected_(false),
-      callback_(callback) {
+      callback_(callback),
+      timer_wheel_(TIMER_TICK),
+      wheel_timer_(io_service_->context()),
+      life_token_(std::make_shared<char>()) {
 }
 
 AsioNetworkModel::~AsioNetworkModel() {
     disconnect();
+
+    // 共享 io_context 中可能还留有本连接的处理函数（已取消的读写、未到期的定时任务），
+    // 在 strand 上使令牌失效后它们都不再访问本对象
+    runOnStrand([this]() {
+        life_token_.reset();
+    });
 }
 
 void AsioNetworkModel::setConnectionTimeout(std::chrono::milliseconds timeout) {
     connection_timeout_ = timeout;
 }
 
+void AsioNetworkModel::setKeepAlive(bool enabled) {
+    keep_alive_ = enabled;
+}
+
+void AsioNetworkModel::dropConnection() {
+    boost::asio::post(guarded([this]() {
+        closeOnError();
+    }));
+}
+
+common::TimerWheel::TimerId AsioNetworkModel::scheduleAfter(std::chrono::milliseconds delay, std::function<void()> task) {
+    const auto id = timer_wheel_.schedule(common::TimerWheel::Clock::now() + delay, std::move(task));
+
+    // 时间轮空闲时驱动定时器已停止，登记第一个任务时重新启动
+    if (!wheel_armed_.exchange(true)) {
+        boost::asio::post(guarded([this]() {
+            armTimerWheel();
+        }));
+    }
+    return id;
+}
+
+bool AsioNetworkModel::cancelScheduled(common::TimerWheel::TimerId id) {
+    return timer_wheel_.cancel(id);
+}
+
+void AsioNetworkModel::armTimerWheel() {
+    wheel_timer_.expires_after(timer_wheel_.tick());
+    wheel_timer_.async_wait(guarded([this](const boost::system::error_code& error) {
+        onTimerWheelTick(error);
+    }));
+}
+
+void AsioNetworkModel::onTimerWheelTick(const boost::system::error_code& error) {
+    if (error) {
+        wheel_armed_ = false;
+        return;
+    }
+
+    // 到期任务在 strand 上成批执行
+    timer_wheel_.advance(common::TimerWheel::Clock::now());
+
+    if (timer_wheel_.size() > 0) {
+        armTimerWheel();
+        return;
+    }
+
+    // 没有定时任务时停止驱动；与此同时登记的任务会看到 wheel_armed_ 为 false 并重新启动
+    wheel_armed_ = false;
+    if (timer_wheel_.size() > 0 && !wheel_armed_.exchange(true)) {
+        armTimerWheel();
+    }
+}
+
+bool AsioNetworkModel::runningInIoThread() const {
+    return io_service_->context().get_executor().running_in_this_thread();
+}
+
+void AsioNetworkModel::runOnStrand(const std::function<void()>& task) {
+    if (strand_.running_in_this_thread()) {
+        task();
+        return;
+    }
+
+    std::promise<void> done;
+    auto finished = done.get_future();
+    boost::asio::post(strand_, [&task, &done]() {
+        task();
+        done.set_value();
+    });
+    finished.wait();
+}
+
 bool AsioNetworkModel::connect(const std::string& host, uint16_t port) {
     // 如果已经连接，直接返回成功
     if (connected_) {
         return true;
     }
 
-    try {
-        // 重置io_context，确保它处于干净状态
-        io_context_.restart();
+    // 连接在本连接的 strand 上完成，在 strand 上等待会死锁
+    if (strand_.running_in_this_thread()) {
+        LOG_ERROR("连接失败: 不能在IO线程中调用 connect()");
+        return false;
+    }
 
+    try {
         // 解析主机地址
-        boost::asio::ip::tcp::resolver resolver(io_context_);
+        boost::asio::ip::tcp::resolver resolver(io_service_->context());
         auto endpoints = resolver.resolve(host, std::to_string(port));
 
-        // 设置连接超时
-        socket_.close(); // 确保套接字是关闭的
-        socket_ = boost::asio::ip::tcp::socket(io_context_); // 重新创建套接字
-
-        // 使用async_connect启动异步连接
-        boost::system::error_code connect_ec;
-        bool connect_completed = false;
-
-        // 开始异步连接
-        boost::asio::async_connect(socket_, endpoints,
-            [&connect_ec, &connect_completed](const boost::system::error_code& ec, const boost::asio::ip::tcp::endpoint&) {
-                connect_ec = ec;
-                connect_completed = true;
+        // 在 strand 上发起连接，超时由定时器保证，调用方只需等待结果
+        auto result = std::make_shared<std::promise<boost::system::error_code>>();
+        auto connected = result->get_future();
+        boost::asio::post(guarded([this, endpoints, result]() {
+            endpoints_ = endpoints;
+            startConnect(endpoints, [this, result](const boost::system::error_code& ec) {
+                if (!ec) {
+                    startSession();
+                } else {
+                    closeSocket();
+                }
+                result->set_value(ec);
             });
+        }));
 
-        // 运行io_context，但设置超时
-        // 这里使用run_one_for，它会运行一个操作或等待指定的时间
-        // 如果连接在超时前完成，它会立即返回
-        if (!io_context_.run_one_for(connection_timeout_)) {
-            // 超时，取消所有操作
-            socket_.cancel();
-            socket_.close();
-            std::cerr << "连接超时" << std::endl;
+        const boost::system::error_code connect_ec = connected.get();
+        if (connect_ec == boost::asio::error::timed_out) {
+            LOG_ERROR("连接超时");
             return false;
         }
-
-        // 检查连接是否成功
-        if (connect_ec || !connect_completed) {
-            std::cerr << "连接失败: " << connect_ec.message() << std::endl;
-            socket_.close();
+        if (connect_ec) {
+            LOG_ERROR("连接失败: " << connect_ec.message());
             return false;
         }
 
-        // 连接成功
-        connected_ = true;
-
-        // 确保之前的IO线程已经结束
-        if (io_thread_.joinable()) {
-            io_thread_.join();
-        }
-
-        // 启动IO线程
-        io_thread_ = std::thread(&AsioNetworkModel::ioThreadFunc, this);
-
-        // 启动接收
-        startReceive();
-
         return true;
     } catch (const std::exception& e) {
-        std::cerr << "连接异常: " << e.what() << std::endl;
+        LOG_ERROR("连接异常: " << e.what());
         return false;
     } catch (...) {
-        std::cerr << "连接异常: 未知异常" << std::endl;
+        LOG_ERROR("连接异常: 未知异常");
         return false;
     }
 }
 
-void AsioNetworkModel::disconnect() {
-    if (!connected_ && !socket_.is_open()) {
-        return;
-    }
+void AsioNetworkModel::startConnect(const boost::asio::ip::tcp::resolver::results_type& endpoints,
+                                    std::function<void(const boost::system::error_code&)> handler) {
+    struct Attempt {
+        bool done = false;
+        bool timedOut = false;
+    };
+    auto attempt = std::make_shared<Attempt>();
+
+    // 丢弃上一次连接的 socket，重新创建
+    closeSocket();
+    socket_ = boost::asio::ip::tcp::socket(io_service_->context());
+
+    // 超时后关闭 socket，async_connect 随即以 operation_aborted 结束；超时由时间轮管理
+    const auto timer = scheduleAfter(connection_timeout_, [this, attempt]() {
+        if (!attempt->done) {
+            attempt->timedOut = true;
+            boost::system::error_code ignored;
+            socket_.close(ignored);
+        }
+    });
+
+    boost::asio::async_connect(socket_, endpoints,
+        guarded([this, attempt, timer, handler = std::move(handler)](const boost::system::error_code& ec,
+                                                                     const boost::asio::ip::tcp::endpoint&) {
+            attempt->done = true;
+            cancelScheduled(timer);
+            handler(attempt->timedOut ? boost::system::error_code(boost::asio::error::timed_out) : ec);
+        }));
+}
 
-    try {
-        // 取消所有异步操作
-        boost::system::error_code ec;
-        socket_.cancel(ec);
-
-        // 使用 strand 确保安全关闭
-        boost::asio::post(strand_, [this]() {
-            // 关闭socket
-            boost::system::error_code error;
-            socket_.close(error);
-
-            if (error) {
-                std::cerr << "关闭socket错误: " << error.message() << std::endl;
+void AsioNetworkModel::reconnect(std::function<void(bool)> handler) {
+    boost::asio::post(guarded([this, handler = std::move(handler)]() mutable {
+        if (connected_) {
+            handler(true);
+            return;
+        }
+        if (endpoints_.empty()) {
+            handler(false);
+            return;
+        }
+
+        startConnect(endpoints_, [this, handler = std::move(handler)](const boost::system::error_code& ec) {
+            // 连接完成后、处理函数执行前 socket 可能已被 disconnect() 关闭
+            if (!ec && socket_.is_open()) {
+                startSession();
+                handler(true);
+            } else {
+                closeSocket();
+                handler(false);
             }
         });
+    }));
+}
 
-        // 停止IO上下文
-        io_context_.stop();
+void AsioNetworkModel::startSession() {
+    // 丢弃上一次连接残留的未完成帧和未发出的帧
+    frame_decoder_.reset();
+    resetSendQueue();
+    ++generation_;
+    connected_ = true;
 
-        // 等待IO线程结束
-        if (io_thread_.joinable()) {
-            io_thread_.join();
-        }
+    if (keep_alive_) {
+        boost::system::error_code ignored;
+        socket_.set_option(boost::asio::socket_base::keep_alive(true), ignored);
+    }
+
+    startReceive();
+}
 
-        connected_ = false;
+void AsioNetworkModel::disconnect() {
+    connected_ = false;
+
+    try {
+        // socket 只在 strand 上访问；在回调中调用时直接关闭。
+        // 在 strand 上再次清除连接状态，覆盖此前已排队完成的重连
+        runOnStrand([this]() {
+            connected_ = false;
+            closeSocket();
+        });
     } catch (const std::exception& e) {
-        std::cerr << "断开连接异常: " << e.what() << std::endl;
+        LOG_ERROR("断开连接异常: " << e.what());
+    }
+}
+
+void AsioNetworkModel::closeSocket() {
+    if (socket_.is_open()) {
+        // 未完成的读写随即以 operation_aborted 结束
+        boost::system::error_code error;
+        socket_.close(error);
+        if (error) {
+            LOG_ERROR("关闭socket错误: " << error.message());
+        }
+    }
+
+    resetSendQueue();
+}
+
+void AsioNetworkModel::closeOnError() {
+    // 主动断开或另一方向的错误已经处理过本次连接
+    if (connected_.exchange(false)) {
+        closeSocket();
+        callback_.onDisconnected();
     }
 }
 
 bool AsioNetworkModel::isConnected() const {
-    return connected_ && socket_.is_open();
+    return connected_;
 }
 
 bool AsioNetworkModel::sendMessage(const protocol::IMessage& message) {
@@ -138,47 +271,88 @@ bool AsioNetworkModel::sendMessage(const protocol::IMessage& message) {
     }
 
     try {
-        // 序列化消息
+        // 序列化消息，协议头和消息体一次写入同一块缓冲区；缓冲区取自池，写完成后归还
         protocol::Serializer serializer;
-        std::string data = serializer.serializeMessage(message);
+        std::string data = buffer_pool_.acquire();
+        if (!serializer.serializeMessage(message, data)) {
+            return false;
+        }
 
-        // 使用 strand 包装异步写入操作，确保线程安全
-        boost::asio::post(strand_, [this, data = std::move(data)]() {
-            if (!isConnected()) {
-                return;
+        {
+            std::lock_guard<std::mutex> lock(send_mutex_);
+            send_queue_.push_back(std::move(data));
+            traffic_.framesSent.fetch_add(1, std::memory_order_relaxed);
+            if (write_in_progress_) {
+                // 在途的写操作完成后会连同本帧一起发出
+                return true;
             }
+            write_in_progress_ = true;
+        }
 
-            boost::asio::async_write(
-                socket_,
-                boost::asio::buffer(data),
-                boost::asio::bind_executor(strand_,
-                    [this](const boost::system::error_code& error, std::size_t bytes_transferred) {
-                        send(error, bytes_transferred);
-                    }
-                )
-            );
-        });
+        // 使用 strand 发起写操作，确保同一时刻只有一个 async_write 在途
+        boost::asio::post(guarded([this]() {
+            startWrite();
+        }));
 
         return true;
     } catch (const std::exception& e) {
-        std::cerr << "发送消息异常: " << e.what() << std::endl;
+        LOG_ERROR("发送消息异常: " << e.what());
         return false;
     }
 }
 
+void AsioNetworkModel::startWrite() {
+    // 重连前投递的 startWrite() 可能与新连接的重复，写操作在途时由其完成回调继续发送
+    if (!writing_.empty()) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(send_mutex_);
+        if (send_queue_.empty() || !isConnected()) {
+            write_in_progress_ = false;
+            return;
+        }
+
+        // 取走队列中的全部帧；交换后 send_queue_ 复用上一批的 vector 容量
+        writing_.swap(send_queue_);
+    }
+
+    write_buffers_.clear();
+    for (const auto& frame : writing_) {
+        write_buffers_.push_back(boost::asio::buffer(frame));
+    }
+
+    boost::asio::async_write(
+        socket_,
+        write_buffers_,
+        guarded([this, generation = generation_](const boost::system::error_code& error, std::size_t bytes_transferred) {
+            send(generation, error, bytes_transferred);
+        })
+    );
+}
+
+void AsioNetworkModel::resetSendQueue() {
+    std::lock_guard<std::mutex> lock(send_mutex_);
+    send_queue_.clear();
+    write_in_progress_ = false;
+    writing_.clear();
+    write_buffers_.clear();
+}
+
 void AsioNetworkModel::startReceive() {
     if (!isConnected()) {
         return;
     }
 
-    // 使用 strand 包装异步读取操作，确保线程安全
+    // 处理函数在 strand 上执行，确保线程安全
+    // 直接读入分帧器的缓冲区，避免中间拷贝；读操作的状态放在 receive_memory_ 中，稳定接收时不分配内存
     socket_.async_read_some(
-        boost::asio::buffer(receive_buffer_),
-        boost::asio::bind_executor(strand_,
-            [this](const boost::system::error_code& error, std::size_t bytes_transferred) {
-                receive(error, bytes_transferred);
-            }
-        )
+        boost::asio::buffer(frame_decoder_.prepare(RECEIVE_CHUNK_SIZE), RECEIVE_CHUNK_SIZE),
+        bindHandlerMemory(receive_memory_,
+            guarded([this, generation = generation_](const boost::system::error_code& error, std::size_t bytes_transferred) {
+                receive(generation, error, bytes_transferred);
+            }))
     );
 }
 
@@ -187,93 +361,83 @@ void AsioNetworkModel::startReceive() {
  * @tparam Callback 回调函数类型
  * @tparam Args 回调函数参数类型
  * @param callback 回调函数
- * @param callbackType 回调函数类型描述，用于日志记录
+ * @param callbackType 回调函数类型描述，用于日志记录；字面量不构造 std::string，热点路径上不分配内存
  * @param args 回调函数参数
  */
 template<typename Callback, typename... Args>
-void safeCallback(const Callback& callback, const std::string& callbackType, Args&&... args) {
+void safeCallback(const Callback& callback, const char* callbackType, Args&&... args) {
     try {
         callback(std::forward<Args>(args)...);
     } catch (const std::exception& e) {
-        auto now = std::chrono::system_clock::now();
-        auto time_t_now = std::chrono::system_clock::to_time_t(now);
-        std::stringstream ss;
-        ss << std::put_time(std::localtime(&time_t_now), "%Y-%m-%d %H:%M:%S");
-
-        std::cerr << "[" << ss.str() << "] " << callbackType << " 回调函数异常: " << e.what() << std::endl;
+        LOG_ERROR(callbackType << " 回调函数异常: " << e.what());
     } catch (...) {
-        auto now = std::chrono::system_clock::now();
-        auto time_t_now = std::chrono::system_clock::to_time_t(now);
-        std::stringstream ss;
-        ss << std::put_time(std::localtime(&time_t_now), "%Y-%m-%d %H:%M:%S");
-
-        std::cerr << "[" << ss.str() << "] " << callbackType << " 回调函数发生未知异常" << std::endl;
+        LOG_ERROR(callbackType << " 回调函数发生未知异常");
     }
 }
 
-void AsioNetworkModel::receive(const boost::system::error_code& error, std::size_t bytes_transferred) {
+void AsioNetworkModel::receive(uint64_t generation, const boost::system::error_code& error, std::size_t bytes_transferred) {
+    // 上一次连接遗留的读完成回调
+    if (generation != generation_) {
+        return;
+    }
+
     if (error) {
         if (error != boost::asio::error::operation_aborted) {
-            std::cerr << "接收数据错误: " << error.message() << std::endl;
-            disconnect();
+            LOG_ERROR("接收数据错误: " << error.message());
+            closeOnError();
         }
         return;
     }
 
-    // 将接收到的数据追加到缓冲区
-    receive_data_.append(receive_buffer_.data(), bytes_transferred);
+    // 确认读入分帧器的数据，一次读取可能包含多个帧或半个帧
+    frame_decoder_.commit(bytes_transferred);
+    traffic_.bytesReceived.fetch_add(bytes_transferred, std::memory_order_relaxed);
 
-    // 尝试解析消息
+    // 依次在缓冲区上原地解析所有完整的帧
     protocol::Serializer serializer;
-    auto message = serializer.deserializeMessage(receive_data_);
-    if (message) {
-        // 清空接收缓冲区
-        receive_data_.clear();
-
-        // 使用 strand 确保回调在同一线程上下文中执行
-        boost::asio::post(strand_, [this, msg = std::move(message)]() mutable {
-            safeCallback(
-                [this](std::unique_ptr<protocol::IMessage>& msg) {
-                    callback_.onMessageReceived(std::move(msg));
-                },
-                "网络消息接收",
-                msg
-            );
-        });
+    protocol::Frame frame;
+    while (frame_decoder_.next(frame)) {
+        auto message = serializer.deserializeFrame(frame);
+        if (!message) {
+            traffic_.decodeFailures.fetch_add(1, std::memory_order_relaxed);
+            continue;
+        }
+        traffic_.framesDecoded.fetch_add(1, std::memory_order_relaxed);
+
+        // receive() 已在 strand 上执行，直接分发；逐帧 post 会在一次读取含多帧时耗尽 Asio 的处理函数内存缓存
+        safeCallback(
+            [this](std::unique_ptr<protocol::IMessage>& msg) {
+                callback_.onMessageReceived(std::move(msg));
+            },
+            "网络消息接收",
+            message
+        );
     }
 
     // 继续接收
     startReceive();
 }
 
-void AsioNetworkModel::send(const boost::system::error_code& error, std::size_t) {
+void AsioNetworkModel::send(uint64_t generation, const boost::system::error_code& error, std::size_t bytes_transferred) {
+    // 上一次连接遗留的写完成回调，缓冲区已在断开时丢弃
+    if (generation != generation_) {
+        return;
+    }
+
     if (error) {
-        std::cerr << "发送数据错误: " << error.message() << std::endl;
+        LOG_ERROR("发送数据错误: " << error.message());
         if (error != boost::asio::error::operation_aborted) {
-            disconnect();
+            closeOnError();
         }
+        return;
     }
-}
 
-void AsioNetworkModel::ioThreadFunc() {
-    try {
-        // 使用 work guard 防止 io_context 在没有任务时退出
-        boost::asio::executor_work_guard<boost::asio::io_context::executor_type> work_guard(io_context_.get_executor());
+    traffic_.bytesSent.fetch_add(bytes_transferred, std::memory_order_relaxed);
+    buffer_pool_.release(writing_);
+    write_buffers_.clear();
 
-        // 运行 io_context，直到显式调用 stop()
-        io_context_.run();
-    } catch (const std::exception& e) {
-        std::cerr << "IO线程异常: " << e.what() << std::endl;
-
-        // 如果发生异常，尝试断开连接
-        if (connected_) {
-            try {
-                disconnect();
-            } catch (...) {
-                // 忽略断开连接时的异常
-            }
-        }
-    }
+    // 写操作期间进入队列的帧合并为下一次写操作
+    startWrite();
 }
 
 } // namespace network
@@ -1,14 +1,20 @@
 #pragma once
 
 #include "base_network_model.hpp"
+#include "common/timer_wheel.hpp"
+#include "frame_buffer_pool.hpp"
+#include "handler_memory.hpp"
+#include "io_service.hpp"
+#include "protocol/frame_decoder.hpp"
 #include "types.h"
 #include <boost/asio.hpp>
-#include <thread>
 #include <mutex>
-#include <queue>
 #include <atomic>
-#include <condition_variable>
 #include <chrono>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
 
 namespace network {
 
@@ -17,18 +23,39 @@ class INetworkCallback {
 public:
     virtual ~INetworkCallback() = default;
     virtual void onMessageReceived(std::unique_ptr<protocol::IMessage> message) = 0;
+
+    /**
+     * @brief 连接因收发错误被动断开（不包括主动调用 disconnect()），在IO线程中调用
+     */
+    virtual void onDisconnected() {}
+};
+
+/**
+ * @brief 连接的收发计数，从创建起单调递增（跨越重连），任意线程可读
+ */
+struct TrafficCounters {
+    std::atomic<uint64_t> bytesSent{0};       ///< 已写入 socket 的字节数
+    std::atomic<uint64_t> bytesReceived{0};   ///< 从 socket 读取的字节数
+    std::atomic<uint64_t> framesSent{0};      ///< 进入发送队列的帧数
+    std::atomic<uint64_t> framesDecoded{0};   ///< 解码成功的帧数
+    std::atomic<uint64_t> decodeFailures{0};  ///< 分帧成功但消息体无法解码的帧数
 };
 
 /**
  * @brief 基于Boost.Asio的网络模型实现
+ *
+ * 所有收发、定时任务和回调都在本连接的 strand 上串行执行，io_context 与IO线程由
+ * IoService 提供，可以由多个连接共享。处理函数都持有一个生命周期令牌，析构时在 strand
+ * 上使令牌失效，之后仍留在共享 io_context 中的处理函数不再访问本对象。
  */
 class AsioNetworkModel : public BaseNetworkModel {
 public:
     /**
      * @brief 构造函数
      * @param callback 网络回调接口
+     * @param ioService 共享的 IoService，为空时创建一个独占的单线程 IoService
      */
-    explicit AsioNetworkModel(INetworkCallback& callback);
+    explicit AsioNetworkModel(INetworkCallback& callback, std::shared_ptr<IoService> ioService = nullptr);
 
     /**
      * @brief 析构函数
@@ -40,6 +67,7 @@ public:
      * @param host 主机地址
      * @param port 端口号
      * @return 是否连接成功
+     * @note 阻塞到连接完成或超时，不能在本连接的IO线程（回调）中调用
      */
     bool connect(const std::string& host, uint16_t port) override;
 
@@ -58,16 +86,75 @@ public:
      * @brief 发送消息
      * @param message 要发送的消息
      * @return 是否发送成功
+     * @note 帧在调用线程中序列化后进入发送队列；同一时刻只有一个写操作在途，
+     *       写操作完成前进入队列的帧在下一次写操作中一并发出（一次 writev），顺序与提交顺序一致
      */
     bool sendMessage(const protocol::IMessage& message) override;
 
+    /**
+     * @brief 使用上一次 connect() 解析得到的地址异步重新连接，不再解析主机名
+     * @param handler 完成回调，在IO线程（strand）中调用，参数为是否已连接；从未成功解析过地址时为 false
+     * @note 连接超时与 connect() 相同，可以在IO线程中调用
+     */
+    void reconnect(std::function<void(bool)> handler);
+
+    /**
+     * @brief 把连接当作已失效关闭（例如心跳超时），与收发出错一样通过 onDisconnected() 通知上层
+     * @note 可以在任意线程调用；未连接时不做任何事
+     */
+    void dropConnection();
+
+    /**
+     * @brief 设置之后建立的连接是否开启 TCP keepalive
+     */
+    void setKeepAlive(bool enabled);
+
     /**
      * @brief 设置连接超时时间
      * @param timeout 超时时间（毫秒）
      */
     void setConnectionTimeout(std::chrono::milliseconds timeout);
 
+    /**
+     * @brief 在IO线程（strand）上延迟执行任务，用于请求超时和周期任务
+     * @param delay 延迟时间，精度为时间轮的刻度（TIMER_TICK）
+     * @param task 要执行的任务；到期时照常执行（与连接状态无关），本对象析构后不再执行
+     * @return 定时任务ID，可用 cancelScheduled() 取消
+     * @note 所有定时任务由同一个时间轮管理，只占用一个 asio 定时器，没有定时任务时不会唤醒IO线程
+     */
+    common::TimerWheel::TimerId scheduleAfter(std::chrono::milliseconds delay, std::function<void()> task);
+
+    /**
+     * @brief 取消尚未执行的定时任务
+     * @return 任务已执行或已取消时返回 false
+     */
+    bool cancelScheduled(common::TimerWheel::TimerId id);
+
+    /**
+     * @brief 收发计数
+     */
+    const TrafficCounters& trafficCounters() const { return traffic_; }
+
+    /**
+     * @brief 当前线程是否是运行本连接 io_context 的IO线程（例如在响应回调中，共享IO线程池时也包括其他连接的回调）
+     * @note 在IO线程中不能阻塞等待响应或窗口名额：时间轮和响应都要由IO线程处理
+     */
+    bool runningInIoThread() const;
+
 private:
+    /**
+     * @brief 在 strand 上发起异步连接，完成或超时后在 strand 上调用 handler
+     * @param endpoints 解析得到的地址列表
+     * @param handler 完成回调，参数为错误码，超时为 timed_out
+     */
+    void startConnect(const boost::asio::ip::tcp::resolver::results_type& endpoints,
+                      std::function<void(const boost::system::error_code&)> handler);
+
+    /**
+     * @brief 连接建立后初始化本次连接的状态并启动接收（在 strand 上调用）
+     */
+    void startSession();
+
     /**
      * @brief 启动接收循环
      */
@@ -75,32 +162,98 @@ private:
 
     /**
      * @brief 处理接收到的数据
+     * @param generation 发起读操作时的连接代数
      * @param error 错误码
      * @param bytes_transferred 接收到的字节数
      */
-    void receive(const boost::system::error_code& error, std::size_t bytes_transferred);
+    void receive(uint64_t generation, const boost::system::error_code& error, std::size_t bytes_transferred);
 
     /**
-     * @brief 处理发送完成
+     * @brief 把发送队列中的所有帧合并为一次写操作（在 strand 上调用）
+     */
+    void startWrite();
+
+    /**
+     * @brief 处理发送完成，归还缓冲区并发出写操作期间进入队列的帧
+     * @param generation 发起写操作时的连接代数
      * @param error 错误码
      * @param bytes_transferred 发送的字节数
      */
-    void send(const boost::system::error_code& error, std::size_t bytes_transferred);
+    void send(uint64_t generation, const boost::system::error_code& error, std::size_t bytes_transferred);
+
+    /**
+     * @brief 收发出错时关闭连接并通知上层（在 strand 上调用），同一连接只通知一次
+     */
+    void closeOnError();
+
+    /**
+     * @brief 关闭socket并丢弃发送队列（在 strand 上调用）
+     */
+    void closeSocket();
+
+    /**
+     * @brief 丢弃发送队列和在途写操作的缓冲区
+     */
+    void resetSendQueue();
+
+    /**
+     * @brief 启动时间轮的驱动定时器（在 strand 上调用）
+     */
+    void armTimerWheel();
 
     /**
-     * @brief IO线程函数
+     * @brief 时间轮的一个刻度：执行到期任务，仍有定时任务时继续驱动（在 strand 上调用）
      */
-    void ioThreadFunc();
+    void onTimerWheelTick(const boost::system::error_code& error);
 
-    boost::asio::io_context io_context_;
+    /**
+     * @brief 在 strand 上执行任务并等待其完成；已在 strand 上时直接执行
+     */
+    void runOnStrand(const std::function<void()>& task);
+
+    /**
+     * @brief 包装处理函数：绑定到本连接的 strand，本对象析构后不再调用
+     */
+    template <typename Handler>
+    auto guarded(Handler handler) {
+        return boost::asio::bind_executor(strand_,
+            [token = std::weak_ptr<void>(life_token_), handler = std::move(handler)](auto&&... args) mutable {
+                if (!token.expired()) {
+                    handler(std::forward<decltype(args)>(args)...);
+                }
+            }
+        );
+    }
+
+    std::shared_ptr<IoService> io_service_;   // 必须最先构造、最后析构
     boost::asio::ip::tcp::socket socket_;
     boost::asio::io_context::strand strand_; // 用于序列化异步操作的执行器
-    std::thread io_thread_;
     std::atomic<bool> connected_;
-    std::array<char, 4096> receive_buffer_;
     INetworkCallback& callback_;
-    std::string receive_data_;
+    protocol::FrameDecoder frame_decoder_; // 接收缓冲区兼分帧器，socket 直接读入其中
+    HandlerMemory receive_memory_;         // 在途读操作的处理函数内存，每个连接同时只有一个读操作
     std::chrono::milliseconds connection_timeout_{5000}; // 连接超时时间，默认5秒
+    std::atomic<bool> keep_alive_{false};               // 新连接是否开启 TCP keepalive
+
+    std::mutex send_mutex_;                                 // 保护 send_queue_ 与 write_in_progress_
+    std::vector<std::string> send_queue_;                   // 等待发送的帧，按提交顺序排列
+    bool write_in_progress_ = false;                        // 已有写操作在途或已投递 startWrite()
+    std::vector<std::string> writing_;                      // 在途写操作中的帧，写完成前不能释放（仅在 strand 上访问）
+    std::vector<boost::asio::const_buffer> write_buffers_;  // writing_ 对应的缓冲区序列
+    FrameBufferPool buffer_pool_;                           // 发送帧缓冲区池
+    TrafficCounters traffic_;                               // 收发计数，只做 relaxed 递增
+    uint64_t generation_ = 0;                               // 连接代数，用于忽略上一次连接遗留的完成回调（仅在 strand 上访问）
+    boost::asio::ip::tcp::resolver::results_type endpoints_; // 上一次解析得到的地址，供 reconnect() 使用（仅在 strand 上访问）
+
+    common::TimerWheel timer_wheel_;                        // 本连接的所有定时任务
+    boost::asio::steady_timer wheel_timer_;                 // 驱动时间轮，仅在 strand 上访问
+    std::atomic<bool> wheel_armed_{false};                  // 驱动定时器已启动或已投递启动
+
+    std::shared_ptr<void> life_token_;                      // 生命周期令牌，仅在 strand 上失效
+
+    static constexpr std::chrono::milliseconds TIMER_TICK{10}; // 时间轮刻度
+
+    static constexpr size_t RECEIVE_CHUNK_SIZE = 4096; // 单次读取的最大字节数
 };
 
 } // namespace network
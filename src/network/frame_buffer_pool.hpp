@@ -0,0 +1,56 @@
+#pragma once
+
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace network {
+
+/**
+ * @brief 发送帧缓冲区池
+ *
+ * 发送方从池中取出缓冲区序列化消息，写完成后由IO线程整批归还，稳定状态下发送路径
+ * 不再为每个帧分配内存。池的大小和单个缓冲区的容量都有上限，偶发的超大帧（长路径
+ * 1003）不会被长期持有。
+ */
+class FrameBufferPool {
+public:
+    static constexpr size_t MAX_POOLED_BUFFERS = 64;          ///< 池中最多保留的缓冲区数
+    static constexpr size_t MAX_POOLED_CAPACITY = 64 * 1024;  ///< 超过该容量的缓冲区不回收
+
+    /**
+     * @brief 取出一个空缓冲区，池为空时返回新的缓冲区
+     */
+    std::string acquire() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (free_.empty()) {
+            return std::string();
+        }
+        std::string buffer = std::move(free_.back());
+        free_.pop_back();
+        return buffer;
+    }
+
+    /**
+     * @brief 整批归还缓冲区，buffers 被清空
+     */
+    void release(std::vector<std::string>& buffers) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto& buffer : buffers) {
+            if (free_.size() >= MAX_POOLED_BUFFERS) {
+                break;
+            }
+            if (buffer.capacity() <= MAX_POOLED_CAPACITY) {
+                buffer.clear();
+                free_.push_back(std::move(buffer));
+            }
+        }
+        buffers.clear();
+    }
+
+private:
+    std::mutex mutex_;
+    std::vector<std::string> free_;
+};
+
+} // namespace network
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <boost/asio/associated_allocator.hpp>
+#include <boost/asio/associated_executor.hpp>
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace network {
+
+/**
+ * @brief 单个在途异步操作专用的处理函数内存
+ *
+ * Asio 默认把异步操作的状态对象放在每线程只有一个槽位的回收缓存中，同一线程上释放的其他操作
+ * （定时器、投递的任务等）会占据该槽位，之后的操作只能重新分配。读操作每个连接同时只有一个在途，
+ * 给它一块固定的内存，接收路径就不再受其他操作的影响；块被占用或不够大时退回通用分配器。
+ */
+class HandlerMemory {
+public:
+    static constexpr size_t CAPACITY = 512;
+
+    HandlerMemory() = default;
+    HandlerMemory(const HandlerMemory&) = delete;
+    HandlerMemory& operator=(const HandlerMemory&) = delete;
+
+    void* allocate(size_t size) {
+        if (size <= CAPACITY && !in_use_.exchange(true, std::memory_order_acquire)) {
+            return &storage_;
+        }
+        return ::operator new(size);
+    }
+
+    void deallocate(void* pointer) noexcept {
+        if (pointer == &storage_) {
+            in_use_.store(false, std::memory_order_release);
+        } else {
+            ::operator delete(pointer);
+        }
+    }
+
+private:
+    typename std::aligned_storage<CAPACITY, alignof(std::max_align_t)>::type storage_;
+    std::atomic<bool> in_use_{false};
+};
+
+/**
+ * @brief 从 HandlerMemory 分配的分配器，作为处理函数的关联分配器
+ */
+template <typename T>
+class HandlerAllocator {
+public:
+    using value_type = T;
+
+    explicit HandlerAllocator(HandlerMemory& memory) noexcept : memory_(&memory) {}
+
+    template <typename U>
+    HandlerAllocator(const HandlerAllocator<U>& other) noexcept : memory_(other.memory_) {}
+
+    T* allocate(size_t n) {
+        return static_cast<T*>(memory_->allocate(sizeof(T) * n));
+    }
+
+    void deallocate(T* pointer, size_t) noexcept {
+        memory_->deallocate(pointer);
+    }
+
+    template <typename U>
+    bool operator==(const HandlerAllocator<U>& other) const noexcept { return memory_ == other.memory_; }
+
+    template <typename U>
+    bool operator!=(const HandlerAllocator<U>& other) const noexcept { return memory_ != other.memory_; }
+
+private:
+    template <typename> friend class HandlerAllocator;
+
+    HandlerMemory* memory_;
+};
+
+/**
+ * @brief 带关联分配器的处理函数包装，保留原处理函数的关联执行器（strand）
+ */
+template <typename Handler>
+class MemoryBoundHandler {
+public:
+    using allocator_type = HandlerAllocator<Handler>;
+    using executor_type = boost::asio::associated_executor_t<Handler>;
+
+    MemoryBoundHandler(HandlerMemory& memory, Handler handler)
+        : memory_(memory), handler_(std::move(handler)) {}
+
+    allocator_type get_allocator() const noexcept {
+        return allocator_type(memory_);
+    }
+
+    executor_type get_executor() const noexcept {
+        return boost::asio::get_associated_executor(handler_);
+    }
+
+    template <typename... Args>
+    void operator()(Args&&... args) {
+        handler_(std::forward<Args>(args)...);
+    }
+
+private:
+    HandlerMemory& memory_;
+    Handler handler_;
+};
+
+template <typename Handler>
+MemoryBoundHandler<std::decay_t<Handler>> bindHandlerMemory(HandlerMemory& memory, Handler&& handler) {
+    return MemoryBoundHandler<std::decay_t<Handler>>(memory, std::forward<Handler>(handler));
+}
+
+} // namespace network
@@ -0,0 +1,48 @@
+#include "io_service.hpp"
+#include "common/logging.hpp"
+#include <algorithm>
+
+namespace network {
+
+IoService::IoService(size_t threadCount)
+    : work_guard_(io_context_.get_executor()) {
+    if (threadCount == 0) {
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    threads_.reserve(threadCount);
+    for (size_t i = 0; i < threadCount; ++i) {
+        threads_.emplace_back(&IoService::run, this);
+    }
+}
+
+IoService::~IoService() {
+    work_guard_.reset();
+    io_context_.stop();
+
+    for (auto& thread : threads_) {
+        if (thread.get_id() == std::this_thread::get_id()) {
+            // 最后一个使用者在IO线程中释放了本对象，不能等待自身结束。
+            // 当前处理函数返回后该线程立即退出，调用方不应依赖这种用法
+            thread.detach();
+        } else if (thread.joinable()) {
+            thread.join();
+        }
+    }
+}
+
+void IoService::run() {
+    while (true) {
+        try {
+            // 运行 io_context，直到析构时调用 stop()
+            io_context_.run();
+            return;
+        } catch (const std::exception& e) {
+            LOG_ERROR("IO线程异常: " << e.what());
+        } catch (...) {
+            LOG_ERROR("IO线程未知异常");
+        }
+    }
+}
+
+} // namespace network
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <boost/asio.hpp>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace network {
+
+/**
+ * @brief 一个 io_context 加一组运行它的IO线程
+ *
+ * 每个 AsioNetworkModel 默认独占一个单线程的 IoService；多机器狗场景下多个连接共享同一个
+ * IoService，各自通过自己的 strand 串行化收发，线程数与连接数无关。
+ */
+class IoService {
+public:
+    /**
+     * @brief 构造函数，立即启动IO线程
+     * @param threadCount IO线程数，0 表示使用硬件并发数
+     */
+    explicit IoService(size_t threadCount = 1);
+
+    /**
+     * @brief 析构函数，停止 io_context 并回收IO线程
+     */
+    ~IoService();
+
+    IoService(const IoService&) = delete;
+    IoService& operator=(const IoService&) = delete;
+
+    /**
+     * @brief 获取 io_context
+     */
+    boost::asio::io_context& context() { return io_context_; }
+
+    /**
+     * @brief IO线程数
+     */
+    size_t threadCount() const { return threads_.size(); }
+
+private:
+    /**
+     * @brief IO线程函数，处理函数抛出的异常不会结束线程
+     */
+    void run();
+
+    boost::asio::io_context io_context_;
+    boost::asio::executor_work_guard<boost::asio::io_context::executor_type> work_guard_;
+    std::vector<std::thread> threads_;
+};
+
+} // namespace network
@@ -0,0 +1,133 @@
+#include "frame_decoder.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+
+namespace {
+// 协议头同步字 0xEB90EB90
+constexpr char SYNC_PATTERN[] = {'\xeb', '\x90', '\xeb', '\x90'};
+constexpr size_t SYNC_SIZE = sizeof(SYNC_PATTERN);
+}  // namespace
+
+namespace protocol {
+
+FrameDecoder::FrameDecoder(size_t initialCapacity)
+    : buffer_(std::max(initialCapacity, HEADER_SIZE + 1)) {
+}
+
+char* FrameDecoder::prepare(size_t size) {
+    restoreTerminator();
+
+    // 尾部空间不足（需额外保留 1 字节放置结尾符）时，先把未消费的尾部搬回起始位置
+    if (buffer_.size() - write_pos_ < size + 1 && read_pos_ > 0) {
+        std::memmove(buffer_.data(), buffer_.data() + read_pos_, bufferedSize());
+        write_pos_ -= read_pos_;
+        read_pos_ = 0;
+    }
+
+    // 仍然不足时扩容，扩容只会在出现超过当前容量的大帧时发生
+    if (buffer_.size() - write_pos_ < size + 1) {
+        buffer_.resize(std::max(buffer_.size() * 2, write_pos_ + size + 1));
+    }
+
+    return buffer_.data() + write_pos_;
+}
+
+void FrameDecoder::commit(size_t size) {
+    write_pos_ = std::min(write_pos_ + size, buffer_.size() - 1);
+}
+
+void FrameDecoder::append(const char* data, size_t size) {
+    std::memcpy(prepare(size), data, size);
+    commit(size);
+}
+
+bool FrameDecoder::next(Frame& frame) {
+    restoreTerminator();
+
+    if (!resync()) {
+        return false;
+    }
+
+    if (bufferedSize() < HEADER_SIZE) {
+        return false;
+    }
+
+    ProtocolHeader header;
+    std::memcpy(&header, buffer_.data() + read_pos_, HEADER_SIZE);
+
+    const size_t frame_size = HEADER_SIZE + header.getBodySize();
+    if (bufferedSize() < frame_size) {
+        // 帧不完整，等待更多数据
+        return false;
+    }
+
+    // 在帧体末尾临时写入结尾符，使帧体可以被原地解析，下次操作缓冲区前恢复
+    const size_t body_pos = read_pos_ + HEADER_SIZE;
+    terminator_pos_ = body_pos + header.getBodySize();
+    terminator_saved_ = buffer_[terminator_pos_];
+    terminator_active_ = true;
+    buffer_[terminator_pos_] = '\0';
+
+    frame.sequenceNumber = header.sequenceNumber;
+    frame.body = std::string_view(buffer_.data() + body_pos, header.getBodySize());
+    read_pos_ += frame_size;
+
+    if (read_pos_ == write_pos_) {
+        // 缓冲区已全部消费，下次从头写入，避免搬移数据
+        read_pos_ = 0;
+        write_pos_ = 0;
+    }
+    return true;
+}
+
+void FrameDecoder::reset() {
+    terminator_active_ = false;
+    read_pos_ = 0;
+    write_pos_ = 0;
+}
+
+bool FrameDecoder::resync() {
+    const char* begin = buffer_.data() + read_pos_;
+    const char* end = buffer_.data() + write_pos_;
+
+    // 同步字可能出现在帧体或残缺数据中，只接受保留字段全为 0 的候选协议头；
+    // 候选之后的数据还不足一个协议头时无法判断，先保留等待更多数据
+    const char* found = begin;
+    while ((found = std::search(found, end, std::begin(SYNC_PATTERN), std::end(SYNC_PATTERN))) != end) {
+        if (static_cast<size_t>(end - found) < HEADER_SIZE || hasValidReserved(found)) {
+            break;
+        }
+        ++found;
+    }
+
+    if (found != end) {
+        discarded_bytes_ += static_cast<uint64_t>(found - begin);
+        read_pos_ += static_cast<size_t>(found - begin);
+        return true;
+    }
+
+    // 未找到完整同步字：保留末尾可能构成同步字前缀的字节，其余全部丢弃
+    size_t keep = std::min(bufferedSize(), SYNC_SIZE - 1);
+    while (keep > 0 && std::memcmp(end - keep, SYNC_PATTERN, keep) != 0) {
+        --keep;
+    }
+
+    discarded_bytes_ += bufferedSize() - keep;
+    read_pos_ = write_pos_ - keep;
+    return false;
+}
+
+bool FrameDecoder::hasValidReserved(const char* header) {
+    const char* reserved = header + offsetof(ProtocolHeader, reserved);
+    return std::all_of(reserved, header + HEADER_SIZE, [](char c) { return c == '\0'; });
+}
+
+void FrameDecoder::restoreTerminator() {
+    if (terminator_active_) {
+        buffer_[terminator_pos_] = terminator_saved_;
+        terminator_active_ = false;
+    }
+}
+
+} // namespace protocol
@@ -0,0 +1,115 @@
+#pragma once
+
+#include "protocol_header.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace protocol {
+
+/**
+ * @brief 从字节流中切分出的一个完整协议帧
+ * @note body 指向 FrameDecoder 内部缓冲区，仅在下一次调用 FrameDecoder 的
+ *       next()/prepare()/append()/reset() 之前有效
+ * @note body.data()[body.size()] 保证为 '\0'，可直接交给需要结尾符的解析器原地解析
+ */
+struct Frame {
+    uint16_t sequenceNumber = 0;  ///< 协议头中的序列号
+    std::string_view body;        ///< 消息体视图（不含协议头）
+};
+
+/**
+ * @brief 增量式协议帧解码器
+ *
+ * 接收端按 TCP 字节流追加数据，解码器在缓冲区中查找 0xEB90EB90 同步字，
+ * 依次切分出所有完整的帧。一次读取中包含多个帧、一个帧跨越多次读取、
+ * 或帧前夹杂无效字节的情况都能正确处理。已消费的数据会被丢弃，缓冲区中
+ * 只保留尚未构成完整帧的尾部数据，帧体以视图形式返回，不做拷贝。
+ *
+ * 内部缓冲区是一块连续的 slab：socket 通过 prepare()/commit() 直接读入其中，
+ * 只有在尾部空间不足时才把未消费的尾部数据搬回起始位置。
+ *
+ * 该类不是线程安全的，应只在接收链路（IO strand）上使用。
+ */
+class FrameDecoder {
+public:
+    static constexpr size_t HEADER_SIZE = sizeof(ProtocolHeader);
+
+    /**
+     * @brief 构造函数
+     * @param initialCapacity 缓冲区初始容量
+     */
+    explicit FrameDecoder(size_t initialCapacity = 8192);
+
+    /**
+     * @brief 获取一块至少 size 字节的可写区域，供 socket 直接读入
+     * @param size 需要的可写字节数
+     * @return 可写区域起始地址
+     * @note 调用后之前返回的 Frame 视图全部失效
+     */
+    char* prepare(size_t size);
+
+    /**
+     * @brief 确认 prepare() 返回的区域中已写入 size 字节
+     * @param size 实际写入的字节数
+     */
+    void commit(size_t size);
+
+    /**
+     * @brief 追加接收到的数据（拷贝），等价于 prepare() + memcpy + commit()
+     * @param data 数据起始地址
+     * @param size 数据长度
+     */
+    void append(const char* data, size_t size);
+
+    /**
+     * @brief 取出下一个完整帧
+     * @param frame 输出的帧
+     * @return 缓冲区中存在完整帧时返回 true，否则返回 false
+     */
+    bool next(Frame& frame);
+
+    /**
+     * @brief 清空缓冲区，用于连接断开后重置状态
+     */
+    void reset();
+
+    /**
+     * @brief 获取缓冲区中尚未消费的字节数
+     */
+    size_t bufferedSize() const { return write_pos_ - read_pos_; }
+
+    /**
+     * @brief 获取因重新同步而丢弃的字节总数
+     */
+    uint64_t discardedBytes() const { return discarded_bytes_; }
+
+private:
+    /**
+     * @brief 从 read_pos_ 开始定位同步字，丢弃其前面的无效字节
+     * @return 找到同步字时返回 true
+     */
+    bool resync();
+
+    /**
+     * @brief 检查候选协议头的保留字段是否全为 0，用于排除帧体或残缺数据中的伪同步字
+     * @param header 候选协议头起始地址，其后至少有 HEADER_SIZE 字节
+     */
+    static bool hasValidReserved(const char* header);
+
+    /**
+     * @brief 恢复上一个帧结尾处被临时写入 '\0' 的字节
+     */
+    void restoreTerminator();
+
+    std::vector<char> buffer_;   ///< 连续缓冲区，始终比 write_pos_ 至少多 1 字节用于放置结尾符
+    size_t read_pos_ = 0;        ///< 下一个未消费字节的位置
+    size_t write_pos_ = 0;       ///< 已写入数据的末尾位置
+    size_t terminator_pos_ = 0;  ///< 被临时替换为 '\0' 的字节位置
+    char terminator_saved_ = 0;  ///< 被替换前的原始字节
+    bool terminator_active_ = false;
+    uint64_t discarded_bytes_ = 0;
+};
+
+} // namespace protocol
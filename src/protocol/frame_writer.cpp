@@ -0,0 +1,22 @@
+#include "frame_writer.hpp"
+#include <cstring>
+#include <limits>
+
+namespace protocol {
+
+FrameWriter::FrameWriter(std::string& out) : out_(out) {
+    out_.clear();
+    out_.append(HEADER_SIZE, '\0');
+}
+
+bool FrameWriter::finish(uint16_t sequenceNumber) {
+    if (bodySize() > std::numeric_limits<uint16_t>::max()) {
+        return false;
+    }
+
+    ProtocolHeader header(static_cast<uint16_t>(bodySize()), sequenceNumber);
+    std::memcpy(&out_[0], &header, HEADER_SIZE);
+    return true;
+}
+
+} // namespace protocol
@@ -0,0 +1,163 @@
+#pragma once
+
+#include "number_codec.hpp"
+#include "protocol_header.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace protocol {
+
+/**
+ * @brief 协议帧编码器
+ *
+ * 直接把协议头和XML消息体写入调用方提供的同一块输出缓冲区：先预留协议头位置，
+ * 消息体写完后再回填长度和序列号。数值使用 formatNumber()（std::to_chars）格式化，不依赖 locale，
+ * 不创建临时字符串。输出缓冲区可跨多次编码复用，容量足够时整个编码过程不分配内存。
+ */
+class FrameWriter {
+public:
+    static constexpr size_t HEADER_SIZE = sizeof(ProtocolHeader);
+
+    /**
+     * @brief 构造函数，清空输出缓冲区（保留容量）并预留协议头
+     * @param out 输出缓冲区
+     */
+    explicit FrameWriter(std::string& out);
+
+    /**
+     * @brief 预留输出缓冲区容量
+     * @param bodySize 预计的消息体字节数
+     */
+    void reserve(size_t bodySize) { out_.reserve(HEADER_SIZE + bodySize); }
+
+    /**
+     * @brief 追加原始文本
+     */
+    FrameWriter& append(std::string_view text) {
+        out_.append(text.data(), text.size());
+        return *this;
+    }
+
+    /**
+     * @brief 追加格式化后的数值
+     */
+    template <typename T, typename = std::enable_if_t<std::is_arithmetic_v<T>>>
+    FrameWriter& appendNumber(T value) {
+        char buffer[32];
+        const char* end = formatNumber(buffer, buffer + sizeof(buffer), value);
+        out_.append(buffer, static_cast<size_t>(end - buffer));
+        return *this;
+    }
+
+    /**
+     * @brief 追加一个完整的文本元素：indent<name>text</name>\n
+     */
+    FrameWriter& element(std::string_view name, std::string_view text, std::string_view indent = {}) {
+        return append(indent).append("<").append(name).append(">").append(text)
+              .append("</").append(name).append(">\n");
+    }
+
+    /**
+     * @brief 追加一个完整的数值元素：indent<name>value</name>\n
+     */
+    template <typename T, typename = std::enable_if_t<std::is_arithmetic_v<T>>>
+    FrameWriter& element(std::string_view name, T value, std::string_view indent = {}) {
+        append(indent).append("<").append(name).append(">");
+        appendNumber(value);
+        return append("</").append(name).append(">\n");
+    }
+
+    /**
+     * @brief 用预先编码好的整帧（协议头 + 消息体）替换当前内容
+     * @param frame 整帧数据，通常来自 FrameTemplate
+     */
+    void assignFrame(std::string_view frame) {
+        out_.assign(frame.data(), frame.size());
+    }
+
+    /**
+     * @brief 在消息体指定偏移处原地覆盖写入定长文本
+     * @param bodyOffset 相对消息体起始位置的偏移
+     * @param text 写入的文本，不得超出当前消息体范围
+     */
+    void patch(size_t bodyOffset, std::string_view text) {
+        out_.replace(HEADER_SIZE + bodyOffset, text.size(), text.data(), text.size());
+    }
+
+    /**
+     * @brief 当前消息体已写入的字节数
+     */
+    size_t bodySize() const { return out_.size() - HEADER_SIZE; }
+
+    /**
+     * @brief 结束编码，回填协议头中的长度和序列号
+     * @param sequenceNumber 消息序列号
+     * @return 消息体长度超出协议头 length 字段（uint16_t）的表示范围时返回 false
+     */
+    bool finish(uint16_t sequenceNumber);
+
+private:
+    std::string& out_;
+};
+
+/**
+ * @brief 写入消息体固定、仅 <Time> 字段变化的请求（1002/1004/1007）的消息体
+ * @param writer 帧编码器
+ * @param typeCode 协议 Type 字段，例如 "1002"
+ * @param timestamp 时间戳文本
+ * @return 时间戳在消息体中的偏移
+ */
+inline size_t writeFixedBody(FrameWriter& writer, std::string_view typeCode, std::string_view timestamp) {
+    writer.append("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<PatrolDevice>\n<Type>")
+          .append(typeCode)
+          .append("</Type>\n<Command>1</Command>\n<Time>");
+    const size_t time_offset = writer.bodySize();
+    writer.append(timestamp).append("</Time>\n<Items/>\n</PatrolDevice>");
+    return time_offset;
+}
+
+/**
+ * @brief 消息体固定、仅 <Time> 字段变化的请求帧模板
+ *
+ * 常量部分（协议头与XML）只编码一次，每次发送时整帧拷贝，
+ * 再原地填入定长时间戳，由 FrameWriter::finish() 回填序列号。
+ */
+class FrameTemplate {
+public:
+    /**
+     * @brief 构造函数
+     * @param typeCode 协议 Type 字段，例如 "1002"
+     * @param timestampLength 时间戳的固定长度
+     */
+    FrameTemplate(std::string_view typeCode, size_t timestampLength)
+        : timestamp_length_(timestampLength) {
+        FrameWriter writer(frame_);
+        time_offset_ = writeFixedBody(writer, typeCode, std::string(timestampLength, ' '));
+        writer.finish(0);
+    }
+
+    /**
+     * @brief 把模板渲染到帧编码器
+     * @param writer 帧编码器
+     * @param timestamp 时间戳，长度必须等于构造时指定的长度
+     */
+    void render(FrameWriter& writer, std::string_view timestamp) const {
+        writer.assignFrame(frame_);
+        writer.patch(time_offset_, timestamp.substr(0, timestamp_length_));
+    }
+
+    /**
+     * @brief 模板要求的时间戳长度
+     */
+    size_t timestampLength() const { return timestamp_length_; }
+
+private:
+    std::string frame_;          ///< 预编码的整帧
+    size_t time_offset_ = 0;     ///< 时间戳在消息体中的偏移
+    size_t timestamp_length_ = 0;
+};
+
+} // namespace protocol
@@ -1,10 +1,13 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <memory>
 
 namespace protocol {
 
+class FrameWriter;
+
 /**
  * @brief 消息类型枚举
  */
@@ -60,17 +63,17 @@ public:
     virtual MessageType getType() const = 0;
 
     /**
-     * @brief 序列化消息为字符串
-     * @return 序列化后的字符串
+     * @brief 将消息体序列化到帧编码器
+     * @param writer 帧编码器，协议头由调用方在写完消息体后回填
      */
-    virtual std::string serialize() const = 0;
+    virtual void serialize(FrameWriter& writer) const = 0;
 
     /**
-     * @brief 从字符串反序列化消息
-     * @param data 序列化的字符串
+     * @brief 从消息体视图反序列化消息
+     * @param data 消息体视图，data.data()[data.size()] 必须为 '\0'，以便原地解析
      * @return 是否成功
      */
-    virtual bool deserialize(const std::string& data) = 0;
+    virtual bool deserialize(std::string_view data) = 0;
 
     /**
      * @brief 获取消息序列号
@@ -0,0 +1,88 @@
+#include "message_pool.hpp"
+#include <atomic>
+#include <mutex>
+#include <new>
+
+namespace protocol {
+
+namespace {
+
+constexpr size_t SIZE_CLASS_COUNT = MessagePool::MAX_BLOCK_SIZE / MessagePool::GRANULE;
+
+/**
+ * @brief 空闲块的链表节点，直接存放在空闲块内
+ */
+struct FreeBlock {
+    FreeBlock* next;
+};
+
+struct SizeClass {
+    std::mutex mutex;
+    FreeBlock* head = nullptr;
+    size_t count = 0;
+};
+
+SizeClass* sizeClasses() {
+    // 有意不析构：其他静态对象析构时仍可能释放消息
+    static SizeClass* classes = new SizeClass[SIZE_CLASS_COUNT];
+    return classes;
+}
+
+std::atomic<uint64_t> g_heap_allocations{0};
+std::atomic<uint64_t> g_reused{0};
+
+} // namespace
+
+void* MessagePool::allocate(size_t size) {
+    if (size == 0 || size > MAX_BLOCK_SIZE) {
+        return ::operator new(size);
+    }
+
+    const size_t index = (size - 1) / GRANULE;
+    SizeClass& size_class = sizeClasses()[index];
+    {
+        std::lock_guard<std::mutex> lock(size_class.mutex);
+        if (FreeBlock* block = size_class.head) {
+            size_class.head = block->next;
+            --size_class.count;
+            g_reused.fetch_add(1, std::memory_order_relaxed);
+            return block;
+        }
+    }
+
+    // 按分级上界分配，同一级的块可以互相替代
+    g_heap_allocations.fetch_add(1, std::memory_order_relaxed);
+    return ::operator new((index + 1) * GRANULE);
+}
+
+void MessagePool::deallocate(void* block, size_t size) noexcept {
+    if (!block) {
+        return;
+    }
+    if (size == 0 || size > MAX_BLOCK_SIZE) {
+        ::operator delete(block);
+        return;
+    }
+
+    SizeClass& size_class = sizeClasses()[(size - 1) / GRANULE];
+    {
+        std::lock_guard<std::mutex> lock(size_class.mutex);
+        if (size_class.count < MAX_POOLED_BLOCKS) {
+            FreeBlock* free_block = static_cast<FreeBlock*>(block);
+            free_block->next = size_class.head;
+            size_class.head = free_block;
+            ++size_class.count;
+            return;
+        }
+    }
+    ::operator delete(block);
+}
+
+MessagePool::Stats MessagePool::stats() {
+    Stats stats;
+    stats.heapAllocations = g_heap_allocations.load(std::memory_order_relaxed);
+    stats.reused = g_reused.load(std::memory_order_relaxed);
+    return stats;
+}
+
+} // namespace protocol
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace protocol {
+
+/**
+ * @brief 消息对象的内存池
+ *
+ * 每收到一帧都要创建一个响应对象，每次请求也要创建一个请求对象；这些对象大小固定、生命周期很短。
+ * MessageBase 的 operator new/delete 经由本池按 64 字节分级的空闲链表分配和回收，稳定状态下收发
+ * 消息不再经过通用分配器。
+ *
+ * 响应通常在 IO 线程上解码创建，却在调用方线程上释放（同步请求取走响应），因此池是进程级的，
+ * 每一级由一把互斥锁保护（临界区只有几条指令）；每级保留的空闲块数有上限，突发流量过后多余的
+ * 内存归还给系统。
+ */
+class MessagePool {
+public:
+    static constexpr size_t GRANULE = 64;              ///< 分级粒度（字节）
+    static constexpr size_t MAX_BLOCK_SIZE = 512;      ///< 超过该大小的对象直接使用通用分配器
+    static constexpr size_t MAX_POOLED_BLOCKS = 256;   ///< 每级最多保留的空闲块数
+
+    /**
+     * @brief 池的累计统计
+     */
+    struct Stats {
+        uint64_t heapAllocations = 0;  ///< 池中没有空闲块、向通用分配器申请的次数
+        uint64_t reused = 0;           ///< 复用空闲块的次数
+    };
+
+    /**
+     * @brief 分配 size 字节，对齐与 ::operator new 相同
+     */
+    static void* allocate(size_t size);
+
+    /**
+     * @brief 归还 allocate(size) 分配的内存，size 必须与分配时相同
+     */
+    static void deallocate(void* block, size_t size) noexcept;
+
+    /**
+     * @brief 获取累计统计
+     */
+    static Stats stats();
+};
+
+} // namespace protocol
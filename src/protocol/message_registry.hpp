@@ -0,0 +1,144 @@
+#pragma once
+
+#include "messages.hpp"
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace protocol {
+
+/**
+ * @brief 编译期消息类型列表
+ */
+template <typename... Messages>
+struct MessageList {};
+
+/**
+ * @brief SDK 发出的请求
+ *
+ * 每种消息类提供 MESSAGE_TYPE（SDK 内部的消息类型）与 WIRE_TYPE（协议 Type 字段）两个常量。
+ * 新增消息类型（例如 1005/1006）时定义消息类，并在下面对应的列表中加一行。
+ */
+using RequestMessages = MessageList<
+    GetRealTimeStatusRequest,
+    NavigationTaskRequest,
+    CancelTaskRequest,
+    QueryStatusRequest
+>;
+
+/**
+ * @brief SDK 接收的响应，按协议 Type 字段解码
+ */
+using ResponseMessages = MessageList<
+    GetRealTimeStatusResponse,
+    NavigationTaskResponse,
+    CancelTaskResponse,
+    QueryStatusResponse
+>;
+
+namespace detail {
+
+template <typename... Requests, typename... Responses>
+constexpr MessageList<Requests..., Responses...> concat(MessageList<Requests...>, MessageList<Responses...>) {
+    return {};
+}
+
+template <typename... Messages>
+constexpr bool hasDistinctTypes(MessageList<Messages...>) {
+    constexpr MessageType types[] = {Messages::MESSAGE_TYPE...};
+    for (size_t i = 0; i < sizeof...(Messages); ++i) {
+        for (size_t j = i + 1; j < sizeof...(Messages); ++j) {
+            if (types[i] == types[j]) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+template <typename... Messages>
+constexpr bool hasDistinctWireTypes(MessageList<Messages...>) {
+    constexpr int types[] = {Messages::WIRE_TYPE...};
+    for (size_t i = 0; i < sizeof...(Messages); ++i) {
+        for (size_t j = i + 1; j < sizeof...(Messages); ++j) {
+            if (types[i] == types[j]) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+template <typename... Messages>
+constexpr MessageType typeForWire(int wireType, MessageList<Messages...>) {
+    MessageType type = MessageType::UNKNOWN;
+    (void)((Messages::WIRE_TYPE == wireType ? (type = Messages::MESSAGE_TYPE, true) : false) || ...);
+    return type;
+}
+
+template <typename Visitor, typename... Messages>
+bool dispatchType(MessageType type, Visitor& visitor, MessageList<Messages...>) {
+    return ((Messages::MESSAGE_TYPE == type ? (visitor(static_cast<Messages*>(nullptr)), true) : false) || ...);
+}
+
+} // namespace detail
+
+/**
+ * @brief 全部已注册的消息
+ */
+using RegisteredMessages = decltype(detail::concat(RequestMessages(), ResponseMessages()));
+
+// MessageType 唯一确定消息类，messageCast() 与 visitMessage() 依赖这一点；同一方向上的协议 Type 也不能重复
+static_assert(detail::hasDistinctTypes(RegisteredMessages()), "每种 MessageType 只能注册一个消息类");
+static_assert(detail::hasDistinctWireTypes(ResponseMessages()), "每个协议 Type 只能注册一个响应类");
+
+/**
+ * @brief 根据协议 Type 字段确定接收到的响应类型
+ * @param wireType Type 字段的值
+ * @return 响应的消息类型，未注册的 Type 返回 UNKNOWN
+ */
+constexpr MessageType responseTypeForWire(int wireType) {
+    return detail::typeForWire(wireType, ResponseMessages());
+}
+
+/**
+ * @brief 按消息类型调用 visitor，参数为该消息类的空指针（仅用于携带类型）
+ * @return 类型未注册时返回 false，visitor 不被调用
+ */
+template <typename Visitor>
+bool forMessageType(MessageType type, Visitor&& visitor) {
+    return detail::dispatchType(type, visitor, RegisteredMessages());
+}
+
+/**
+ * @brief 不依赖 RTTI 的向下转换，按 getType() 比较
+ * @return 消息不是 T 类型（或为空）时返回 nullptr
+ */
+template <typename T>
+T* messageCast(IMessage* message) {
+    static_assert(std::is_base_of<IMessage, T>::value, "T 必须是消息类");
+    return message && message->getType() == T::MESSAGE_TYPE ? static_cast<T*>(message) : nullptr;
+}
+
+template <typename T>
+const T* messageCast(const IMessage* message) {
+    static_assert(std::is_base_of<IMessage, T>::value, "T 必须是消息类");
+    return message && message->getType() == T::MESSAGE_TYPE ? static_cast<const T*>(message) : nullptr;
+}
+
+/**
+ * @brief 以具体的消息类型访问消息
+ * @param message 消息
+ * @param visitor 可调用对象，对每个可能的消息类 M 都须能以 M& 调用（泛型 lambda 即可）
+ * @return 消息类型未注册时返回 false，visitor 不被调用
+ */
+template <typename Visitor>
+bool visitMessage(IMessage& message, Visitor&& visitor) {
+    return forMessageType(message.getType(), [&](auto* tag) {
+        using Message = std::remove_pointer_t<decltype(tag)>;
+        visitor(static_cast<Message&>(message));
+    });
+}
+
+} // namespace protocol
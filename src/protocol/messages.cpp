@@ -1,5 +1,41 @@
 #include "messages.hpp"
+#include <limits>
 
 namespace protocol {
-    // 大部分实现都在头文件中，这里留空
+
+// 大部分实现都在头文件中，这里只有不适合内联的路线切分
+
+std::vector<std::pair<size_t, size_t>> NavigationTaskRequest::splitRoute(const std::vector<NavigationPoint>& points,
+                                                                         size_t maxPointsPerChunk) {
+    // 每段除导航点外的固定开销：消息体前缀、<Time> 元素与结尾
+    constexpr size_t MAX_BODY_SIZE = std::numeric_limits<uint16_t>::max();
+    constexpr size_t FIXED_SIZE = BODY_PREFIX.size() + MAX_TIME_ELEMENT_SIZE + BODY_SUFFIX.size();
+
+    std::vector<std::pair<size_t, size_t>> chunks;
+    std::string scratch;
+    size_t first = 0;
+    size_t bodySize = FIXED_SIZE;
+
+    for (size_t i = 0; i < points.size(); ++i) {
+        // 逐点编码以得到实际长度，数值的文本长度随取值变化
+        FrameWriter writer(scratch);
+        writePoint(writer, points[i]);
+        const size_t pointSize = writer.bodySize();
+
+        const bool full = (maxPointsPerChunk != 0 && i - first == maxPointsPerChunk) ||
+                          bodySize + pointSize > MAX_BODY_SIZE;
+        if (full && i != first) {
+            chunks.emplace_back(first, i);
+            first = i;
+            bodySize = FIXED_SIZE;
+        }
+        bodySize += pointSize;
+    }
+
+    if (first < points.size()) {
+        chunks.emplace_back(first, points.size());
+    }
+    return chunks;
+}
+
 } // namespace protocol
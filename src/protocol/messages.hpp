@@ -1,14 +1,16 @@
 #pragma once
 
 #include "message_interface.hpp"
+#include "message_pool.hpp"
+#include "xml_scanner.hpp"
+#include "frame_writer.hpp"
+#include "number_codec.hpp"
+#include "timestamp.hpp"
+#include <utility>
 #include <vector>
 #include <string>
-#include <chrono>
 #include <nlohmann/json.hpp>
-#include <rapidxml/rapidxml.hpp>
-#include <sstream>
-#include <iomanip>
-#include <ctime>
+#include <string_view>
 
 namespace protocol {
 
@@ -37,11 +39,7 @@ struct NavigationPoint {
  * @return 格式化的时间戳字符串
  */
 inline std::string getCurrentTimestamp() {
-    auto now = std::chrono::system_clock::now();
-    auto time_t_now = std::chrono::system_clock::to_time_t(now);
-    std::stringstream ss;
-    ss << std::put_time(std::localtime(&time_t_now), "%Y-%m-%d %H:%M:%S");
-    return ss.str();
+    return std::string(currentTimestampView());
 }
 
 class MessageBase : public IMessage {
@@ -55,44 +53,109 @@ public:
     void setSequenceNumber(uint16_t sequenceNumber) override {
         this->sequenceNumber = sequenceNumber;
     }
+
+    /**
+     * @brief 消息对象从 MessagePool 分配，释放后内存留在池中供下一个消息复用
+     */
+    static void* operator new(size_t size) {
+        return MessagePool::allocate(size);
+    }
+
+    static void operator delete(void* block, size_t size) noexcept {
+        MessagePool::deallocate(block, size);
+    }
+
+protected:
+    /**
+     * @brief 标签名确认匹配后解析字段值，排除未知标签与已知字段哈希碰撞的情况
+     */
+    template <typename T>
+    static void setField(std::string_view name, std::string_view expected, std::string_view text, T& value) {
+        if (name == expected) {
+            parseNumber(text, value);
+        }
+    }
+
+    /**
+     * @brief 同 setField()，字段为以整数编码的枚举
+     */
+    template <typename Enum>
+    static void setEnumField(std::string_view name, std::string_view expected, std::string_view text, Enum& value) {
+        int number = 0;
+        if (name == expected && parseNumber(text, number)) {
+            value = static_cast<Enum>(number);
+        }
+    }
+
+    /**
+     * @brief 单遍扫描响应 <PatrolDevice><Items> 中的字段，不构建DOM、不分配内存
+     * @param data 消息体
+     * @param handler 回调，签名为 void(std::string_view name, std::string_view text)
+     */
+    template <typename Handler>
+    static bool scanItems(std::string_view data, Handler&& handler) {
+        std::string_view root;
+        std::string_view items;
+        if (!findElementBody(data, "PatrolDevice", root) || !findElementBody(root, "Items", items)) {
+            return false;
+        }
+        return forEachElement(items, std::forward<Handler>(handler));
+    }
 };
 
 /**
- * @brief 获取实时状态请求
+ * @brief 消息体固定、仅 <Time> 随请求变化的请求（1002/1004/1007）的基类
+ * @tparam Derived 具体请求类型，需提供 static constexpr std::string_view TYPE_CODE（协议 Type 字段）
+ *
+ * 整帧由每种请求各自的 FrameTemplate 预编码，发送时拷贝模板后原地填入时间戳。
+ * timestamp 为空时使用发送时刻的时间（按秒缓存），避免每次构造请求都格式化时间。
  */
-class GetRealTimeStatusRequest : public MessageBase {
+template <typename Derived>
+class FixedBodyRequest : public MessageBase {
 public:
-    std::string timestamp;
+    std::string timestamp; ///< 请求时间，为空时在序列化时取当前时间
 
-    GetRealTimeStatusRequest() : timestamp(getCurrentTimestamp()) {}
+    void serialize(FrameWriter& writer) const override {
+        // 每种请求类型一个模板，首次使用时构建
+        static const FrameTemplate frame_template(Derived::TYPE_CODE, TIMESTAMP_LENGTH);
+        const std::string_view time = timestamp.empty() ? currentTimestampView() : std::string_view(timestamp);
 
-    MessageType getType() const override {
-        return MessageType::GET_REAL_TIME_STATUS_REQ;
-    }
+        if (time.size() == frame_template.timestampLength()) {
+            frame_template.render(writer, time);
+            return;
+        }
 
-    std::string serialize() const override {
-        // 使用XML格式
-        std::stringstream ss;
-        ss << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n";
-        ss << "<PatrolDevice>\n";
-        ss << "<Type>1002</Type>\n";
-        ss << "<Command>1</Command>\n";
-        ss << "<Time>" << timestamp << "</Time>\n";
-        ss << "<Items/>\n";
-        ss << "</PatrolDevice>";
-        return ss.str();
+        // 调用方指定了非标准长度的时间戳，退回逐字段编码
+        writeFixedBody(writer, Derived::TYPE_CODE, time);
     }
 
-    bool deserialize(const std::string&) override {
+    bool deserialize(std::string_view) override {
         return false;
     }
 };
 
+/**
+ * @brief 获取实时状态请求
+ */
+class GetRealTimeStatusRequest : public FixedBodyRequest<GetRealTimeStatusRequest> {
+public:
+    static constexpr std::string_view TYPE_CODE = "1002";
+    static constexpr MessageType MESSAGE_TYPE = MessageType::GET_REAL_TIME_STATUS_REQ;
+    static constexpr int WIRE_TYPE = 1002;
+
+    MessageType getType() const override {
+        return MESSAGE_TYPE;
+    }
+};
+
 /**
  * @brief 获取实时状态响应
  */
 class GetRealTimeStatusResponse : public MessageBase {
 public:
+    static constexpr MessageType MESSAGE_TYPE = MessageType::GET_REAL_TIME_STATUS_RESP;
+    static constexpr int WIRE_TYPE = 1002;
+
     int motionState = 0;
     double posX = 0.0;
     double posY = 0.0;
@@ -123,68 +186,52 @@ public:
     GetRealTimeStatusResponse() {}
 
     MessageType getType() const override {
-        return MessageType::GET_REAL_TIME_STATUS_RESP;
+        return MESSAGE_TYPE;
     }
 
-    std::string serialize() const override {
+    void serialize(FrameWriter&) const override {
         // sdk不负责响应的序列化
-        return "";
     }
 
-    bool deserialize(const std::string& data) override {
+    bool deserialize(std::string_view data) override {
         try {
-            rapidxml::xml_document<> doc;
-            std::vector<char> buffer(data.begin(), data.end());
-            buffer.push_back('\0');
-            doc.parse<rapidxml::parse_non_destructive>(&buffer[0]);
-
-            rapidxml::xml_node<>* root = doc.first_node("PatrolDevice");
-            if (!root) return false;
-
-            rapidxml::xml_node<>* items_node = root->first_node("Items");
-            if (!items_node) return false;
-
-            // 解析各个字段
-            auto get_node_value = [&](const char* name, auto& value) {
-                rapidxml::xml_node<>* node = items_node->first_node(name);
-                if (node) {
-                    std::stringstream ss(node->value());
-                    ss >> value;
+            // 1002 是遥测的热点路径：单遍扫描 <Items> 中的字段，按标签名哈希分派，数值用 parseNumber 原地解析
+            return scanItems(data, [this](std::string_view name, std::string_view text) {
+                switch (tagHash(name)) {
+                    case tagHash("MotionState"):    setField(name, "MotionState", text, motionState); break;
+                    case tagHash("PosX"):           setField(name, "PosX", text, posX); break;
+                    case tagHash("PosY"):           setField(name, "PosY", text, posY); break;
+                    case tagHash("PosZ"):           setField(name, "PosZ", text, posZ); break;
+                    case tagHash("AngleYaw"):       setField(name, "AngleYaw", text, angleYaw); break;
+                    case tagHash("Roll"):           setField(name, "Roll", text, roll); break;
+                    case tagHash("Pitch"):          setField(name, "Pitch", text, pitch); break;
+                    case tagHash("Yaw"):            setField(name, "Yaw", text, yaw); break;
+                    case tagHash("Speed"):          setField(name, "Speed", text, speed); break;
+                    case tagHash("CurOdom"):        setField(name, "CurOdom", text, curOdom); break;
+                    case tagHash("SumOdom"):        setField(name, "SumOdom", text, sumOdom); break;
+                    case tagHash("CurRuntime"):     setField(name, "CurRuntime", text, curRuntime); break;
+                    case tagHash("SumRuntime"):     setField(name, "SumRuntime", text, sumRuntime); break;
+                    case tagHash("Res"):            setField(name, "Res", text, res); break;
+                    case tagHash("X0"):             setField(name, "X0", text, x0); break;
+                    case tagHash("Y0"):             setField(name, "Y0", text, y0); break;
+                    case tagHash("H"):              setField(name, "H", text, h); break;
+                    case tagHash("Electricity"):    setField(name, "Electricity", text, electricity); break;
+                    case tagHash("Location"):       setField(name, "Location", text, location); break;
+                    case tagHash("RTKState"):       setField(name, "RTKState", text, RTKState); break;
+                    case tagHash("OnDockState"):    setField(name, "OnDockState", text, onDockState); break;
+                    case tagHash("GaitState"):      setField(name, "GaitState", text, gaitState); break;
+                    case tagHash("MotorState"):     setField(name, "MotorState", text, motorState); break;
+                    case tagHash("ChargeState"):    setField(name, "ChargeState", text, chargeState); break;
+                    case tagHash("ControlMode"):    setField(name, "ControlMode", text, controlMode); break;
+                    case tagHash("MapUpdateState"): setField(name, "MapUpdateState", text, mapUpdateState); break;
+                    default: break;
                 }
-            };
-
-            get_node_value("MotionState", motionState);
-            get_node_value("PosX", posX);
-            get_node_value("PosY", posY);
-            get_node_value("PosZ", posZ);
-            get_node_value("AngleYaw", angleYaw);
-            get_node_value("Roll", roll);
-            get_node_value("Pitch", pitch);
-            get_node_value("Yaw", yaw);
-            get_node_value("Speed", speed);
-            get_node_value("CurOdom", curOdom);
-            get_node_value("SumOdom", sumOdom);
-            get_node_value("CurRuntime", curRuntime);
-            get_node_value("SumRuntime", sumRuntime);
-            get_node_value("Res", res);
-            get_node_value("X0", x0);
-            get_node_value("Y0", y0);
-            get_node_value("H", h);
-            get_node_value("Electricity", electricity);
-            get_node_value("Location", location);
-            get_node_value("RTKState", RTKState);
-            get_node_value("OnDockState", onDockState);
-            get_node_value("GaitState", gaitState);
-            get_node_value("MotorState", motorState);
-            get_node_value("ChargeState", chargeState);
-            get_node_value("ControlMode", controlMode);
-            get_node_value("MapUpdateState", mapUpdateState);
-
-            return true;
+            });
         } catch (const std::exception& e) {
             return false;
         }
     }
+
 };
 
 /**
@@ -192,51 +239,79 @@ public:
  */
 class NavigationTaskRequest : public MessageBase {
 public:
+    static constexpr MessageType MESSAGE_TYPE = MessageType::NAVIGATION_TASK_REQ;
+    static constexpr int WIRE_TYPE = 1003;
+
     std::vector<NavigationPoint> points;
     std::string timestamp;
 
     NavigationTaskRequest() : timestamp(getCurrentTimestamp()) {}
 
     MessageType getType() const override {
-        return MessageType::NAVIGATION_TASK_REQ;
+        return MESSAGE_TYPE;
     }
 
-    std::string serialize() const override {
+    void serialize(FrameWriter& writer) const override {
+        // 按上限预留，整个编码过程最多一次分配（缓冲区复用时为零次）
+        writer.reserve(BODY_PREFIX.size() + MAX_TIME_ELEMENT_SIZE + points.size() * MAX_POINT_SIZE + BODY_SUFFIX.size());
+
         // 使用XML格式
-        std::stringstream ss;
-        ss << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n";
-        ss << "<PatrolDevice>\n";
-        ss << "<Type>1003</Type>\n";
-        ss << "<Command>1</Command>\n";
-        ss << "<Time>" << timestamp << "</Time>\n";
+        writer.append(BODY_PREFIX).element("Time", timestamp);
 
         // 添加导航点
         for (const auto& point : points) {
-            ss << "<Items>\n";
-            ss << "  <MapId>" << point.mapId << "</MapId>\n";
-            ss << "  <Value>" << point.value << "</Value>\n";
-            ss << "  <PosX>" << point.posX << "</PosX>\n";
-            ss << "  <PosY>" << point.posY << "</PosY>\n";
-            ss << "  <PosZ>" << point.posZ << "</PosZ>\n";
-            ss << "  <AngleYaw>" << point.angleYaw << "</AngleYaw>\n";
-            ss << "  <PointInfo>" << point.pointInfo << "</PointInfo>\n";
-            ss << "  <Gait>" << point.gait << "</Gait>\n";
-            ss << "  <Speed>" << point.speed << "</Speed>\n";
-            ss << "  <Manner>" << point.manner << "</Manner>\n";
-            ss << "  <ObsMode>" << point.obsMode << "</ObsMode>\n";
-            ss << "  <NavMode>" << point.navMode << "</NavMode>\n";
-            ss << "  <Terrain>" << point.terrain << "</Terrain>\n";
-            ss << "  <Posture>" << point.posture << "</Posture>\n";
-            ss << "</Items>\n";
+            writePoint(writer, point);
         }
 
-        ss << "</PatrolDevice>";
-        return ss.str();
+        writer.append(BODY_SUFFIX);
     }
 
-    bool deserialize(const std::string&) override {
+    bool deserialize(std::string_view) override {
         return false;
     }
+
+    /**
+     * @brief 把路线按编码后的实际长度切分为若干段，每段编码为一个 1003 请求时消息体不超过协议头 length 字段（uint16_t）的上限
+     * @param points 导航点
+     * @param maxPointsPerChunk 每段最多的导航点数，0 表示只受长度上限约束
+     * @return 每段在 points 中的下标范围 [first, second)，按顺序排列；points 为空时返回空
+     */
+    static std::vector<std::pair<size_t, size_t>> splitRoute(const std::vector<NavigationPoint>& points,
+                                                             size_t maxPointsPerChunk = 0);
+
+private:
+    static void writePoint(FrameWriter& writer, const NavigationPoint& point) {
+        writer.append("<Items>\n")
+              .element("MapId", point.mapId, INDENT)
+              .element("Value", point.value, INDENT)
+              .element("PosX", point.posX, INDENT)
+              .element("PosY", point.posY, INDENT)
+              .element("PosZ", point.posZ, INDENT)
+              .element("AngleYaw", point.angleYaw, INDENT)
+              .element("PointInfo", point.pointInfo, INDENT)
+              .element("Gait", point.gait, INDENT)
+              .element("Speed", point.speed, INDENT)
+              .element("Manner", point.manner, INDENT)
+              .element("ObsMode", point.obsMode, INDENT)
+              .element("NavMode", point.navMode, INDENT)
+              .element("Terrain", point.terrain, INDENT)
+              .element("Posture", point.posture, INDENT)
+              .append("</Items>\n");
+    }
+
+    static constexpr std::string_view BODY_PREFIX =
+        "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<PatrolDevice>\n<Type>1003</Type>\n<Command>1</Command>\n";
+    static constexpr std::string_view BODY_SUFFIX = "</PatrolDevice>";
+    static constexpr std::string_view INDENT = "  ";
+
+    // 编码长度上限，用于一次性预留缓冲区
+    static constexpr size_t MAX_NUMBER_LENGTH = 24;       ///< 数值文本最长长度，如 "-1.2345678901234567e-308"
+    static constexpr size_t POINT_FIELD_COUNT = 14;       ///< 每个导航点的字段数
+    static constexpr size_t MAX_FIELD_NAME_LENGTH = 9;    ///< 最长的字段名 "PointInfo"
+    static constexpr size_t MAX_TIME_ELEMENT_SIZE = sizeof("<Time></Time>\n") - 1 + TIMESTAMP_LENGTH;
+    static constexpr size_t MAX_FIELD_SIZE =
+        INDENT.size() + sizeof("<></>\n") - 1 + 2 * MAX_FIELD_NAME_LENGTH + MAX_NUMBER_LENGTH;
+    static constexpr size_t MAX_POINT_SIZE = sizeof("<Items>\n</Items>\n") - 1 + POINT_FIELD_COUNT * MAX_FIELD_SIZE;
 };
 
 /**
@@ -244,6 +319,9 @@ public:
  */
 class NavigationTaskResponse : public MessageBase {
 public:
+    static constexpr MessageType MESSAGE_TYPE = MessageType::NAVIGATION_TASK_RESP;
+    static constexpr int WIRE_TYPE = 1003;
+
     int value = 0;
     ErrorCode_Navigation errorCode = ErrorCode_Navigation::SUCCESS;
     int errorStatus = 0;
@@ -251,46 +329,23 @@ public:
     NavigationTaskResponse() {}
 
     MessageType getType() const override {
-        return MessageType::NAVIGATION_TASK_RESP;
+        return MESSAGE_TYPE;
     }
 
-    std::string serialize() const override {
+    void serialize(FrameWriter&) const override {
         // sdk不负责响应的序列化
-        return "";
     }
 
-    bool deserialize(const std::string& data) override {
+    bool deserialize(std::string_view data) override {
         try {
-            rapidxml::xml_document<> doc;
-            std::vector<char> buffer(data.begin(), data.end());
-            buffer.push_back('\0');
-            doc.parse<rapidxml::parse_non_destructive>(&buffer[0]);
-
-            rapidxml::xml_node<>* root = doc.first_node("PatrolDevice");
-            if (!root) return false;
-
-            rapidxml::xml_node<>* items_node = root->first_node("Items");
-            if (!items_node) return false;
-
-            // 解析各个字段
-            auto get_node_value = [&](const char* name, auto& value) {
-                rapidxml::xml_node<>* node = items_node->first_node(name);
-                if (node) {
-                    std::stringstream ss(node->value());
-                    ss >> value;
+            return scanItems(data, [this](std::string_view name, std::string_view text) {
+                switch (tagHash(name)) {
+                    case tagHash("Value"):       setField(name, "Value", text, value); break;
+                    case tagHash("ErrorCode"):   setEnumField(name, "ErrorCode", text, errorCode); break;
+                    case tagHash("ErrorStatus"): setField(name, "ErrorStatus", text, errorStatus); break;
+                    default: break;
                 }
-            };
-
-            get_node_value("Value", value);
-
-            // 解析错误码
-            int error_code_value = 0;
-            get_node_value("ErrorCode", error_code_value);
-            errorCode = static_cast<ErrorCode_Navigation>(error_code_value);
-
-            get_node_value("ErrorStatus", errorStatus);
-
-            return true;
+            });
         } catch (const std::exception& e) {
             return false;
         }
@@ -300,31 +355,14 @@ public:
 /**
  * @brief 查询任务状态请求
  */
-class QueryStatusRequest : public MessageBase {
+class QueryStatusRequest : public FixedBodyRequest<QueryStatusRequest> {
 public:
-    std::string timestamp;
-
-    QueryStatusRequest() : timestamp(getCurrentTimestamp()) {}
+    static constexpr std::string_view TYPE_CODE = "1007";
+    static constexpr MessageType MESSAGE_TYPE = MessageType::QUERY_STATUS_REQ;
+    static constexpr int WIRE_TYPE = 1007;
 
     MessageType getType() const override {
-        return MessageType::QUERY_STATUS_REQ;
-    }
-
-    std::string serialize() const override {
-        // 使用XML格式
-        std::stringstream ss;
-        ss << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n";
-        ss << "<PatrolDevice>\n";
-        ss << "<Type>1007</Type>\n";
-        ss << "<Command>1</Command>\n";
-        ss << "<Time>" << timestamp << "</Time>\n";
-        ss << "<Items/>\n";
-        ss << "</PatrolDevice>";
-        return ss.str();
-    }
-
-    bool deserialize(const std::string&) override {
-        return false;
+        return MESSAGE_TYPE;
     }
 };
 
@@ -333,6 +371,9 @@ public:
  */
 class QueryStatusResponse : public MessageBase {
 public:
+    static constexpr MessageType MESSAGE_TYPE = MessageType::QUERY_STATUS_RESP;
+    static constexpr int WIRE_TYPE = 1007;
+
     int value = 0;
     int status = 0;
     ErrorCode_QueryStatus errorCode = ErrorCode_QueryStatus::COMPLETED;
@@ -340,47 +381,23 @@ public:
     QueryStatusResponse() {}
 
     MessageType getType() const override {
-        return MessageType::QUERY_STATUS_RESP;
+        return MESSAGE_TYPE;
     }
 
-    std::string serialize() const override {
+    void serialize(FrameWriter&) const override {
         // sdk不负责响应的序列化
-        return "";
     }
 
-    bool deserialize(const std::string& data) override {
+    bool deserialize(std::string_view data) override {
         try {
-            rapidxml::xml_document<> doc;
-            std::vector<char> buffer(data.begin(), data.end());
-            buffer.push_back('\0');
-            doc.parse<rapidxml::parse_non_destructive>(&buffer[0]);
-
-            rapidxml::xml_node<>* root = doc.first_node("PatrolDevice");
-            if (!root) return false;
-
-            rapidxml::xml_node<>* items_node = root->first_node("Items");
-            if (!items_node) return false;
-
-            // 解析各个字段
-            auto get_node_value = [&](const char* name, auto& value) {
-                rapidxml::xml_node<>* node = items_node->first_node(name);
-                if (node) {
-                    std::stringstream ss(node->value());
-                    ss >> value;
+            return scanItems(data, [this](std::string_view name, std::string_view text) {
+                switch (tagHash(name)) {
+                    case tagHash("Value"):     setField(name, "Value", text, value); break;
+                    case tagHash("Status"):    setField(name, "Status", text, status); break;
+                    case tagHash("ErrorCode"): setEnumField(name, "ErrorCode", text, errorCode); break;
+                    default: break;
                 }
-            };
-
-            get_node_value("Value", value);
-
-            // 解析状态
-            get_node_value("Status", status);
-
-            // 解析错误码
-            int error_code_value = 0;
-            get_node_value("ErrorCode", error_code_value);
-            errorCode = static_cast<ErrorCode_QueryStatus>(error_code_value);
-
-            return true;
+            });
         } catch (const std::exception& e) {
             return false;
         }
@@ -390,31 +407,14 @@ public:
 /**
  * @brief 取消任务请求
  */
-class CancelTaskRequest : public MessageBase {
+class CancelTaskRequest : public FixedBodyRequest<CancelTaskRequest> {
 public:
-    std::string timestamp;
-
-    CancelTaskRequest() : timestamp(getCurrentTimestamp()) {}
+    static constexpr std::string_view TYPE_CODE = "1004";
+    static constexpr MessageType MESSAGE_TYPE = MessageType::CANCEL_TASK_REQ;
+    static constexpr int WIRE_TYPE = 1004;
 
     MessageType getType() const override {
-        return MessageType::CANCEL_TASK_REQ;
-    }
-
-    std::string serialize() const override {
-        // 使用XML格式
-        std::stringstream ss;
-        ss << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n";
-        ss << "<PatrolDevice>\n";
-        ss << "<Type>1004</Type>\n";
-        ss << "<Command>1</Command>\n";
-        ss << "<Time>" << timestamp << "</Time>\n";
-        ss << "<Items/>\n";
-        ss << "</PatrolDevice>";
-        return ss.str();
-    }
-
-    bool deserialize(const std::string&) override {
-        return false;
+        return MESSAGE_TYPE;
     }
 };
 
@@ -423,42 +423,26 @@ public:
  */
 class CancelTaskResponse : public MessageBase {
 public:
+    static constexpr MessageType MESSAGE_TYPE = MessageType::CANCEL_TASK_RESP;
+    static constexpr int WIRE_TYPE = 1004;
+
     ErrorCode_CancelTask errorCode = ErrorCode_CancelTask::SUCCESS;
 
     CancelTaskResponse() {}
 
     MessageType getType() const override {
-        return MessageType::CANCEL_TASK_RESP;
+        return MESSAGE_TYPE;
     }
 
-    std::string serialize() const override {
+    void serialize(FrameWriter&) const override {
         // sdk不负责响应的序列化
-        return "";
     }
 
-    bool deserialize(const std::string& data) override {
+    bool deserialize(std::string_view data) override {
         try {
-            rapidxml::xml_document<> doc;
-            std::vector<char> buffer(data.begin(), data.end());
-            buffer.push_back('\0');
-            doc.parse<rapidxml::parse_non_destructive>(&buffer[0]);
-
-            rapidxml::xml_node<>* root = doc.first_node("PatrolDevice");
-            if (!root) return false;
-
-            rapidxml::xml_node<>* items_node = root->first_node("Items");
-            if (!items_node) return false;
-
-            // 解析错误码
-            int error_code_value = 0;
-            rapidxml::xml_node<>* error_code_node = items_node->first_node("ErrorCode");
-            if (error_code_node) {
-                std::stringstream ss(error_code_node->value());
-                ss >> error_code_value;
-                errorCode = static_cast<ErrorCode_CancelTask>(error_code_value);
-            }
-
-            return true;
+            return scanItems(data, [this](std::string_view name, std::string_view text) {
+                setEnumField(name, "ErrorCode", text, errorCode);
+            });
         } catch (const std::exception& e) {
             return false;
         }
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <limits>
+#include <locale>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+
+/**
+ * @brief 标准库是否提供浮点数版本的 std::from_chars/std::to_chars
+ *
+ * 整数版本自 libstdc++ 8、libc++ 7、MSVC 2017 15.8 起可用；浮点数版本要求 libstdc++ 11、
+ * MSVC 2019 16.4，libc++（Apple clang）直到很新的版本才提供。不可用时浮点数退化为
+ * 固定 "C" locale 的流转换，结果与 std::from_chars/std::to_chars 一致但速度较慢。
+ * 可在编译时定义为 0 强制使用退化实现。
+ */
+#ifndef X30_HAS_FLOAT_CHARCONV
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+#define X30_HAS_FLOAT_CHARCONV 1
+#else
+#define X30_HAS_FLOAT_CHARCONV 0
+#endif
+#endif
+
+namespace protocol {
+
+/**
+ * @brief 将文本解析为数值，忽略首尾空白与一个前导 '+'，不依赖 locale
+ * @param text 文本
+ * @param value 输出数值，解析失败时保持不变
+ * @return 是否解析成功
+ * @note 与旧的 stringstream >> 行为保持一致：只要求文本以合法数值开头，并接受 "+3" 这样的写法
+ *       （std::from_chars 本身不接受前导 '+'）
+ */
+template <typename T>
+inline bool parseNumber(std::string_view text, T& value) {
+    constexpr std::string_view WHITESPACE = " \t\r\n";
+    const size_t first = text.find_first_not_of(WHITESPACE);
+    if (first == std::string_view::npos) {
+        return false;
+    }
+    text = text.substr(first, text.find_last_not_of(WHITESPACE) - first + 1);
+
+    if (text.size() > 1 && text[0] == '+' && text[1] != '-' && text[1] != '+') {
+        text.remove_prefix(1);
+    }
+
+    T result{};
+    if constexpr (std::is_floating_point_v<T>) {
+#if X30_HAS_FLOAT_CHARCONV
+        auto r = std::from_chars(text.data(), text.data() + text.size(), result, std::chars_format::general);
+        if (r.ec != std::errc()) {
+            return false;
+        }
+#else
+        std::istringstream stream{std::string(text)};
+        stream.imbue(std::locale::classic());
+        if (!(stream >> result)) {
+            return false;
+        }
+#endif
+    } else {
+        auto r = std::from_chars(text.data(), text.data() + text.size(), result);
+        if (r.ec != std::errc()) {
+            return false;
+        }
+    }
+
+    value = result;
+    return true;
+}
+
+/**
+ * @brief 把数值格式化为最短的可往返文本，不依赖 locale，不分配内存（浮点退化实现除外）
+ * @param first 输出缓冲区起始地址
+ * @param last 输出缓冲区结束地址，至少需要 32 字节
+ * @param value 数值
+ * @return 写入文本的结束位置
+ */
+template <typename T>
+inline char* formatNumber(char* first, char* last, T value) {
+    if constexpr (std::is_floating_point_v<T>) {
+#if X30_HAS_FLOAT_CHARCONV
+        return std::to_chars(first, last, value).ptr;
+#else
+        // 依次尝试 15~17 位有效数字，取第一个能解析回原值的表示，与 std::to_chars 的最短表示一致
+        std::string text;
+        for (int precision = std::numeric_limits<T>::digits10; precision <= std::numeric_limits<T>::max_digits10; ++precision) {
+            std::ostringstream stream;
+            stream.imbue(std::locale::classic());
+            stream.precision(precision);
+            stream << value;
+            text = stream.str();
+
+            T parsed{};
+            if (parseNumber(text, parsed) && parsed == value) {
+                break;
+            }
+        }
+
+        const size_t size = std::min(text.size(), static_cast<size_t>(last - first));
+        std::memcpy(first, text.data(), size);
+        return first + size;
+#endif
+    } else {
+        return std::to_chars(first, last, value).ptr;
+    }
+}
+
+} // namespace protocol
@@ -1,8 +1,11 @@
 #include "serializer.hpp"
+#include "common/logging.hpp"
 #include <nlohmann/json.hpp>
-#include <rapidxml/rapidxml.hpp>
-#include <iostream>
 #include "protocol_header.hpp"
+#include "messages.hpp"
+#include "message_registry.hpp"
+#include "frame_writer.hpp"
+#include "xml_scanner.hpp"
 
 namespace protocol {
 
@@ -11,7 +14,7 @@ std::unique_ptr<IMessage> Serializer::deserializeMessage(const std::string& data
         // 检查数据长度是否足够包含协议头
         constexpr size_t HEADER_SIZE = sizeof(ProtocolHeader);
         if (data.size() < HEADER_SIZE) {
-            std::cerr << "数据长度不足以包含协议头" << std::endl;
+            LOG_ERROR("数据长度不足以包含协议头");
             return nullptr;
         }
 
@@ -20,7 +23,7 @@ std::unique_ptr<IMessage> Serializer::deserializeMessage(const std::string& data
 
         // 验证同步字节
         if (!header->validateSyncBytes()) {
-            std::cerr << "协议头同步字节无效" << std::endl;
+            LOG_ERROR("协议头同步字节无效");
             return nullptr;
         }
 
@@ -29,15 +32,28 @@ std::unique_ptr<IMessage> Serializer::deserializeMessage(const std::string& data
 
         // 检查数据长度是否足够
         if (data.size() < HEADER_SIZE + body_size) {
-            std::cerr << "数据长度不足: 期望 " << (HEADER_SIZE + body_size) << ", 实际 " << data.size() << std::endl;
+            LOG_ERROR("数据长度不足: 期望 " << (HEADER_SIZE + body_size) << ", 实际 " << data.size());
             return nullptr;
         }
 
-        // 提取消息体
+        // 提取消息体，拷贝一份以保证消息体以 '\0' 结尾
         std::string message_body = data.substr(HEADER_SIZE, body_size);
 
+        Frame frame;
+        frame.sequenceNumber = header->sequenceNumber;
+        frame.body = message_body;
+
+        return deserializeFrame(frame);
+    } catch (const std::exception& e) {
+        LOG_ERROR("解析数据异常: " << e.what());
+        return nullptr;
+    }
+}
+
+std::unique_ptr<IMessage> Serializer::deserializeFrame(const Frame& frame) {
+    try {
         // 提取消息类型
-        MessageType type = extractMessageType(message_body);
+        MessageType type = extractMessageType(frame.body);
 
         // 创建对应类型的消息对象
         auto message = createMessage(type);
@@ -46,122 +62,80 @@ std::unique_ptr<IMessage> Serializer::deserializeMessage(const std::string& data
         }
 
         // 反序列化消息
-        if (!message->deserialize(message_body)) {
-            std::cerr << "反序列化消息失败" << std::endl;
+        if (!message->deserialize(frame.body)) {
+            LOG_ERROR("反序列化消息失败");
             return nullptr;
         }
 
         // 设置消息序列号
-        message->setSequenceNumber(header->sequenceNumber);
+        message->setSequenceNumber(frame.sequenceNumber);
 
         return message;
     } catch (const std::exception& e) {
-        std::cerr << "解析数据异常: " << e.what() << std::endl;
+        LOG_ERROR("解析数据异常: " << e.what());
         return nullptr;
     }
 }
 
 std::string Serializer::serializeMessage(const IMessage& message) {
-    // 获取消息体
-    std::string message_body = message.serialize();
-
-    // 创建协议头
-    ProtocolHeader header(message_body.size(), message.getSequenceNumber());
-
-    // 组合协议头和消息体
     std::string result;
-    constexpr size_t HEADER_SIZE = sizeof(ProtocolHeader);
-    result.reserve(HEADER_SIZE + message_body.size());
-    result.append(reinterpret_cast<const char*>(&header), HEADER_SIZE);
-    result.append(message_body);
-
+    if (!serializeMessage(message, result)) {
+        result.clear();
+    }
     return result;
 }
 
-MessageType Serializer::extractMessageType(const std::string& data) {
+bool Serializer::serializeMessage(const IMessage& message, std::string& out) {
+    // 协议头预留在缓冲区开头，消息体直接写在其后，写完后回填长度和序列号
+    FrameWriter writer(out);
+    message.serialize(writer);
+
+    if (!writer.finish(message.getSequenceNumber())) {
+        LOG_ERROR("消息体过长: " << writer.bodySize() << " 字节，超出协议长度上限");
+        return false;
+    }
+    return true;
+}
+
+MessageType Serializer::extractMessageType(std::string_view data) {
     try {
         // 检查数据是否为XML格式
-        if (data.find("<?xml") != std::string::npos || data.find("<PatrolDevice>") != std::string::npos) {
+        if (data.find("<?xml") != std::string_view::npos || data.find("<PatrolDevice>") != std::string_view::npos) {
             // 提取Type字段
             int type = extractTypeFromXml(data);
 
-            // 根据Type确定消息类型
-            return determineMessageType(type);
+            // 根据Type确定消息类型，由编译期注册表展开为比较链
+            return responseTypeForWire(type);
         }
 
         return MessageType::UNKNOWN;
     } catch (const std::exception& e) {
-        std::cerr << "提取消息类型异常: " << e.what() << std::endl;
+        LOG_ERROR("提取消息类型异常: " << e.what());
         return MessageType::UNKNOWN;
     }
 }
 
-int Serializer::extractTypeFromXml(const std::string& data) {
-    try {
-        rapidxml::xml_document<> doc;
-        // 创建一个可修改的数据副本，因为rapidxml会修改输入字符串
-        std::vector<char> buffer(data.begin(), data.end());
-        buffer.push_back('\0');
-
-        doc.parse<rapidxml::parse_non_destructive>(&buffer[0]);
-
-        // 获取根节点
-        rapidxml::xml_node<>* root = doc.first_node("PatrolDevice");
-        if (!root) {
-            return 0;
-        }
-
-        // 获取Type节点
-        rapidxml::xml_node<>* type_node = root->first_node("Type");
-        if (!type_node) {
-            return 0;
-        }
-
-        // 转换Type值为整数
-        return std::stoi(type_node->value());
-    } catch (const std::exception& e) {
-        std::cerr << "提取XML Type异常: " << e.what() << std::endl;
+int Serializer::extractTypeFromXml(std::string_view data) {
+    // 只扫描 <Type> 标签，不构建DOM；完整解析留给具体消息的 deserialize()，保证每帧只解析一次
+    std::string_view text;
+    if (!findElementText(data, "Type", text)) {
         return 0;
     }
-}
-
-int Serializer::extractCommandFromXml(const std::string& data) {
-    try {
-        rapidxml::xml_document<> doc;
-        // 创建一个可修改的数据副本
-        std::vector<char> buffer(data.begin(), data.end());
-        buffer.push_back('\0');
-
-        doc.parse<rapidxml::parse_non_destructive>(&buffer[0]);
 
-        // 获取根节点
-        rapidxml::xml_node<>* root = doc.first_node("PatrolDevice");
-        if (!root) {
-            return 0;
-        }
-
-        // 获取Command节点
-        rapidxml::xml_node<>* command_node = root->first_node("Command");
-        if (!command_node) {
-            return 0;
-        }
-
-        // 转换Command值为整数
-        return std::stoi(command_node->value());
-    } catch (const std::exception& e) {
-        std::cerr << "提取XML Command异常: " << e.what() << std::endl;
-        return 0;
-    }
+    int type = 0;
+    parseNumber(text, type);
+    return type;
 }
 
-MessageType Serializer::determineMessageType(int type) {
-    // 查找Type对应的消息类型
-    auto it = type_to_message_type_.find(type);
-    if (it == type_to_message_type_.end()) {
-        return MessageType::UNKNOWN;
+int Serializer::extractCommandFromXml(std::string_view data) {
+    std::string_view text;
+    if (!findElementText(data, "Command", text)) {
+        return 0;
     }
 
-    return it->second;
+    int command = 0;
+    parseNumber(text, command);
+    return command;
 }
 
 } // namespace protocol
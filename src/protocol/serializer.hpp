@@ -1,9 +1,10 @@
 #pragma once
 
 #include "message_interface.hpp"
+#include "frame_decoder.hpp"
 #include <memory>
 #include <string>
-#include <map>
+#include <string_view>
 
 namespace protocol {
 
@@ -23,55 +24,56 @@ public:
     ~Serializer() = default;
 
     /**
-     * @brief 解析接收到的数据
+     * @brief 解析接收到的一个完整帧（协议头 + 消息体）
      * @param data 接收到的数据
      * @return 解析出的消息对象
+     * @note 需要拷贝消息体以补齐结尾符，流式接收应使用 FrameDecoder + deserializeFrame()
      */
     std::unique_ptr<IMessage> deserializeMessage(const std::string& data);
 
+    /**
+     * @brief 解析由 FrameDecoder 切分出的完整帧
+     * @param frame 完整帧（协议头已校验），消息体在原缓冲区上解析，不做拷贝
+     * @return 解析出的消息对象，失败时返回nullptr
+     */
+    std::unique_ptr<IMessage> deserializeFrame(const Frame& frame);
+
     /**
      * @brief 序列化消息为发送数据
      * @param message 要发送的消息
-     * @return 序列化后的数据
+     * @return 序列化后的数据，消息体超出协议长度上限时返回空字符串
      */
     std::string serializeMessage(const IMessage& message);
 
+    /**
+     * @brief 将消息序列化到调用方提供的输出缓冲区（协议头 + 消息体一次写成）
+     * @param message 要发送的消息
+     * @param out 输出缓冲区，原有内容被覆盖，容量会被复用
+     * @return 消息体超出协议头 length 字段（uint16_t）的表示范围时返回 false
+     */
+    bool serializeMessage(const IMessage& message, std::string& out);
+
 private:
     /**
      * @brief 从数据中提取消息类型
      * @param data 接收到的数据
      * @return 消息类型
      */
-    MessageType extractMessageType(const std::string& data);
+    MessageType extractMessageType(std::string_view data);
 
     /**
-     * @brief 从XML数据中提取Type字段的值
+     * @brief 从XML数据中提取Type字段的值（仅扫描标签，不解析整个文档）
      * @param data XML数据
      * @return Type字段的值，如果提取失败则返回0
      */
-    int extractTypeFromXml(const std::string& data);
+    int extractTypeFromXml(std::string_view data);
 
     /**
      * @brief 从XML数据中提取Command字段的值
      * @param data XML数据
      * @return Command字段的值，如果提取失败则返回0
      */
-    int extractCommandFromXml(const std::string& data);
-
-    /**
-     * @brief 根据Type值确定消息类型
-     * @param type Type字段的值
-     * @return 消息类型
-     */
-    MessageType determineMessageType(int type);
-
-    // Type值到消息类型的映射
-    const std::map<int, MessageType> type_to_message_type_ = {
-        {1002, MessageType::GET_REAL_TIME_STATUS_RESP},
-        {1003, MessageType::NAVIGATION_TASK_RESP},
-        {1004, MessageType::CANCEL_TASK_RESP},
-        {1007, MessageType::QUERY_STATUS_RESP}
-    };
+    int extractCommandFromXml(std::string_view data);
 };
 
 } // namespace protocol
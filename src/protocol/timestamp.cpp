@@ -0,0 +1,53 @@
+#include "timestamp.hpp"
+#include <chrono>
+#include <ctime>
+
+namespace protocol {
+
+namespace {
+
+/**
+ * @brief 线程内的时间戳缓存，只有跨秒时才重新格式化
+ */
+struct TimestampCache {
+    std::time_t second = -1;
+    char text[TIMESTAMP_LENGTH + 1] = "0000-00-00 00:00:00";
+};
+
+/**
+ * @brief 以固定宽度写入十进制数字，不足补零
+ */
+void writeDigits(char* out, int value, int width) {
+    for (int i = width - 1; i >= 0; --i) {
+        out[i] = static_cast<char>('0' + value % 10);
+        value /= 10;
+    }
+}
+
+} // namespace
+
+std::string_view currentTimestampView() {
+    thread_local TimestampCache cache;
+
+    const std::time_t now = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+    if (now != cache.second) {
+        std::tm local{};
+#ifdef _WIN32
+        localtime_s(&local, &now);
+#else
+        localtime_r(&now, &local);
+#endif
+        // "YYYY-MM-DD HH:MM:SS"，分隔符已在初始化时写好，只需填入数字
+        writeDigits(cache.text, local.tm_year + 1900, 4);
+        writeDigits(cache.text + 5, local.tm_mon + 1, 2);
+        writeDigits(cache.text + 8, local.tm_mday, 2);
+        writeDigits(cache.text + 11, local.tm_hour, 2);
+        writeDigits(cache.text + 14, local.tm_min, 2);
+        writeDigits(cache.text + 17, local.tm_sec, 2);
+        cache.second = now;
+    }
+
+    return std::string_view(cache.text, TIMESTAMP_LENGTH);
+}
+
+} // namespace protocol
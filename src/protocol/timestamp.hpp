@@ -0,0 +1,21 @@
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+
+namespace protocol {
+
+/**
+ * @brief 协议时间戳长度，格式固定为 "YYYY-MM-DD HH:MM:SS"
+ */
+constexpr size_t TIMESTAMP_LENGTH = 19;
+
+/**
+ * @brief 获取当前本地时间的时间戳文本
+ * @return 长度为 TIMESTAMP_LENGTH 的时间戳视图
+ * @note 每个线程缓存一份文本，同一秒内重复调用不再格式化；视图在同一线程下一次调用前有效。
+ *       使用 localtime_r/localtime_s，线程安全
+ */
+std::string_view currentTimestampView();
+
+} // namespace protocol
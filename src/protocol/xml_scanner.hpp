@@ -0,0 +1,221 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+namespace protocol {
+
+/**
+ * @brief 在XML文本中查找第一个指定名称元素的文本内容，不构建DOM
+ * @param xml XML文本
+ * @param name 元素名称（不含尖括号）
+ * @param text 输出的元素文本视图
+ * @return 找到 <name>...</name> 时返回 true
+ * @note 仅适用于协议中不带属性、不含子元素的简单字段，例如 <Type>1002</Type>
+ */
+inline bool findElementText(std::string_view xml, std::string_view name, std::string_view& text) {
+    size_t pos = 0;
+    while ((pos = xml.find(name, pos)) != std::string_view::npos) {
+        const size_t open = pos;
+        pos += name.size();
+
+        // 必须是完整的开始标签 <name>
+        if (open == 0 || xml[open - 1] != '<' || pos >= xml.size() || xml[pos] != '>') {
+            continue;
+        }
+
+        const size_t begin = pos + 1;
+        const size_t end = xml.find("</", begin);
+        if (end == std::string_view::npos) {
+            return false;
+        }
+
+        text = xml.substr(begin, end - begin);
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief 判断字符是否结束元素名
+ */
+constexpr bool isNameTerminator(char c) {
+    return c == '>' || c == '/' || c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+/**
+ * @brief 从 from 开始向后查找已打开元素 name 对应的结束标签 </name>
+ * @param xml XML文本
+ * @param name 元素名称（不含尖括号）
+ * @param from 开始标签之后的位置
+ * @return 结束标签中 '<' 的位置，未找到返回 npos
+ * @note 按深度匹配，内部嵌套的同名元素不会被当作结束标签
+ */
+inline size_t findClosingTag(std::string_view xml, std::string_view name, size_t from) {
+    size_t depth = 1;
+    size_t pos = from;
+    // 只在元素名出现的位置检查前后字符，比逐个检查 '<' 少得多
+    while ((pos = xml.find(name, pos)) != std::string_view::npos) {
+        const size_t name_end = pos + name.size();
+        if (name_end >= xml.size()) {
+            return std::string_view::npos;
+        }
+
+        if (pos >= from + 2 && xml[pos - 1] == '/' && xml[pos - 2] == '<') {
+            if (xml[name_end] == '>' && --depth == 0) {
+                return pos - 2;
+            }
+        } else if (pos >= from + 1 && xml[pos - 1] == '<' && isNameTerminator(xml[name_end])) {
+            // 同名子元素，自闭合的不改变深度
+            const size_t tag_end = xml.find('>', name_end);
+            if (tag_end == std::string_view::npos) {
+                return std::string_view::npos;
+            }
+            if (xml[tag_end - 1] != '/') {
+                ++depth;
+            }
+        }
+        pos = name_end;
+    }
+    return std::string_view::npos;
+}
+
+/**
+ * @brief 查找指定元素开始标签与结束标签之间的内容
+ * @param xml XML文本
+ * @param name 元素名称（不含尖括号）
+ * @param body 输出的元素内容视图，自闭合元素 <name/> 输出空视图
+ * @return 找到完整元素时返回 true
+ * @note 结束标签从开始标签向后按深度匹配，不受文本中其他位置同名元素的影响
+ */
+inline bool findElementBody(std::string_view xml, std::string_view name, std::string_view& body) {
+    size_t pos = 0;
+    while ((pos = xml.find(name, pos)) != std::string_view::npos) {
+        const size_t open = pos;
+        pos += name.size();
+
+        if (open == 0 || xml[open - 1] != '<' || pos >= xml.size()) {
+            continue;
+        }
+
+        // 自闭合元素 <name/>
+        if (xml[pos] == '/' && pos + 1 < xml.size() && xml[pos + 1] == '>') {
+            body = std::string_view();
+            return true;
+        }
+
+        if (xml[pos] != '>') {
+            continue;
+        }
+
+        const size_t begin = pos + 1;
+        const size_t close = findClosingTag(xml, name, begin);
+        if (close == std::string_view::npos) {
+            return false;
+        }
+
+        body = xml.substr(begin, close - begin);
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief 单遍扫描扁平的元素序列 <A>1</A><B>2</B>...，按出现顺序回调元素名与文本
+ * @param xml 元素序列文本，通常是 findElementBody() 取出的容器内容
+ * @param handler 回调，签名为 void(std::string_view name, std::string_view text)
+ * @return 文本格式正确时返回 true
+ * @note 不分配内存，不构建DOM；含有子元素的元素整体跳过，自闭合元素以空文本回调。
+ *       字段之间的距离都很短，逐字节前进比反复调用 find()/memchr() 的开销更低
+ */
+template <typename Handler>
+bool forEachElement(std::string_view xml, Handler&& handler) {
+    const char* p = xml.data();
+    const char* const end = p + xml.size();
+
+    auto skipTo = [end](const char* it, char c) {
+        while (it != end && *it != c) {
+            ++it;
+        }
+        return it;
+    };
+
+    while ((p = skipTo(p, '<')) != end) {
+        const char* name_begin = p + 1;
+        if (name_begin == end) {
+            return false;
+        }
+
+        // 跳过注释、处理指令等非元素节点
+        if (*name_begin == '!' || *name_begin == '?') {
+            p = skipTo(name_begin, '>');
+            if (p == end) {
+                return false;
+            }
+            continue;
+        }
+
+        const char* name_end = name_begin;
+        while (name_end != end && !isNameTerminator(*name_end)) {
+            ++name_end;
+        }
+
+        const char* tag_end = skipTo(name_end, '>');
+        if (tag_end == end || name_end == name_begin) {
+            return false;
+        }
+
+        const std::string_view name(name_begin, static_cast<size_t>(name_end - name_begin));
+
+        // 自闭合元素 <name/>
+        if (*(tag_end - 1) == '/') {
+            handler(name, std::string_view());
+            p = tag_end + 1;
+            continue;
+        }
+
+        const char* text_begin = tag_end + 1;
+        const char* text_end = skipTo(text_begin, '<');
+        if (text_end == end || text_end + 1 == end) {
+            return false;
+        }
+
+        if (*(text_end + 1) != '/') {
+            // 含有子元素，整体跳过到对应的结束标签之后
+            const size_t close = findClosingTag(xml, name, static_cast<size_t>(text_end - xml.data()));
+            if (close == std::string_view::npos) {
+                return false;
+            }
+            p = xml.data() + close + name.size() + 3;
+            continue;
+        }
+
+        // 结束标签必须与开始标签完全匹配：</name>
+        const char* close_name = text_end + 2;
+        if (static_cast<size_t>(end - close_name) <= name.size() ||
+            std::string_view(close_name, name.size()) != name || close_name[name.size()] != '>') {
+            return false;
+        }
+
+        handler(name, std::string_view(text_begin, static_cast<size_t>(text_end - text_begin)));
+        p = close_name + name.size() + 1;
+    }
+    return true;
+}
+
+/**
+ * @brief 编译期可求值的标签名哈希（FNV-1a），用于按标签名 switch 分派
+ * @param name 标签名
+ * @return 哈希值
+ * @note 不同字段的哈希在 switch 中重复会直接编译失败；运行时仍需比较名称以排除未知标签的碰撞
+ */
+constexpr uint32_t tagHash(std::string_view name) {
+    uint32_t hash = 2166136261u;
+    for (char c : name) {
+        hash ^= static_cast<uint8_t>(c);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+} // namespace protocol
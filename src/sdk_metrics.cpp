@@ -0,0 +1,131 @@
+#include "sdk_metrics.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+namespace robotserver_sdk {
+
+namespace {
+
+/**
+ * @brief 导出的直方图边界；边界固定，不随样本变化，便于 histogram_quantile 跨时间聚合
+ */
+struct BucketBound {
+    const char* text;      ///< le 标签（秒）
+    int64_t micros;        ///< 边界（微秒）
+};
+
+const BucketBound BUCKET_BOUNDS[] = {
+    {"0.0001", 100}, {"0.00025", 250}, {"0.0005", 500}, {"0.001", 1000}, {"0.0025", 2500},
+    {"0.005", 5000}, {"0.01", 10000}, {"0.025", 25000}, {"0.05", 50000}, {"0.1", 100000},
+    {"0.25", 250000}, {"0.5", 500000}, {"1", 1000000}, {"2.5", 2500000}, {"5", 5000000},
+    {"10", 10000000}, {"30", 30000000}, {"60", 60000000}, {"300", 300000000}, {"1800", 1800000000}
+};
+
+/**
+ * @brief 拼接标签：额外标签在前，固有标签在后
+ */
+std::string joinLabels(const std::string& labels, const std::string& own) {
+    if (labels.empty()) {
+        return own;
+    }
+    if (own.empty()) {
+        return labels;
+    }
+    return labels + "," + own;
+}
+
+void appendSample(std::string& out, const char* name, const std::string& labels, const std::string& value) {
+    out += name;
+    if (!labels.empty()) {
+        out += '{';
+        out += labels;
+        out += '}';
+    }
+    out += ' ';
+    out += value;
+    out += '\n';
+}
+
+void appendCounter(std::string& out, const char* name, const char* help, const std::string& labels, uint64_t value) {
+    out += "# HELP ";
+    out += name;
+    out += ' ';
+    out += help;
+    out += "\n# TYPE ";
+    out += name;
+    out += " counter\n";
+    appendSample(out, name, labels, std::to_string(value));
+}
+
+std::string formatSeconds(std::chrono::microseconds value) {
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%.6f", static_cast<double>(value.count()) / 1e6);
+    return buffer;
+}
+
+void appendHistogram(std::string& out, const std::string& labels, const char* type, const LatencySnapshot& latency) {
+    const std::string own = joinLabels(labels, std::string("type=\"") + type + "\"");
+
+    uint64_t cumulative = 0;
+    size_t next = 0;
+    for (const auto& bound : BUCKET_BOUNDS) {
+        while (next < latency.buckets.size() && latency.buckets[next].first.count() <= bound.micros) {
+            cumulative += latency.buckets[next].second;
+            ++next;
+        }
+        appendSample(out, "x30_sdk_request_duration_seconds_bucket", own + ",le=\"" + bound.text + "\"",
+                     std::to_string(cumulative));
+    }
+    appendSample(out, "x30_sdk_request_duration_seconds_bucket", own + ",le=\"+Inf\"", std::to_string(latency.count));
+    appendSample(out, "x30_sdk_request_duration_seconds_sum", own, formatSeconds(latency.sum));
+    appendSample(out, "x30_sdk_request_duration_seconds_count", own, std::to_string(latency.count));
+}
+
+} // namespace
+
+std::chrono::microseconds LatencySnapshot::percentile(double quantile) const {
+    if (count == 0) {
+        return std::chrono::microseconds::zero();
+    }
+
+    if (quantile < 0.0) {
+        quantile = 0.0;
+    } else if (quantile > 1.0) {
+        quantile = 1.0;
+    }
+
+    // 第 rank 个样本（从 1 开始）所在的桶
+    const auto rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(quantile * static_cast<double>(count))));
+    uint64_t seen = 0;
+    for (const auto& bucket : buckets) {
+        seen += bucket.second;
+        if (seen >= rank) {
+            return std::min(bucket.first, max);
+        }
+    }
+    return max;
+}
+
+std::string toPrometheusText(const MetricsSnapshot& snapshot, const std::string& labels) {
+    std::string out;
+    out.reserve(8192);
+
+    out += "# HELP x30_sdk_request_duration_seconds 从发出请求到收到响应的时间\n";
+    out += "# TYPE x30_sdk_request_duration_seconds histogram\n";
+    appendHistogram(out, labels, "1002", snapshot.latency1002);
+    appendHistogram(out, labels, "1003", snapshot.latency1003);
+    appendHistogram(out, labels, "1004", snapshot.latency1004);
+    appendHistogram(out, labels, "1007", snapshot.latency1007);
+
+    appendCounter(out, "x30_sdk_sent_bytes_total", "已写入 socket 的字节数", labels, snapshot.bytesSent);
+    appendCounter(out, "x30_sdk_received_bytes_total", "从 socket 读取的字节数", labels, snapshot.bytesReceived);
+    appendCounter(out, "x30_sdk_sent_frames_total", "进入发送队列的帧数", labels, snapshot.framesSent);
+    appendCounter(out, "x30_sdk_decoded_frames_total", "解码成功的帧数", labels, snapshot.framesDecoded);
+    appendCounter(out, "x30_sdk_decode_failures_total", "消息体无法解码的帧数", labels, snapshot.decodeFailures);
+    appendCounter(out, "x30_sdk_request_timeouts_total", "超过截止时间仍未收到响应的请求数", labels, snapshot.timeouts);
+    appendCounter(out, "x30_sdk_reconnects_total", "自动重连成功的次数", labels, snapshot.reconnects);
+    return out;
+}
+
+} // namespace robotserver_sdk
@@ -0,0 +1,199 @@
+#include "test_util.hpp"
+#include "protocol/frame_decoder.hpp"
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+
+using protocol::Frame;
+using protocol::FrameDecoder;
+using protocol::ProtocolHeader;
+
+struct DecodedFrame {
+    uint16_t sequenceNumber;
+    std::string body;
+};
+
+/**
+ * @brief 按协议格式编码一个完整帧
+ */
+std::string makeFrame(uint16_t sequenceNumber, const std::string& body) {
+    ProtocolHeader header(static_cast<uint16_t>(body.size()), sequenceNumber);
+    std::string frame(reinterpret_cast<const char*>(&header), sizeof(header));
+    return frame + body;
+}
+
+/**
+ * @brief 取出解码器中所有完整帧，并检查每个帧体之后的结尾符
+ */
+void drain(FrameDecoder& decoder, std::vector<DecodedFrame>& out) {
+    Frame frame;
+    while (decoder.next(frame)) {
+        TEST_CHECK(frame.body.data()[frame.body.size()] == '\0');
+        out.push_back({frame.sequenceNumber, std::string(frame.body)});
+    }
+}
+
+/**
+ * @brief 把数据按给定分段写入解码器，每段写入后立即取帧
+ */
+std::vector<DecodedFrame> feed(const std::string& stream, const std::vector<size_t>& cuts) {
+    FrameDecoder decoder(64);
+    std::vector<DecodedFrame> frames;
+
+    size_t pos = 0;
+    for (size_t cut : cuts) {
+        decoder.append(stream.data() + pos, cut - pos);
+        drain(decoder, frames);
+        pos = cut;
+    }
+    decoder.append(stream.data() + pos, stream.size() - pos);
+    drain(decoder, frames);
+    return frames;
+}
+
+bool sameFrames(const std::vector<DecodedFrame>& actual, const std::vector<DecodedFrame>& expected) {
+    if (actual.size() != expected.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < actual.size(); ++i) {
+        if (actual[i].sequenceNumber != expected[i].sequenceNumber || actual[i].body != expected[i].body) {
+            return false;
+        }
+    }
+    return true;
+}
+
+const std::string BODY_A = "<PatrolDevice><Type>1002</Type></PatrolDevice>";
+const std::string BODY_B = "<PatrolDevice><Type>1007</Type><Items><Value>3</Value></Items></PatrolDevice>";
+
+void testSingleFrame() {
+    auto frames = feed(makeFrame(7, BODY_A), {});
+    TEST_CHECK(sameFrames(frames, {{7, BODY_A}}));
+}
+
+void testSplitAtEveryOffset() {
+    const std::string stream = makeFrame(1, BODY_A) + makeFrame(2, BODY_B);
+    const std::vector<DecodedFrame> expected = {{1, BODY_A}, {2, BODY_B}};
+
+    for (size_t cut = 1; cut < stream.size(); ++cut) {
+        TEST_CHECK(sameFrames(feed(stream, {cut}), expected));
+    }
+    for (size_t first = 1; first < stream.size(); first += 7) {
+        for (size_t second = first + 1; second < stream.size(); second += 5) {
+            TEST_CHECK(sameFrames(feed(stream, {first, second}), expected));
+        }
+    }
+}
+
+void testByteByByte() {
+    const std::string stream = makeFrame(1, BODY_A) + makeFrame(2, BODY_B) + makeFrame(3, "");
+    std::vector<size_t> cuts;
+    for (size_t i = 1; i < stream.size(); ++i) {
+        cuts.push_back(i);
+    }
+    TEST_CHECK(sameFrames(feed(stream, cuts), {{1, BODY_A}, {2, BODY_B}, {3, ""}}));
+}
+
+void testBackToBackFrames() {
+    std::string stream;
+    std::vector<DecodedFrame> expected;
+    for (uint16_t seq = 0; seq < 200; ++seq) {
+        const std::string body = (seq % 2 ? BODY_A : BODY_B) + std::to_string(seq);
+        stream += makeFrame(seq, body);
+        expected.push_back({seq, body});
+    }
+    TEST_CHECK(sameFrames(feed(stream, {}), expected));
+    TEST_CHECK(sameFrames(feed(stream, {stream.size() / 3, stream.size() / 2}), expected));
+}
+
+void testGarbagePrefix() {
+    const std::string garbage = "junk\x01\x02\xeb\x00\x90garbage";
+    const std::string stream = garbage + makeFrame(5, BODY_A);
+
+    FrameDecoder decoder;
+    decoder.append(stream.data(), stream.size());
+    std::vector<DecodedFrame> frames;
+    drain(decoder, frames);
+    TEST_CHECK(sameFrames(frames, {{5, BODY_A}}));
+    TEST_CHECK(decoder.discardedBytes() == garbage.size());
+
+    for (size_t cut = 1; cut < stream.size(); ++cut) {
+        TEST_CHECK(sameFrames(feed(stream, {cut}), {{5, BODY_A}}));
+    }
+}
+
+void testHalfSyncWordPrefix() {
+    // 帧前残留半个同步字：EB 90 | EB 90 EB 90 ...，错位的候选头保留字段中含有序列号，应被排除
+    const std::string stream = std::string("\xeb\x90", 2) + makeFrame(0x1234, BODY_A) + makeFrame(9, BODY_B);
+    const std::vector<DecodedFrame> expected = {{0x1234, BODY_A}, {9, BODY_B}};
+
+    TEST_CHECK(sameFrames(feed(stream, {}), expected));
+    for (size_t cut = 1; cut < stream.size(); ++cut) {
+        TEST_CHECK(sameFrames(feed(stream, {cut}), expected));
+    }
+}
+
+void testFalseSyncInGarbage() {
+    // 无效数据中出现同步字，但其后的保留字段不为 0
+    std::string garbage("\xeb\x90\xeb\x90\x10\x00\x01\x00", 8);
+    garbage += "notzero!";
+    const std::string stream = garbage + makeFrame(3, BODY_B);
+    TEST_CHECK(sameFrames(feed(stream, {}), {{3, BODY_B}}));
+}
+
+void testLengthFieldLooksLikeSyncWord() {
+    // length = 0x90EB 时协议头以 EB 90 EB 90 EB 90 开头，不能误判为错位的同步字
+    const std::string body(0x90EB, 'x');
+    const std::string stream = makeFrame(11, body) + makeFrame(12, BODY_A);
+    const std::vector<DecodedFrame> expected = {{11, body}, {12, BODY_A}};
+
+    TEST_CHECK(sameFrames(feed(stream, {}), expected));
+    TEST_CHECK(sameFrames(feed(stream, {3, 6, 10, 17, 4096, 37000}), expected));
+}
+
+void testTerminatorRestored() {
+    // 帧体之后写入的结尾符覆盖的是下一帧的首字节，取下一帧前必须恢复
+    const std::string stream = makeFrame(1, BODY_A) + makeFrame(2, BODY_B);
+    FrameDecoder decoder;
+    decoder.append(stream.data(), stream.size());
+
+    Frame frame;
+    TEST_CHECK(decoder.next(frame));
+    TEST_CHECK(frame.body == BODY_A);
+    TEST_CHECK(decoder.next(frame));
+    TEST_CHECK(frame.sequenceNumber == 2 && frame.body == BODY_B);
+    TEST_CHECK(!decoder.next(frame));
+    TEST_CHECK(decoder.bufferedSize() == 0);
+}
+
+void testReset() {
+    const std::string stream = makeFrame(1, BODY_A);
+    FrameDecoder decoder;
+    decoder.append(stream.data(), stream.size() / 2);
+    decoder.reset();
+    decoder.append(stream.data(), stream.size());
+
+    std::vector<DecodedFrame> frames;
+    drain(decoder, frames);
+    TEST_CHECK(sameFrames(frames, {{1, BODY_A}}));
+}
+
+} // namespace
+
+int main() {
+    TEST_RUN(testSingleFrame);
+    TEST_RUN(testSplitAtEveryOffset);
+    TEST_RUN(testByteByByte);
+    TEST_RUN(testBackToBackFrames);
+    TEST_RUN(testGarbagePrefix);
+    TEST_RUN(testHalfSyncWordPrefix);
+    TEST_RUN(testFalseSyncInGarbage);
+    TEST_RUN(testLengthFieldLooksLikeSyncWord);
+    TEST_RUN(testTerminatorRestored);
+    TEST_RUN(testReset);
+
+    std::printf("%d 项检查失败\n", test::failureCount().load());
+    return test::failureCount().load() == 0 ? 0 : 1;
+}
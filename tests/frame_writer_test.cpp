@@ -0,0 +1,105 @@
+#include "test_util.hpp"
+#include "protocol/messages.hpp"
+#include "protocol/serializer.hpp"
+#include <string>
+#include <vector>
+
+namespace {
+
+using namespace protocol;
+
+std::string bodyOf(const std::string& frame) {
+    return frame.substr(FrameWriter::HEADER_SIZE);
+}
+
+void testTemplateMatchesFieldEncoding() {
+    Serializer serializer;
+
+    GetRealTimeStatusRequest templated;
+    templated.timestamp = "2024-05-20 12:34:56";
+    templated.setSequenceNumber(42);
+    std::string fromTemplate;
+    TEST_CHECK(serializer.serializeMessage(templated, fromTemplate));
+
+    std::string expected;
+    FrameWriter writer(expected);
+    writeFixedBody(writer, "1002", "2024-05-20 12:34:56");
+    TEST_CHECK(writer.finish(42));
+    TEST_CHECK(fromTemplate == expected);
+
+    // 非标准长度的时间戳走逐字段编码
+    CancelTaskRequest cancel;
+    cancel.timestamp = "now";
+    std::string fallback;
+    TEST_CHECK(serializer.serializeMessage(cancel, fallback));
+    TEST_CHECK(bodyOf(fallback).find("<Type>1004</Type>\n<Command>1</Command>\n<Time>now</Time>\n<Items/>") !=
+               std::string::npos);
+}
+
+void testTemplatePerType() {
+    Serializer serializer;
+    std::string status;
+    std::string query;
+    TEST_CHECK(serializer.serializeMessage(GetRealTimeStatusRequest(), status));
+    TEST_CHECK(serializer.serializeMessage(QueryStatusRequest(), query));
+    TEST_CHECK(bodyOf(status).find("<Type>1002</Type>") != std::string::npos);
+    TEST_CHECK(bodyOf(query).find("<Type>1007</Type>") != std::string::npos);
+}
+
+void testBodyLengthLimit() {
+    std::string out;
+    FrameWriter writer(out);
+    writer.append(std::string(65535, 'x'));
+    TEST_CHECK(writer.finish(1));
+    writer.append("y");
+    TEST_CHECK(!writer.finish(1));
+}
+
+void testSplitRoute() {
+    std::vector<NavigationPoint> points(2000);
+    for (size_t i = 0; i < points.size(); ++i) {
+        points[i].value = static_cast<int>(i);
+        points[i].mapId = 12345;
+        points[i].posX = -1234.5678 + static_cast<double>(i);
+        points[i].posY = 9876.54321;
+        points[i].angleYaw = 3.14159;
+    }
+
+    // 每段都能编码成一个合法的帧，且各段首尾相接覆盖全部导航点
+    Serializer serializer;
+    const auto chunks = NavigationTaskRequest::splitRoute(points);
+    TEST_CHECK(chunks.size() > 1);
+    size_t next = 0;
+    for (const auto& chunk : chunks) {
+        TEST_CHECK(chunk.first == next && chunk.second > chunk.first);
+        next = chunk.second;
+
+        NavigationTaskRequest request;
+        request.points.assign(points.begin() + static_cast<std::ptrdiff_t>(chunk.first),
+                              points.begin() + static_cast<std::ptrdiff_t>(chunk.second));
+        std::string frame;
+        TEST_CHECK(serializer.serializeMessage(request, frame));
+    }
+    TEST_CHECK(next == points.size());
+
+    // 每段点数上限
+    const auto capped = NavigationTaskRequest::splitRoute(points, 50);
+    TEST_CHECK(capped.size() == 40);
+    for (const auto& chunk : capped) {
+        TEST_CHECK(chunk.second - chunk.first == 50);
+    }
+
+    TEST_CHECK(NavigationTaskRequest::splitRoute({}).empty());
+}
+
+} // namespace
+
+int main() {
+    TEST_RUN(testTemplateMatchesFieldEncoding);
+    TEST_RUN(testTemplatePerType);
+    TEST_RUN(testBodyLengthLimit);
+    TEST_RUN(testSplitRoute);
+
+    std::printf("%d 项检查失败\n", test::failureCount().load());
+    return test::failureCount().load() == 0 ? 0 : 1;
+}
@@ -0,0 +1,135 @@
+#include "test_util.hpp"
+#include "common/latency_histogram.hpp"
+#include "sdk_metrics.h"
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using common::LatencyHistogram;
+using std::chrono::microseconds;
+
+void testBucketBounds() {
+    // 每个值都落在上界不小于它、上一个桶的上界小于它的桶中，相对误差不超过 1/16
+    for (uint64_t value : {0ull, 1ull, 15ull, 16ull, 17ull, 31ull, 32ull, 33ull, 1000ull, 123456ull,
+                           (1ull << 40), (1ull << 41) - 1}) {
+        const size_t index = LatencyHistogram::indexOf(value);
+        TEST_CHECK(index < LatencyHistogram::BUCKET_COUNT);
+        TEST_CHECK(LatencyHistogram::upperBoundOf(index) >= value);
+        TEST_CHECK(index == 0 || LatencyHistogram::upperBoundOf(index - 1) < value);
+        TEST_CHECK(LatencyHistogram::upperBoundOf(index) - value <= value / 16);
+    }
+
+    // 超出范围的值记入最后一个桶
+    TEST_CHECK(LatencyHistogram::indexOf(UINT64_MAX) == LatencyHistogram::BUCKET_COUNT - 1);
+
+    // 上界严格递增
+    for (size_t i = 1; i < LatencyHistogram::BUCKET_COUNT; ++i) {
+        TEST_CHECK(LatencyHistogram::upperBoundOf(i) > LatencyHistogram::upperBoundOf(i - 1));
+    }
+}
+
+robotserver_sdk::LatencySnapshot snapshotOf(const LatencyHistogram& histogram) {
+    robotserver_sdk::LatencySnapshot snapshot;
+    snapshot.count = histogram.count();
+    snapshot.sum = microseconds(histogram.sum());
+    snapshot.max = microseconds(histogram.max());
+    for (const auto& bucket : histogram.buckets()) {
+        snapshot.buckets.emplace_back(microseconds(bucket.first), bucket.second);
+    }
+    return snapshot;
+}
+
+void testPercentiles() {
+    // 1..10000us 均匀分布
+    LatencyHistogram histogram;
+    for (int i = 1; i <= 10000; ++i) {
+        histogram.record(microseconds(i));
+    }
+    TEST_CHECK(histogram.count() == 10000);
+    TEST_CHECK(histogram.max() == 10000);
+    TEST_CHECK(histogram.sum() == 10000ull * 10001 / 2);
+
+    const auto snapshot = snapshotOf(histogram);
+    const auto near = [](microseconds actual, int64_t expected) {
+        return actual.count() >= expected && actual.count() <= expected + expected / 16;
+    };
+    TEST_CHECK(near(snapshot.percentile(0.5), 5000));
+    TEST_CHECK(near(snapshot.percentile(0.99), 9900));
+    TEST_CHECK(snapshot.percentile(1.0).count() == 10000);
+    TEST_CHECK(snapshot.percentile(0.0).count() == 1);
+
+    TEST_CHECK(robotserver_sdk::LatencySnapshot().percentile(0.99).count() == 0);
+}
+
+void testConcurrentRecord() {
+    constexpr int THREADS = 4;
+    constexpr int SAMPLES = 100000;
+
+    LatencyHistogram histogram;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREADS; ++t) {
+        threads.emplace_back([&histogram, t]() {
+            for (int i = 0; i < SAMPLES; ++i) {
+                histogram.record(microseconds(t * 1000 + i % 1000));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    uint64_t total = 0;
+    for (const auto& bucket : histogram.buckets()) {
+        total += bucket.second;
+    }
+    TEST_CHECK(histogram.count() == THREADS * SAMPLES);
+    TEST_CHECK(total == THREADS * SAMPLES);
+    TEST_CHECK(histogram.max() == (THREADS - 1) * 1000 + 999);
+}
+
+void testPrometheusText() {
+    LatencyHistogram histogram;
+    histogram.record(microseconds(800));      // 落在 le="0.001"
+    histogram.record(microseconds(20000));    // 落在 le="0.025"
+
+    robotserver_sdk::MetricsSnapshot snapshot;
+    snapshot.latency1002 = snapshotOf(histogram);
+    snapshot.bytesSent = 123;
+    snapshot.timeouts = 4;
+
+    const std::string text = robotserver_sdk::toPrometheusText(snapshot, "robot=\"dog-01\"");
+    const auto contains = [&text](const std::string& line) {
+        return text.find(line + "\n") != std::string::npos;
+    };
+    TEST_CHECK(contains("# TYPE x30_sdk_request_duration_seconds histogram"));
+    TEST_CHECK(contains("x30_sdk_request_duration_seconds_bucket{robot=\"dog-01\",type=\"1002\",le=\"0.0005\"} 0"));
+    TEST_CHECK(contains("x30_sdk_request_duration_seconds_bucket{robot=\"dog-01\",type=\"1002\",le=\"0.001\"} 1"));
+    TEST_CHECK(contains("x30_sdk_request_duration_seconds_bucket{robot=\"dog-01\",type=\"1002\",le=\"0.025\"} 2"));
+    TEST_CHECK(contains("x30_sdk_request_duration_seconds_bucket{robot=\"dog-01\",type=\"1002\",le=\"+Inf\"} 2"));
+    TEST_CHECK(contains("x30_sdk_request_duration_seconds_count{robot=\"dog-01\",type=\"1002\"} 2"));
+    TEST_CHECK(contains("x30_sdk_request_duration_seconds_sum{robot=\"dog-01\",type=\"1002\"} 0.020800"));
+    TEST_CHECK(contains("x30_sdk_request_duration_seconds_count{robot=\"dog-01\",type=\"1007\"} 0"));
+    TEST_CHECK(contains("x30_sdk_sent_bytes_total{robot=\"dog-01\"} 123"));
+    TEST_CHECK(contains("x30_sdk_request_timeouts_total{robot=\"dog-01\"} 4"));
+
+    // 没有额外标签
+    const std::string bare = robotserver_sdk::toPrometheusText(snapshot);
+    TEST_CHECK(bare.find("x30_sdk_reconnects_total 0\n") != std::string::npos);
+    TEST_CHECK(bare.find("x30_sdk_request_duration_seconds_count{type=\"1002\"} 2\n") != std::string::npos);
+}
+
+} // namespace
+
+int main() {
+    TEST_RUN(testBucketBounds);
+    TEST_RUN(testPercentiles);
+    TEST_RUN(testConcurrentRecord);
+    TEST_RUN(testPrometheusText);
+
+    std::printf("%d 项检查失败\n", test::failureCount().load());
+    return test::failureCount().load() == 0 ? 0 : 1;
+}
@@ -0,0 +1,206 @@
+#include "test_util.hpp"
+#include "common/logging.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using robotserver_sdk::LogLevel;
+using robotserver_sdk::LogRecord;
+
+/**
+ * @brief 收集日志的输出目标；blocked 为 true 时 write() 阻塞，模拟卡住的终端
+ */
+class CollectingSink : public robotserver_sdk::LogSink {
+public:
+    void write(const LogRecord& record) override {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait(lock, [this]() { return !blocked_; });
+        records_.push_back(record);
+    }
+
+    void flush() override { ++flushes; }
+
+    void setBlocked(bool blocked) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            blocked_ = blocked;
+        }
+        cv_.notify_all();
+    }
+
+    std::vector<LogRecord> records() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return records_;
+    }
+
+    void clear() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        records_.clear();
+    }
+
+    std::atomic<int> flushes{0};
+
+private:
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    bool blocked_ = false;
+    std::vector<LogRecord> records_;
+};
+
+/**
+ * @brief 所有测试共用的输出目标，main() 中安装
+ */
+const std::shared_ptr<CollectingSink>& collectingSink() {
+    static const auto sink = std::make_shared<CollectingSink>();
+    return sink;
+}
+
+void logAtEveryLevel() {
+    LOG_TRACE("trace");
+    LOG_DEBUG("debug");
+    LOG_INFO("info");
+    LOG_WARN("warn " << 1);
+    LOG_ERROR("error " << 2 << ' ' << 3.5);
+}
+
+void testLevels() {
+    CollectingSink& sink = *collectingSink();
+    sink.clear();
+    robotserver_sdk::setLogLevel(LogLevel::Warning);
+    TEST_CHECK(robotserver_sdk::logLevel() == LogLevel::Warning);
+    logAtEveryLevel();
+    robotserver_sdk::flushLog();
+
+    const auto records = sink.records();
+    TEST_CHECK(records.size() == 2);
+    if (records.size() == 2) {
+        TEST_CHECK(records[0].level == LogLevel::Warning && records[0].message == "warn 1");
+        TEST_CHECK(records[1].level == LogLevel::Error && records[1].message == "error 2 3.5");
+        TEST_CHECK(records[1].line > 0 && std::string(records[1].file).find("logging_test") != std::string::npos);
+    }
+    TEST_CHECK(sink.flushes.load() > 0);
+
+    // 未启用的级别不求值参数
+    int evaluated = 0;
+    LOG_DEBUG("side effect " << ++evaluated);
+    TEST_CHECK(evaluated == 0);
+
+    robotserver_sdk::setLogLevel(LogLevel::Off);
+    logAtEveryLevel();
+    robotserver_sdk::flushLog();
+    TEST_CHECK(sink.records().size() == 2);
+    robotserver_sdk::setLogLevel(LogLevel::Info);
+}
+
+/**
+ * @brief 同一个日志位置
+ */
+void logBadFrame(int i) {
+    LOG_ERROR("bad frame " << i);
+}
+
+void testRateLimit() {
+    CollectingSink& sink = *collectingSink();
+    // 限流按秒划分窗口，从一秒的前半段开始，保证 100 条落在同一个窗口
+    while (std::chrono::duration_cast<std::chrono::milliseconds>(
+               std::chrono::steady_clock::now().time_since_epoch()).count() % 1000 > 500) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    sink.clear();
+    for (int i = 0; i < 100; ++i) {
+        logBadFrame(i);
+    }
+    robotserver_sdk::flushLog();
+    auto records = sink.records();
+    TEST_CHECK(records.size() == common::LogRateLimiter::BURST);
+
+    // 下一秒输出的第一条注明丢弃的条数
+    std::this_thread::sleep_for(std::chrono::milliseconds(1100));
+    sink.clear();
+    for (int i = 0; i < 2; ++i) {
+        logBadFrame(i);
+    }
+    robotserver_sdk::flushLog();
+    records = sink.records();
+    TEST_CHECK(records.size() == 2);
+    if (records.size() == 2) {
+        TEST_CHECK(records[0].suppressed == 100 - common::LogRateLimiter::BURST);
+        TEST_CHECK(records[1].suppressed == 0);
+        TEST_CHECK(robotserver_sdk::formatLogRecord(records[0]).find("90 条") != std::string::npos);
+    }
+}
+
+void testConcurrentProducers() {
+    CollectingSink& sink = *collectingSink();
+    constexpr int THREADS = 4;
+    constexpr int PER_THREAD = 1000;
+
+    sink.clear();
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREADS; ++t) {
+        threads.emplace_back([t]() {
+            for (int i = 0; i < PER_THREAD; ++i) {
+                common::submitLog(LogLevel::Info, __FILE__, __LINE__, std::to_string(t) + ":" + std::to_string(i), 0);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    robotserver_sdk::flushLog();
+
+    // 每个线程的日志都完整且保持顺序
+    std::map<int, int> next;
+    bool ordered = true;
+    const auto records = sink.records();
+    for (const auto& record : records) {
+        const auto colon = record.message.find(':');
+        const int t = std::stoi(record.message.substr(0, colon));
+        const int i = std::stoi(record.message.substr(colon + 1));
+        ordered = ordered && i == next[t];
+        next[t] = i + 1;
+    }
+    TEST_CHECK(records.size() == THREADS * PER_THREAD);
+    TEST_CHECK(ordered);
+}
+
+void testNeverBlocks() {
+    CollectingSink& sink = *collectingSink();
+    // 输出目标卡住时记录日志的线程不等待，队列满后丢弃并计数
+    sink.clear();
+    sink.setBlocked(true);
+    const uint64_t droppedBefore = robotserver_sdk::droppedLogCount();
+
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < 20000; ++i) {
+        common::submitLog(LogLevel::Info, __FILE__, __LINE__, "flood", 0);
+    }
+    TEST_CHECK(std::chrono::steady_clock::now() - start < std::chrono::seconds(2));
+    TEST_CHECK(robotserver_sdk::droppedLogCount() > droppedBefore);
+
+    sink.setBlocked(false);
+    robotserver_sdk::flushLog();
+    TEST_CHECK(sink.records().size() + (robotserver_sdk::droppedLogCount() - droppedBefore) == 20000);
+}
+
+} // namespace
+
+int main() {
+    robotserver_sdk::setLogSink(collectingSink());
+
+    TEST_RUN(testLevels);
+    TEST_RUN(testRateLimit);
+    TEST_RUN(testConcurrentProducers);
+    TEST_RUN(testNeverBlocks);
+
+    robotserver_sdk::setLogSink(std::make_shared<robotserver_sdk::ConsoleLogSink>());
+    std::printf("%d 项检查失败\n", test::failureCount().load());
+    return test::failureCount().load() == 0 ? 0 : 1;
+}
@@ -0,0 +1,111 @@
+#include "test_util.hpp"
+#include "protocol/message_pool.hpp"
+#include "protocol/messages.hpp"
+#include "protocol/serializer.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using namespace protocol;
+
+const std::string STATUS_BODY =
+    "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<PatrolDevice>\n<Type>1002</Type>\n<Command>1</Command>\n"
+    "<Time>2024-05-20 12:34:56</Time>\n<Items><MotionState>1</MotionState><PosX>1.5</PosX>"
+    "<Electricity>77</Electricity></Items>\n</PatrolDevice>";
+
+void testSteadyStateDecodeDoesNotAllocate() {
+    Serializer serializer;
+    Frame frame;
+    frame.sequenceNumber = 7;
+    frame.body = STATUS_BODY;
+
+    // 预热后解码—分发—释放的循环全部复用池中的块
+    for (int i = 0; i < 16; ++i) {
+        TEST_CHECK(serializer.deserializeFrame(frame) != nullptr);
+    }
+    const MessagePool::Stats before = MessagePool::stats();
+    for (int i = 0; i < 10000; ++i) {
+        auto message = serializer.deserializeFrame(frame);
+        TEST_CHECK(message && message->getSequenceNumber() == 7);
+    }
+    const MessagePool::Stats after = MessagePool::stats();
+    TEST_CHECK(after.heapAllocations == before.heapAllocations);
+    TEST_CHECK(after.reused - before.reused == 10000);
+}
+
+void testSizeClasses() {
+    // 同一级的块可以互相替代，超过上限的大小交给通用分配器
+    std::vector<std::pair<void*, size_t>> blocks;
+    for (size_t size : {1ul, 63ul, 64ul, 65ul, 200ul, 511ul, 512ul, 513ul, 4096ul}) {
+        void* block = MessagePool::allocate(size);
+        TEST_CHECK(block != nullptr);
+        TEST_CHECK(reinterpret_cast<uintptr_t>(block) % alignof(std::max_align_t) == 0);
+        std::memset(block, 0xAB, size);
+        blocks.emplace_back(block, size);
+    }
+    for (size_t i = 0; i < blocks.size(); ++i) {
+        for (size_t j = i + 1; j < blocks.size(); ++j) {
+            TEST_CHECK(blocks[i].first != blocks[j].first);
+        }
+    }
+    for (const auto& block : blocks) {
+        MessagePool::deallocate(block.first, block.second);
+    }
+
+    void* reused = MessagePool::allocate(100);
+    TEST_CHECK(reused == blocks[3].first);  // 65 与 100 字节同属 (64, 128] 一级
+    MessagePool::deallocate(reused, 100);
+    MessagePool::deallocate(nullptr, 100);
+}
+
+void testCrossThreadRelease() {
+    // 解码线程创建、调用方线程释放，池中保留的块数有上限
+    constexpr int ROUNDS = 200;
+    constexpr size_t BATCH = 64;
+    std::vector<std::unique_ptr<IMessage>> batch;
+    for (int round = 0; round < ROUNDS; ++round) {
+        std::thread producer([&]() {
+            for (size_t i = 0; i < BATCH; ++i) {
+                batch.push_back(createMessage(MessageType::QUERY_STATUS_RESP));
+            }
+        });
+        producer.join();
+
+        std::thread consumer([&]() {
+            batch.clear();
+        });
+        consumer.join();
+    }
+
+    const MessagePool::Stats stats = MessagePool::stats();
+    TEST_CHECK(stats.reused >= (ROUNDS - 1) * BATCH);
+
+    // 超出每级上限的块归还给系统
+    std::vector<std::unique_ptr<IMessage>> burst;
+    for (size_t i = 0; i < MessagePool::MAX_POOLED_BLOCKS * 2; ++i) {
+        burst.push_back(createMessage(MessageType::CANCEL_TASK_RESP));
+    }
+    burst.clear();
+    const uint64_t heapBefore = MessagePool::stats().heapAllocations;
+    for (size_t i = 0; i < MessagePool::MAX_POOLED_BLOCKS * 2; ++i) {
+        burst.push_back(createMessage(MessageType::CANCEL_TASK_RESP));
+    }
+    TEST_CHECK(MessagePool::stats().heapAllocations - heapBefore >= MessagePool::MAX_POOLED_BLOCKS / 2);
+}
+
+} // namespace
+
+int main() {
+    TEST_RUN(testSteadyStateDecodeDoesNotAllocate);
+    TEST_RUN(testSizeClasses);
+    TEST_RUN(testCrossThreadRelease);
+
+    std::printf("%d 项检查失败\n", test::failureCount().load());
+    return test::failureCount().load() == 0 ? 0 : 1;
+}
@@ -0,0 +1,82 @@
+#include "test_util.hpp"
+#include "protocol/message_registry.hpp"
+#include "protocol/serializer.hpp"
+#include <memory>
+#include <string>
+#include <type_traits>
+
+namespace {
+
+using namespace protocol;
+
+// 协议 Type 到响应类型的映射在编译期求值
+static_assert(responseTypeForWire(1002) == MessageType::GET_REAL_TIME_STATUS_RESP, "1002");
+static_assert(responseTypeForWire(1003) == MessageType::NAVIGATION_TASK_RESP, "1003");
+static_assert(responseTypeForWire(1004) == MessageType::CANCEL_TASK_RESP, "1004");
+static_assert(responseTypeForWire(1007) == MessageType::QUERY_STATUS_RESP, "1007");
+static_assert(responseTypeForWire(1005) == MessageType::UNKNOWN, "未注册的 Type");
+
+void testCreateEveryRegisteredType() {
+    int created = 0;
+    for (int i = static_cast<int>(MessageType::GET_REAL_TIME_STATUS_REQ);
+         i <= static_cast<int>(MessageType::QUERY_STATUS_RESP); ++i) {
+        const MessageType type = static_cast<MessageType>(i);
+        auto message = createMessage(type);
+        TEST_CHECK(message && message->getType() == type);
+        created += message ? 1 : 0;
+    }
+    TEST_CHECK(created == 8);
+    TEST_CHECK(createMessage(MessageType::UNKNOWN) == nullptr);
+}
+
+void testMessageCast() {
+    std::unique_ptr<IMessage> message = createMessage(MessageType::QUERY_STATUS_RESP);
+    TEST_CHECK(messageCast<QueryStatusResponse>(message.get()) != nullptr);
+    TEST_CHECK(messageCast<NavigationTaskResponse>(message.get()) == nullptr);
+    TEST_CHECK(messageCast<QueryStatusRequest>(message.get()) == nullptr);
+
+    const IMessage* constMessage = message.get();
+    const QueryStatusResponse* response = messageCast<QueryStatusResponse>(constMessage);
+    TEST_CHECK(response == message.get());
+    TEST_CHECK(messageCast<QueryStatusResponse>(static_cast<IMessage*>(nullptr)) == nullptr);
+}
+
+void testVisitMessage() {
+    const std::string body =
+        "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<PatrolDevice>\n<Type>1003</Type>\n<Command>1</Command>\n"
+        "<Time>2024-05-20 12:34:56</Time>\n<Items><Value>9</Value><ErrorCode>1</ErrorCode></Items>\n</PatrolDevice>";
+    Frame frame;
+    frame.sequenceNumber = 3;
+    frame.body = body;
+
+    Serializer serializer;
+    auto message = serializer.deserializeFrame(frame);
+    TEST_CHECK(message != nullptr);
+    if (!message) {
+        return;
+    }
+
+    int visitedValue = -1;
+    int wireType = 0;
+    const bool visited = visitMessage(*message, [&](auto& concrete) {
+        using Message = std::decay_t<decltype(concrete)>;
+        wireType = Message::WIRE_TYPE;
+        if constexpr (std::is_same<Message, NavigationTaskResponse>::value) {
+            visitedValue = concrete.value;
+        }
+    });
+    TEST_CHECK(visited);
+    TEST_CHECK(wireType == 1003);
+    TEST_CHECK(visitedValue == 9);
+}
+
+} // namespace
+
+int main() {
+    TEST_RUN(testCreateEveryRegisteredType);
+    TEST_RUN(testMessageCast);
+    TEST_RUN(testVisitMessage);
+
+    std::printf("%d 项检查失败\n", test::failureCount().load());
+    return test::failureCount().load() == 0 ? 0 : 1;
+}
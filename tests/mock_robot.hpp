@@ -0,0 +1,227 @@
+#pragma once
+
+#include "protocol/frame_decoder.hpp"
+#include "protocol/protocol_header.hpp"
+#include "protocol/xml_scanner.hpp"
+#include <utility>  // Boost 1.74 的 asio/awaitable.hpp 以 C++20 编译时依赖此头文件却没有包含
+#include <boost/asio.hpp>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace test {
+
+/**
+ * @brief 进程内的模拟机器狗服务端，供 SDK 级别的测试使用
+ *
+ * 监听 127.0.0.1 的随机端口，每个连接一个线程，按请求的 Type 回复固定内容的
+ * 1002/1003/1004/1007 响应，序列号与请求一致。可以配置响应延迟、停止响应以及
+ * 主动断开所有连接，用于覆盖超时、断线等路径。
+ */
+class MockRobot {
+public:
+    MockRobot()
+        : acceptor_(io_context_, boost::asio::ip::tcp::endpoint(boost::asio::ip::make_address("127.0.0.1"), 0)),
+          accept_thread_([this]() { acceptLoop(); }) {}
+
+    ~MockRobot() {
+        stopped_ = true;
+
+        // 阻塞中的 accept() 不会因为关闭监听套接字而返回，连接一次把它唤醒
+        boost::system::error_code ec;
+        boost::asio::ip::tcp::socket wakeup(io_context_);
+        wakeup.connect(acceptor_.local_endpoint(), ec);
+        accept_thread_.join();
+        acceptor_.close(ec);
+        closeConnections();
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto& thread : threads_) {
+            thread.join();
+        }
+    }
+
+    MockRobot(const MockRobot&) = delete;
+    MockRobot& operator=(const MockRobot&) = delete;
+
+    uint16_t port() const { return acceptor_.local_endpoint().port(); }
+
+    /**
+     * @brief 主动关闭所有已建立的连接，模拟网络中断
+     */
+    void closeConnections() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto& socket : sockets_) {
+            boost::system::error_code ec;
+            socket->shutdown(boost::asio::ip::tcp::socket::shutdown_both, ec);
+            socket->close(ec);
+        }
+        sockets_.clear();
+    }
+
+    /**
+     * @brief 收到的指定类型请求数
+     */
+    int received(int type) const {
+        switch (type) {
+            case 1002: return received1002.load();
+            case 1003: return received1003.load();
+            case 1004: return received1004.load();
+            case 1007: return received1007.load();
+            default: return 0;
+        }
+    }
+
+    std::atomic<int> responseDelayMs{0};  ///< 每个响应发送前的延迟
+    std::atomic<bool> silent{false};      ///< 为 true 时只接收请求、不回复
+    std::atomic<int> accepted{0};         ///< 已接受的连接数
+
+    std::atomic<int> received1002{0};
+    std::atomic<int> received1003{0};
+    std::atomic<int> received1004{0};
+    std::atomic<int> received1007{0};
+
+private:
+    void acceptLoop() {
+        while (!stopped_) {
+            auto socket = std::make_shared<boost::asio::ip::tcp::socket>(io_context_);
+            boost::system::error_code ec;
+            acceptor_.accept(*socket, ec);
+            if (ec || stopped_) {
+                return;
+            }
+            socket->set_option(boost::asio::ip::tcp::no_delay(true), ec);
+            ++accepted;
+
+            std::lock_guard<std::mutex> lock(mutex_);
+            sockets_.push_back(socket);
+            threads_.emplace_back([this, socket]() { serve(socket); });
+        }
+    }
+
+    void serve(std::shared_ptr<boost::asio::ip::tcp::socket> socket) {
+        // 响应由单独的写线程按到期时间发送，延迟不会阻塞请求的接收
+        std::mutex mutex;
+        std::condition_variable cv;
+        std::deque<std::pair<std::chrono::steady_clock::time_point, std::string>> outbox;
+        bool closed = false;
+
+        std::thread writer([&]() {
+            while (true) {
+                std::pair<std::chrono::steady_clock::time_point, std::string> item;
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    cv.wait(lock, [&]() { return closed || !outbox.empty(); });
+                    if (outbox.empty()) {
+                        return;
+                    }
+                    item = std::move(outbox.front());
+                    outbox.pop_front();
+                }
+
+                std::this_thread::sleep_until(item.first);
+                boost::system::error_code ec;
+                boost::asio::write(*socket, boost::asio::buffer(item.second), ec);
+                if (ec) {
+                    return;
+                }
+            }
+        });
+
+        protocol::FrameDecoder decoder;
+        protocol::Frame frame;
+        constexpr size_t CHUNK = 4096;
+
+        while (!stopped_) {
+            boost::system::error_code ec;
+            const size_t n = socket->read_some(boost::asio::buffer(decoder.prepare(CHUNK), CHUNK), ec);
+            if (ec) {
+                break;
+            }
+            decoder.commit(n);
+
+            std::string out;
+            while (decoder.next(frame)) {
+                std::string_view typeText;
+                if (!protocol::findElementText(frame.body, "Type", typeText)) {
+                    continue;
+                }
+                const int type = std::atoi(std::string(typeText).c_str());
+                countRequest(type);
+                if (!silent) {
+                    appendResponse(out, type, frame.sequenceNumber);
+                }
+            }
+
+            if (!out.empty()) {
+                const auto due = std::chrono::steady_clock::now() + std::chrono::milliseconds(responseDelayMs.load());
+                std::lock_guard<std::mutex> lock(mutex);
+                outbox.emplace_back(due, std::move(out));
+                cv.notify_one();
+            }
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            closed = true;
+            outbox.clear();
+        }
+        cv.notify_one();
+        writer.join();
+    }
+
+    void countRequest(int type) {
+        switch (type) {
+            case 1002: ++received1002; break;
+            case 1003: ++received1003; break;
+            case 1004: ++received1004; break;
+            case 1007: ++received1007; break;
+            default: break;
+        }
+    }
+
+    static void appendResponse(std::string& out, int type, uint16_t sequenceNumber) {
+        std::string items;
+        switch (type) {
+            case 1002:
+                items = "<MotionState>1</MotionState><PosX>1.5</PosX><PosY>-2.5</PosY><Electricity>77</Electricity>";
+                break;
+            case 1003:
+                items = "<Value>5</Value><ErrorCode>0</ErrorCode><ErrorStatus>0</ErrorStatus>";
+                break;
+            case 1004:
+                items = "<ErrorCode>0</ErrorCode>";
+                break;
+            case 1007:
+                items = "<Value>3</Value><Status>1</Status><ErrorCode>0</ErrorCode>";
+                break;
+            default:
+                return;
+        }
+
+        const std::string body = "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<PatrolDevice>\n<Type>" +
+                                 std::to_string(type) + "</Type>\n<Command>1</Command>\n<Time>2025-01-01 00:00:00</Time>\n<Items>" +
+                                 items + "</Items>\n</PatrolDevice>";
+
+        protocol::ProtocolHeader header(static_cast<uint16_t>(body.size()), sequenceNumber);
+        out.append(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.append(body);
+    }
+
+    boost::asio::io_context io_context_;
+    boost::asio::ip::tcp::acceptor acceptor_;
+    std::atomic<bool> stopped_{false};
+    std::mutex mutex_;
+    std::vector<std::shared_ptr<boost::asio::ip::tcp::socket>> sockets_;
+    std::vector<std::thread> threads_;
+    std::thread accept_thread_;
+};
+
+} // namespace test
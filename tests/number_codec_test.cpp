@@ -0,0 +1,75 @@
+#include "test_util.hpp"
+#include "protocol/number_codec.hpp"
+#include <cstdint>
+#include <string>
+
+namespace {
+
+using protocol::parseNumber;
+
+void testIntegers() {
+    int value = 0;
+    TEST_CHECK(parseNumber("42", value) && value == 42);
+    TEST_CHECK(parseNumber(" \t-7\r\n", value) && value == -7);
+    TEST_CHECK(parseNumber("+3", value) && value == 3);
+
+    int64_t big = 0;
+    TEST_CHECK(parseNumber("123456789012", big) && big == 123456789012LL);
+}
+
+void testFloatingPoint() {
+    double value = 0.0;
+    TEST_CHECK(parseNumber("3.14159", value) && value == 3.14159);
+    TEST_CHECK(parseNumber("-2.5", value) && value == -2.5);
+    TEST_CHECK(parseNumber("+0.125", value) && value == 0.125);
+    TEST_CHECK(parseNumber("1e3", value) && value == 1000.0);
+    TEST_CHECK(parseNumber(" 12.5 ", value) && value == 12.5);
+}
+
+void testInvalidKeepsValue() {
+    int value = 5;
+    TEST_CHECK(!parseNumber("", value) && value == 5);
+    TEST_CHECK(!parseNumber("   ", value) && value == 5);
+    TEST_CHECK(!parseNumber("abc", value) && value == 5);
+    TEST_CHECK(!parseNumber("+", value) && value == 5);
+    TEST_CHECK(!parseNumber("+-3", value) && value == 5);
+    TEST_CHECK(!parseNumber("++3", value) && value == 5);
+
+    double d = 1.5;
+    TEST_CHECK(!parseNumber("x1.0", d) && d == 1.5);
+}
+
+std::string format(double value) {
+    char buffer[32];
+    return std::string(buffer, protocol::formatNumber(buffer, buffer + sizeof(buffer), value));
+}
+
+void testFormat() {
+    char buffer[32];
+    TEST_CHECK(std::string(buffer, protocol::formatNumber(buffer, buffer + sizeof(buffer), -42)) == "-42");
+
+    TEST_CHECK(format(0.0) == "0");
+    TEST_CHECK(format(1.25) == "1.25");
+    TEST_CHECK(format(-0.5) == "-0.5");
+    TEST_CHECK(format(0.1) == "0.1");
+    TEST_CHECK(format(3600.0) == "3600");
+
+    // 任意值都能无损往返
+    for (double value : {0.1 + 0.2, 1.0 / 3.0, -123456.789, 1e-7, 6.02214076e23}) {
+        double parsed = 0.0;
+        TEST_CHECK(parseNumber(format(value), parsed) && parsed == value);
+    }
+}
+
+} // namespace
+
+int main() {
+    std::printf("X30_HAS_FLOAT_CHARCONV=%d\n", X30_HAS_FLOAT_CHARCONV);
+    TEST_RUN(testIntegers);
+    TEST_RUN(testFloatingPoint);
+    TEST_RUN(testInvalidKeepsValue);
+    TEST_RUN(testFormat);
+
+    std::printf("%d 项检查失败\n", test::failureCount().load());
+    return test::failureCount().load() == 0 ? 0 : 1;
+}
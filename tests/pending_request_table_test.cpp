@@ -0,0 +1,228 @@
+#include "test_util.hpp"
+#include "common/pending_request_table.hpp"
+#include "protocol/messages.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using common::PendingRequestTable;
+using protocol::MessageType;
+
+constexpr int REQUESTER_THREADS = 8;
+constexpr int REQUESTS_PER_THREAD = 3000;
+constexpr int DROP_EVERY = 16;   ///< 每 DROP_EVERY 个请求中有一个不响应，由请求方超时放弃
+
+std::unique_ptr<protocol::IMessage> makeResponse(uint16_t sequenceNumber) {
+    auto response = std::make_unique<protocol::GetRealTimeStatusResponse>();
+    response->setSequenceNumber(sequenceNumber);
+    return response;
+}
+
+/**
+ * @brief 模拟IO线程：按登记顺序投递响应
+ */
+class Responder {
+public:
+    Responder(PendingRequestTable& table, std::atomic<int>& delivered)
+        : table_(table), delivered_(delivered), thread_([this]() { run(); }) {}
+
+    ~Responder() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopped_ = true;
+        }
+        cv_.notify_all();
+        thread_.join();
+    }
+
+    void push(uint16_t sequenceNumber) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            queue_.push_back(sequenceNumber);
+        }
+        cv_.notify_one();
+    }
+
+private:
+    void run() {
+        while (true) {
+            uint16_t seq = 0;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                cv_.wait(lock, [this]() { return stopped_ || !queue_.empty(); });
+                if (queue_.empty()) {
+                    return;
+                }
+                seq = queue_.front();
+                queue_.pop_front();
+            }
+
+            // 类型不匹配的响应不能被认领
+            std::unique_ptr<protocol::IMessage> wrongType = makeResponse(seq);
+            TEST_CHECK(!table_.complete(seq, MessageType::QUERY_STATUS_RESP, wrongType));
+
+            std::unique_ptr<protocol::IMessage> response = makeResponse(seq);
+            if (table_.complete(seq, MessageType::GET_REAL_TIME_STATUS_RESP, response)) {
+                TEST_CHECK(response == nullptr);
+                ++delivered_;
+            }
+        }
+    }
+
+    PendingRequestTable& table_;
+    std::atomic<int>& delivered_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::deque<uint16_t> queue_;
+    bool stopped_ = false;
+    std::thread thread_;
+};
+
+void testConcurrentRequests() {
+    PendingRequestTable table;
+    std::atomic<int> answered{0};
+    std::atomic<int> timedOut{0};
+    std::atomic<int> mismatched{0};
+    std::atomic<int> delivered{0};
+
+    {
+        Responder responder(table, delivered);
+        std::vector<std::thread> requesters;
+        for (int t = 0; t < REQUESTER_THREADS; ++t) {
+            requesters.emplace_back([&, t]() {
+                for (int i = 0; i < REQUESTS_PER_THREAD; ++i) {
+                    uint16_t seq = 0;
+                    if (!table.acquire(MessageType::GET_REAL_TIME_STATUS_RESP, seq)) {
+                        ++mismatched;
+                        continue;
+                    }
+
+                    const bool drop = (t * REQUESTS_PER_THREAD + i) % DROP_EVERY == 0;
+                    if (!drop) {
+                        responder.push(seq);
+                    }
+
+                    auto response = table.wait(seq, std::chrono::milliseconds(drop ? 1 : 5000));
+                    table.release(seq);
+                    if (!response) {
+                        ++timedOut;
+                    } else if (response->getSequenceNumber() != seq) {
+                        ++mismatched;
+                    } else {
+                        ++answered;
+                    }
+
+                    // 超时之后才到达的响应不能被认领
+                    if (drop && i % 2 == 0) {
+                        responder.push(seq);
+                    }
+                }
+            });
+        }
+        for (auto& requester : requesters) {
+            requester.join();
+        }
+    }
+
+    // 投递计数在 complete() 返回之后才增加，须等响应线程结束后再比较
+    TEST_CHECK(delivered.load() == answered.load());
+
+    const int total = REQUESTER_THREADS * REQUESTS_PER_THREAD;
+    TEST_CHECK(mismatched.load() == 0);
+    TEST_CHECK(timedOut.load() == total / DROP_EVERY);
+    TEST_CHECK(answered.load() + timedOut.load() == total);
+
+    // 所有槽位都应已释放
+    std::vector<uint16_t> held;
+    uint16_t seq = 0;
+    while (table.acquire(MessageType::GET_REAL_TIME_STATUS_RESP, seq)) {
+        held.push_back(seq);
+    }
+    TEST_CHECK(held.size() == PendingRequestTable::SLOT_COUNT);
+}
+
+void testReleaseWithoutWait() {
+    PendingRequestTable table;
+    uint16_t seq = 0;
+    TEST_CHECK(table.acquire(MessageType::CANCEL_TASK_RESP, seq));
+
+    std::unique_ptr<protocol::IMessage> response = makeResponse(seq);
+    TEST_CHECK(table.complete(seq, MessageType::CANCEL_TASK_RESP, response));
+
+    // 已有响应但未被取走时释放，响应随槽位一起回收；重复释放无副作用
+    table.release(seq);
+    table.release(seq);
+    TEST_CHECK(table.wait(seq, std::chrono::milliseconds(1)) == nullptr);
+
+    std::unique_ptr<protocol::IMessage> late = makeResponse(seq);
+    TEST_CHECK(!table.complete(seq, MessageType::CANCEL_TASK_RESP, late));
+    TEST_CHECK(late != nullptr);
+}
+
+void testAsyncRequests() {
+    PendingRequestTable table;
+    int completed = 0;
+    int expired = 0;
+
+    auto handler = [&](std::unique_ptr<protocol::IMessage> response) {
+        if (response) {
+            ++completed;
+        } else {
+            ++expired;
+        }
+    };
+
+    uint16_t answered = 0;
+    uint16_t dropped = 0;
+    TEST_CHECK(table.acquireAsync(MessageType::GET_REAL_TIME_STATUS_RESP, handler, answered));
+    TEST_CHECK(table.acquireAsync(MessageType::GET_REAL_TIME_STATUS_RESP, handler, dropped));
+
+    // 异步槽位不能被同步接口等待或释放
+    TEST_CHECK(table.wait(answered, std::chrono::milliseconds(1)) == nullptr);
+    table.release(answered);
+
+    std::unique_ptr<protocol::IMessage> response = makeResponse(answered);
+    TEST_CHECK(table.complete(answered, MessageType::GET_REAL_TIME_STATUS_RESP, response));
+    TEST_CHECK(response == nullptr);
+    TEST_CHECK(completed == 1);
+
+    // 已完成的请求不会再超时，已超时的请求不会再被响应
+    TEST_CHECK(!table.expire(answered));
+    TEST_CHECK(table.expire(dropped));
+    TEST_CHECK(!table.expire(dropped));
+    std::unique_ptr<protocol::IMessage> late = makeResponse(dropped);
+    TEST_CHECK(!table.complete(dropped, MessageType::GET_REAL_TIME_STATUS_RESP, late));
+    TEST_CHECK(completed == 1 && expired == 1);
+
+    // 断开连接：异步请求以空响应完成，同步等待方立即返回
+    uint16_t pending = 0;
+    uint16_t syncSeq = 0;
+    TEST_CHECK(table.acquireAsync(MessageType::QUERY_STATUS_RESP, handler, pending));
+    TEST_CHECK(table.acquire(MessageType::QUERY_STATUS_RESP, syncSeq));
+    std::thread waiter([&]() {
+        const auto start = std::chrono::steady_clock::now();
+        TEST_CHECK(table.wait(syncSeq, std::chrono::seconds(10)) == nullptr);
+        TEST_CHECK(std::chrono::steady_clock::now() - start < std::chrono::seconds(5));
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    table.cancelAll();
+    waiter.join();
+    table.release(syncSeq);
+    TEST_CHECK(expired == 2);
+}
+
+} // namespace
+
+int main() {
+    TEST_RUN(testConcurrentRequests);
+    TEST_RUN(testReleaseWithoutWait);
+    TEST_RUN(testAsyncRequests);
+
+    std::printf("%d 项检查失败\n", test::failureCount().load());
+    return test::failureCount().load() == 0 ? 0 : 1;
+}
@@ -0,0 +1,130 @@
+#include "test_util.hpp"
+#include "protocol/protocol_header.hpp"
+#include <navigation_sdk.h>
+#include <boost/asio.hpp>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <thread>
+
+/**
+ * 替换全局 operator new，统计 SDK 线程（IO 线程、日志线程）在稳定接收阶段的堆分配次数。
+ * 测试主线程与模拟服务端线程标记为忽略，它们的分配不计入。
+ */
+namespace {
+
+std::atomic<bool> g_counting{false};
+std::atomic<uint64_t> g_allocations{0};
+thread_local bool t_ignored = false;
+
+void* countedAllocate(std::size_t size) {
+    if (g_counting.load(std::memory_order_relaxed) && !t_ignored) {
+        g_allocations.fetch_add(1, std::memory_order_relaxed);
+    }
+    if (void* block = std::malloc(size == 0 ? 1 : size)) {
+        return block;
+    }
+    throw std::bad_alloc();
+}
+
+} // namespace
+
+void* operator new(std::size_t size) { return countedAllocate(size); }
+void* operator new[](std::size_t size) { return countedAllocate(size); }
+void operator delete(void* block) noexcept { std::free(block); }
+void operator delete[](void* block) noexcept { std::free(block); }
+void operator delete(void* block, std::size_t) noexcept { std::free(block); }
+void operator delete[](void* block, std::size_t) noexcept { std::free(block); }
+
+namespace {
+
+using namespace robotserver_sdk;
+
+constexpr int WARMUP_FRAMES = 2000;
+constexpr int MEASURED_FRAMES = 10000;
+
+/**
+ * @brief count 个首尾相接的 1002 响应帧；序列号不对应任何请求，SDK 只更新实时状态缓存
+ */
+std::string makeStatusFrames(int count) {
+    const std::string body =
+        "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<PatrolDevice>\n<Type>1002</Type>\n<Command>1</Command>\n"
+        "<Time>2025-01-01 00:00:00</Time>\n<Items><MotionState>1</MotionState><PosX>1.5</PosX><PosY>-2.5</PosY>"
+        "<Electricity>77</Electricity></Items>\n</PatrolDevice>";
+
+    std::string frames;
+    for (int i = 0; i < count; ++i) {
+        protocol::ProtocolHeader header(static_cast<uint16_t>(body.size()), static_cast<uint16_t>(40000 + i % 1000));
+        frames.append(reinterpret_cast<const char*>(&header), sizeof(header));
+        frames += body;
+    }
+    return frames;
+}
+
+uint64_t framesDecoded(RobotServerSdk& sdk) {
+    return sdk.metrics().framesDecoded;
+}
+
+bool waitForFrames(RobotServerSdk& sdk, uint64_t expected) {
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (framesDecoded(sdk) < expected) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    return true;
+}
+
+void testSteadyStateReceiveDoesNotAllocate() {
+    t_ignored = true;
+
+    boost::asio::io_context io;
+    boost::asio::ip::tcp::acceptor acceptor(io, {boost::asio::ip::make_address("127.0.0.1"), 0});
+    const uint16_t port = acceptor.local_endpoint().port();
+    boost::asio::ip::tcp::socket peer(io);
+    std::thread server([&]() {
+        t_ignored = true;
+        acceptor.accept(peer);
+    });
+
+    SdkOptions options;
+    options.realTimeStatusMaxStaleness = std::chrono::seconds(10);  // 最后用缓存确认帧经过了完整的分发路径
+    RobotServerSdk sdk(options);
+    TEST_CHECK(sdk.connect("127.0.0.1", port));
+    server.join();
+
+    // 预热：分帧缓冲区与消息池达到稳定容量
+    const std::string warmup = makeStatusFrames(WARMUP_FRAMES);
+    const std::string measured = makeStatusFrames(MEASURED_FRAMES);
+    boost::asio::write(peer, boost::asio::buffer(warmup));
+    TEST_CHECK(waitForFrames(sdk, WARMUP_FRAMES));
+
+    g_allocations = 0;
+    g_counting = true;
+    std::thread writer([&]() {
+        t_ignored = true;
+        boost::asio::write(peer, boost::asio::buffer(measured));
+    });
+    writer.join();
+    TEST_CHECK(waitForFrames(sdk, WARMUP_FRAMES + MEASURED_FRAMES));
+    g_counting = false;
+
+    std::printf("接收 %d 帧期间 SDK 线程的堆分配次数: %llu\n", MEASURED_FRAMES,
+                static_cast<unsigned long long>(g_allocations.load()));
+    TEST_CHECK(g_allocations.load() == 0);
+
+    TEST_CHECK(sdk.request1002_RunTimeStatus().electricity == 77);
+    sdk.disconnect();
+}
+
+} // namespace
+
+int main() {
+    TEST_RUN(testSteadyStateReceiveDoesNotAllocate);
+
+    std::printf("%d 项检查失败\n", test::failureCount().load());
+    return test::failureCount().load() == 0 ? 0 : 1;
+}
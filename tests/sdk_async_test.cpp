@@ -0,0 +1,712 @@
+#include "test_util.hpp"
+#include "mock_robot.hpp"
+#include <navigation_sdk.h>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using namespace robotserver_sdk;
+
+constexpr int IN_FLIGHT_REQUESTS = 200;
+
+SdkOptions shortTimeoutOptions() {
+    SdkOptions options;
+    options.requestTimeout = std::chrono::milliseconds(300);
+    return options;
+}
+
+void testFutures() {
+    test::MockRobot robot;
+    RobotServerSdk sdk;
+    TEST_CHECK(sdk.connect("127.0.0.1", robot.port()));
+
+    auto status = sdk.request1002_RunTimeStatusAsync();
+    auto cancel = sdk.request1004_CancelNavTaskAsync();
+    auto task = sdk.request1007_NavTaskStatusAsync();
+
+    const RealTimeStatus s = status.get();
+    TEST_CHECK(s.errorCode == ErrorCode_RealTimeStatus::SUCCESS);
+    TEST_CHECK(s.electricity == 77);
+    TEST_CHECK(cancel.get());
+    const TaskStatusResult t = task.get();
+    TEST_CHECK(t.value == 3);
+    TEST_CHECK(t.status == Status_QueryStatus::EXECUTING);
+}
+
+void testManyInFlightFromOneThread() {
+    test::MockRobot robot;
+    robot.responseDelayMs = 50;
+    SdkOptions options;
+    options.coalesceQueries = false;
+    RobotServerSdk sdk(options);
+    TEST_CHECK(sdk.connect("127.0.0.1", robot.port()));
+
+    std::atomic<int> succeeded{0};
+    std::atomic<int> done{0};
+    std::promise<void> allDone;
+
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < IN_FLIGHT_REQUESTS; ++i) {
+        auto onResult = [&](bool ok) {
+            succeeded += ok ? 1 : 0;
+            if (++done == IN_FLIGHT_REQUESTS) {
+                allDone.set_value();
+            }
+        };
+        if (i % 2 == 0) {
+            sdk.request1002_RunTimeStatus([onResult](const RealTimeStatus& status) {
+                onResult(status.errorCode == ErrorCode_RealTimeStatus::SUCCESS);
+            });
+        } else {
+            sdk.request1007_NavTaskStatus([onResult](const TaskStatusResult& result) {
+                onResult(result.errorCode == ErrorCode_QueryStatus::COMPLETED);
+            });
+        }
+    }
+
+    // 所有请求同时在途，总耗时远小于逐个往返的 IN_FLIGHT_REQUESTS * 50ms
+    TEST_CHECK(allDone.get_future().wait_for(std::chrono::seconds(5)) == std::future_status::ready);
+    TEST_CHECK(succeeded.load() == IN_FLIGHT_REQUESTS);
+    TEST_CHECK(std::chrono::steady_clock::now() - start < std::chrono::seconds(3));
+}
+
+void testConcurrentSenders() {
+    constexpr int SENDER_THREADS = 8;
+    constexpr int REQUESTS_PER_THREAD = 250;
+
+    test::MockRobot robot;
+    SdkOptions options;
+    options.coalesceQueries = false;
+    RobotServerSdk sdk(options);
+    TEST_CHECK(sdk.connect("127.0.0.1", robot.port()));
+
+    // 多个线程同时突发发送：帧必须完整、不交错，每个请求都得到自己的响应
+    std::atomic<int> succeeded{0};
+    std::vector<std::thread> senders;
+    for (int t = 0; t < SENDER_THREADS; ++t) {
+        senders.emplace_back([&]() {
+            std::vector<std::future<RealTimeStatus>> statuses;
+            std::vector<std::future<TaskStatusResult>> tasks;
+            for (int i = 0; i < REQUESTS_PER_THREAD; ++i) {
+                if (i % 2 == 0) {
+                    statuses.push_back(sdk.request1002_RunTimeStatusAsync());
+                } else {
+                    tasks.push_back(sdk.request1007_NavTaskStatusAsync());
+                }
+            }
+            for (auto& status : statuses) {
+                succeeded += status.get().electricity == 77 ? 1 : 0;
+            }
+            for (auto& task : tasks) {
+                succeeded += task.get().value == 3 ? 1 : 0;
+            }
+        });
+    }
+    for (auto& sender : senders) {
+        sender.join();
+    }
+
+    const int total = SENDER_THREADS * REQUESTS_PER_THREAD;
+    TEST_CHECK(succeeded.load() == total);
+    TEST_CHECK(robot.received1002.load() + robot.received1007.load() == total);
+}
+
+void testTimeoutAndDisconnect() {
+    test::MockRobot robot;
+    robot.silent = true;
+    RobotServerSdk sdk(shortTimeoutOptions());
+    TEST_CHECK(sdk.connect("127.0.0.1", robot.port()));
+
+    // 没有响应：超时后以 TIMEOUT 完成
+    const RealTimeStatus timedOut = sdk.request1002_RunTimeStatusAsync().get();
+    TEST_CHECK(timedOut.errorCode == ErrorCode_RealTimeStatus::TIMEOUT);
+
+    // 同步接口的截止时间同样由时间轮结束等待
+    const auto syncStart = std::chrono::steady_clock::now();
+    TEST_CHECK(sdk.request1002_RunTimeStatus().errorCode == ErrorCode_RealTimeStatus::TIMEOUT);
+    TEST_CHECK(sdk.request1007_NavTaskStatus().errorCode == ErrorCode_QueryStatus::TIMEOUT);
+    TEST_CHECK(std::chrono::steady_clock::now() - syncStart < std::chrono::seconds(5));
+
+    // 主动断开：在途请求立即以 NOT_CONNECTED 完成，不等到超时
+    SdkOptions longTimeout;
+    longTimeout.requestTimeout = std::chrono::seconds(30);
+    RobotServerSdk waiting(longTimeout);
+    TEST_CHECK(waiting.connect("127.0.0.1", robot.port()));
+    auto pending = waiting.request1007_NavTaskStatusAsync();
+    waiting.disconnect();
+    TEST_CHECK(pending.wait_for(std::chrono::seconds(1)) == std::future_status::ready);
+    TEST_CHECK(pending.get().errorCode == ErrorCode_QueryStatus::NOT_CONNECTED);
+
+    // 被动断开：对端关闭连接后在途请求同样立即结束
+    RobotServerSdk dropped(longTimeout);
+    TEST_CHECK(dropped.connect("127.0.0.1", robot.port()));
+    auto cancel = dropped.request1004_CancelNavTaskAsync();
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    robot.closeConnections();
+    TEST_CHECK(cancel.wait_for(std::chrono::seconds(2)) == std::future_status::ready);
+    TEST_CHECK(!cancel.get());
+    TEST_CHECK(!dropped.isConnected());
+
+    // 未连接时回调在调用线程中立即调用
+    bool called = false;
+    dropped.request1002_RunTimeStatus([&](const RealTimeStatus& status) {
+        called = status.errorCode == ErrorCode_RealTimeStatus::NOT_CONNECTED;
+    });
+    TEST_CHECK(called);
+}
+
+void testInFlightWindow() {
+    constexpr int WINDOW = 4;
+    constexpr int BATCHES = 3;
+    constexpr int DELAY_MS = 100;
+
+    test::MockRobot robot;
+    robot.responseDelayMs = DELAY_MS;
+    SdkOptions options;
+    options.maxInFlightRequests = WINDOW;
+    options.coalesceQueries = false;
+    RobotServerSdk sdk(options);
+    TEST_CHECK(sdk.connect("127.0.0.1", robot.port()));
+
+    // 窗口已满时提交方被阻塞，请求按窗口大小分批往返
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<std::future<RealTimeStatus>> results;
+    for (int i = 0; i < WINDOW * BATCHES; ++i) {
+        results.push_back(sdk.request1002_RunTimeStatusAsync());
+        TEST_CHECK(robot.received1002.load() <= (i / WINDOW + 1) * WINDOW);
+    }
+    for (auto& result : results) {
+        TEST_CHECK(result.get().errorCode == ErrorCode_RealTimeStatus::SUCCESS);
+    }
+    TEST_CHECK(std::chrono::steady_clock::now() - start >= std::chrono::milliseconds(BATCHES * DELAY_MS));
+
+    // 同步接口与异步接口共用同一个窗口
+    TEST_CHECK(sdk.request1007_NavTaskStatus().errorCode == ErrorCode_QueryStatus::COMPLETED);
+}
+
+void testPerRequestDeadline() {
+    test::MockRobot robot;
+    robot.silent = true;
+    SdkOptions options;
+    options.requestTimeout = std::chrono::seconds(30);
+    options.maxInFlightRequests = 1;
+    RobotServerSdk sdk(options);
+    TEST_CHECK(sdk.connect("127.0.0.1", robot.port()));
+
+    // 占满窗口的请求使用自己的截止时间
+    const auto start = std::chrono::steady_clock::now();
+    auto first = sdk.request1002_RunTimeStatusAsync(std::chrono::milliseconds(200));
+
+    // 等待窗口名额的时间同样计入截止时间
+    auto second = sdk.request1007_NavTaskStatusAsync(std::chrono::milliseconds(50));
+    TEST_CHECK(second.get().errorCode == ErrorCode_QueryStatus::TIMEOUT);
+    TEST_CHECK(std::chrono::steady_clock::now() - start < std::chrono::milliseconds(180));
+
+    TEST_CHECK(first.get().errorCode == ErrorCode_RealTimeStatus::TIMEOUT);
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    TEST_CHECK(elapsed >= std::chrono::milliseconds(200) && elapsed < std::chrono::seconds(5));
+
+    // 名额已归还，后续请求不受影响
+    robot.silent = false;
+    TEST_CHECK(sdk.request1004_CancelNavTaskAsync().get());
+
+    // 在回调（IO线程）中窗口已满时不阻塞，直接以超时结束
+    std::promise<ErrorCode_QueryStatus> nested;
+    auto nestedResult = nested.get_future();
+    sdk.request1007_NavTaskStatus([&](const TaskStatusResult&) {
+        // 外层请求的名额在回调之前已归还，这个请求重新占满窗口
+        sdk.request1002_RunTimeStatus([](const RealTimeStatus&) {});
+        sdk.request1007_NavTaskStatus([&](const TaskStatusResult& inner) {
+            nested.set_value(inner.errorCode);
+        });
+    });
+    TEST_CHECK(nestedResult.wait_for(std::chrono::seconds(1)) == std::future_status::ready);
+    TEST_CHECK(nestedResult.get() == ErrorCode_QueryStatus::TIMEOUT);
+}
+
+void testCoalescedQueries() {
+    constexpr int CALLER_THREADS = 16;
+
+    test::MockRobot robot;
+    robot.responseDelayMs = 100;
+    RobotServerSdk sdk;
+    TEST_CHECK(sdk.connect("127.0.0.1", robot.port()));
+
+    // 同时到达的相同查询合并为一个请求，所有调用方得到同一个结果
+    std::atomic<int> succeeded{0};
+    std::vector<std::thread> callers;
+    for (int t = 0; t < CALLER_THREADS; ++t) {
+        callers.emplace_back([&, t]() {
+            if (t % 2 == 0) {
+                succeeded += sdk.request1007_NavTaskStatus().value == 3 ? 1 : 0;
+            } else {
+                succeeded += sdk.request1007_NavTaskStatusAsync().get().value == 3 ? 1 : 0;
+            }
+            succeeded += sdk.request1002_RunTimeStatus().electricity == 77 ? 1 : 0;
+        });
+    }
+    for (auto& caller : callers) {
+        caller.join();
+    }
+    TEST_CHECK(succeeded.load() == 2 * CALLER_THREADS);
+    TEST_CHECK(robot.received1007.load() < CALLER_THREADS / 2);
+    TEST_CHECK(robot.received1002.load() < CALLER_THREADS / 2);
+
+    // 在途请求结束后到达的查询发出新的请求
+    const int before = robot.received1007.load();
+    TEST_CHECK(sdk.request1007_NavTaskStatus().value == 3);
+    TEST_CHECK(robot.received1007.load() == before + 1);
+
+    // 发起者超时，合并进来的调用方得到同样的结果
+    robot.silent = true;
+    auto first = sdk.request1002_RunTimeStatusAsync(std::chrono::milliseconds(100));
+    auto second = sdk.request1002_RunTimeStatusAsync();
+    TEST_CHECK(first.get().errorCode == ErrorCode_RealTimeStatus::TIMEOUT);
+    TEST_CHECK(second.wait_for(std::chrono::milliseconds(50)) == std::future_status::ready);
+    TEST_CHECK(second.get().errorCode == ErrorCode_RealTimeStatus::TIMEOUT);
+}
+
+void testNavigationTimeout() {
+    test::MockRobot robot;
+    SdkOptions options;
+    options.navigationTimeout = std::chrono::milliseconds(100);
+    RobotServerSdk sdk(options);
+    TEST_CHECK(sdk.connect("127.0.0.1", robot.port()));
+
+    NavigationPoint point;
+    point.value = 5;
+
+    // 收到结果后超时定时任务被取消，回调只调用一次
+    std::atomic<int> calls{0};
+    std::promise<NavigationResult> completed;
+    sdk.request1003_StartNavTask({point}, [&](const NavigationResult& result) {
+        if (++calls == 1) {
+            completed.set_value(result);
+        }
+    });
+    auto result = completed.get_future();
+    TEST_CHECK(result.wait_for(std::chrono::seconds(1)) == std::future_status::ready);
+    TEST_CHECK(result.get().errorCode == ErrorCode_Navigation::SUCCESS);
+
+    // 一直没有结果的任务以 TIMEOUT 结束
+    robot.silent = true;
+    const auto start = std::chrono::steady_clock::now();
+    std::promise<NavigationResult> expired;
+    sdk.request1003_StartNavTask({point}, [&](const NavigationResult& result) {
+        expired.set_value(result);
+    });
+    auto timedOut = expired.get_future();
+    TEST_CHECK(timedOut.wait_for(std::chrono::seconds(1)) == std::future_status::ready);
+    TEST_CHECK(timedOut.get().errorCode == ErrorCode_Navigation::TIMEOUT);
+    TEST_CHECK(std::chrono::steady_clock::now() - start >= std::chrono::milliseconds(100));
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(150));
+    TEST_CHECK(calls.load() == 1);
+}
+
+void testNavigationRoute() {
+    test::MockRobot robot;
+    RobotServerSdk sdk;
+    TEST_CHECK(sdk.connect("127.0.0.1", robot.port()));
+
+    // 远超一帧所能容纳的长路线按长度上限分成多段依次下发
+    std::vector<NavigationPoint> points(1500);
+    for (size_t i = 0; i < points.size(); ++i) {
+        points[i].value = static_cast<int>(i);
+        points[i].posX = 1000.0 + static_cast<double>(i) * 0.123456;
+        points[i].posY = -1000.0 - static_cast<double>(i) * 0.654321;
+    }
+
+    std::mutex mutex;
+    std::vector<RouteProgress> reports;
+    std::promise<NavigationResult> done;
+    RouteOptions routeOptions;
+    routeOptions.progressInterval = std::chrono::milliseconds::zero();
+    sdk.request1003_StartNavRoute(points, [&](const NavigationResult& result) {
+        done.set_value(result);
+    }, [&](const RouteProgress& progress) {
+        std::lock_guard<std::mutex> lock(mutex);
+        reports.push_back(progress);
+    }, routeOptions);
+
+    auto result = done.get_future();
+    TEST_CHECK(result.wait_for(std::chrono::seconds(2)) == std::future_status::ready);
+    TEST_CHECK(result.get().errorCode == ErrorCode_Navigation::SUCCESS);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    TEST_CHECK(!reports.empty());
+    const RouteProgress& last = reports.back();
+    TEST_CHECK(last.totalPoints == points.size());
+    TEST_CHECK(last.totalChunks > 1);
+    TEST_CHECK(last.completedChunks == last.totalChunks);
+    TEST_CHECK(last.reachedPoints == points.size());
+    TEST_CHECK(robot.received(1003) == static_cast<int>(last.totalChunks));
+
+    // 某一段失败时整条路线以该段的结果结束，不再下发后续分段
+    robot.silent = true;
+    SdkOptions options;
+    options.navigationTimeout = std::chrono::milliseconds(100);
+    RobotServerSdk timed(options);
+    TEST_CHECK(timed.connect("127.0.0.1", robot.port()));
+    const int before = robot.received(1003);
+    std::promise<NavigationResult> failed;
+    timed.request1003_StartNavRoute(points, [&](const NavigationResult& result) {
+        failed.set_value(result);
+    });
+    auto failure = failed.get_future();
+    TEST_CHECK(failure.wait_for(std::chrono::seconds(1)) == std::future_status::ready);
+    TEST_CHECK(failure.get().errorCode == ErrorCode_Navigation::TIMEOUT);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    TEST_CHECK(robot.received(1003) == before + 1);
+}
+
+void testStatusSubscription() {
+    constexpr int INTERVAL_MS = 20;
+
+    test::MockRobot robot;
+    robot.responseDelayMs = 5 * INTERVAL_MS;
+    RobotServerSdk sdk;
+    TEST_CHECK(sdk.connect("127.0.0.1", robot.port()));
+
+    TEST_CHECK(sdk.subscribeRealTimeStatus(std::chrono::milliseconds::zero(), [](const RealTimeStatus&) {}) == 0);
+
+    // 往返时间是周期的 5 倍：请求流水线发出，推送频率仍由周期决定
+    std::atomic<int> received{0};
+    std::atomic<int> failed{0};
+    const uint32_t id = sdk.subscribeRealTimeStatus(std::chrono::milliseconds(INTERVAL_MS),
+        [&](const RealTimeStatus& status) {
+            ++received;
+            failed += status.errorCode == ErrorCode_RealTimeStatus::SUCCESS ? 0 : 1;
+        });
+    TEST_CHECK(id != 0);
+    std::this_thread::sleep_for(std::chrono::milliseconds(25 * INTERVAL_MS));
+    const int count = received.load();
+    TEST_CHECK(count >= 12 && count <= 25);
+    TEST_CHECK(failed.load() == 0);
+
+    // 取消订阅后不再推送
+    sdk.unsubscribeRealTimeStatus(id);
+    const int afterUnsubscribe = received.load();
+    std::this_thread::sleep_for(std::chrono::milliseconds(10 * INTERVAL_MS));
+    TEST_CHECK(received.load() == afterUnsubscribe);
+
+    // 在订阅回调中取消订阅
+    robot.responseDelayMs = 0;
+    std::atomic<int> once{0};
+    std::atomic<uint32_t> selfId{0};
+    selfId = sdk.subscribeRealTimeStatus(std::chrono::milliseconds(INTERVAL_MS), [&](const RealTimeStatus&) {
+        ++once;
+        sdk.unsubscribeRealTimeStatus(selfId.load());
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(10 * INTERVAL_MS));
+    TEST_CHECK(once.load() == 1);
+
+    // 断开期间跳过周期，重新连接后自动恢复
+    std::atomic<int> resumed{0};
+    sdk.disconnect();
+    sdk.subscribeRealTimeStatus(std::chrono::milliseconds(INTERVAL_MS), [&](const RealTimeStatus& status) {
+        resumed += status.errorCode == ErrorCode_RealTimeStatus::SUCCESS ? 1 : 0;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(5 * INTERVAL_MS));
+    TEST_CHECK(resumed.load() == 0);
+    TEST_CHECK(sdk.connect("127.0.0.1", robot.port()));
+    std::this_thread::sleep_for(std::chrono::milliseconds(10 * INTERVAL_MS));
+    TEST_CHECK(resumed.load() > 0);
+}
+
+void testStatusCache() {
+    test::MockRobot robot;
+    SdkOptions options;
+    options.realTimeStatusMaxStaleness = std::chrono::milliseconds(200);
+    RobotServerSdk sdk(options);
+
+    RealTimeStatus latest;
+    std::chrono::steady_clock::time_point updatedAt;
+    TEST_CHECK(!sdk.latestRealTimeStatus(latest, updatedAt));
+
+    TEST_CHECK(sdk.connect("127.0.0.1", robot.port()));
+    const auto before = std::chrono::steady_clock::now();
+    TEST_CHECK(sdk.request1002_RunTimeStatus().electricity == 77);
+    TEST_CHECK(robot.received1002.load() == 1);
+    TEST_CHECK(sdk.latestRealTimeStatus(latest, updatedAt));
+    TEST_CHECK(latest.electricity == 77 && updatedAt >= before);
+
+    // 缓存足够新时同步、回调、future 接口都不发出请求
+    for (int i = 0; i < 10; ++i) {
+        TEST_CHECK(sdk.request1002_RunTimeStatus().electricity == 77);
+    }
+    TEST_CHECK(sdk.request1002_RunTimeStatusAsync().get().electricity == 77);
+    TEST_CHECK(robot.received1002.load() == 1);
+
+    // 缓存过旧后重新请求
+    std::this_thread::sleep_for(std::chrono::milliseconds(250));
+    TEST_CHECK(sdk.request1002_RunTimeStatus().errorCode == ErrorCode_RealTimeStatus::SUCCESS);
+    TEST_CHECK(robot.received1002.load() == 2);
+
+    // 未连接时不使用缓存
+    sdk.disconnect();
+    TEST_CHECK(sdk.request1002_RunTimeStatus().errorCode == ErrorCode_RealTimeStatus::NOT_CONNECTED);
+    TEST_CHECK(sdk.latestRealTimeStatus(latest, updatedAt));
+}
+
+void testAutoReconnect() {
+    test::MockRobot robot;
+    robot.responseDelayMs = 300;
+    SdkOptions options;
+    options.autoReconnect = true;
+    options.reconnectInitialDelay = std::chrono::milliseconds(20);
+    RobotServerSdk sdk(options);
+    TEST_CHECK(sdk.connect("127.0.0.1", robot.port()));
+
+    // 断线时在途的请求：1002/1007 重连后重发，1004 立即失败
+    auto status = sdk.request1002_RunTimeStatusAsync();
+    auto cancelled = sdk.request1004_CancelNavTaskAsync();
+    TaskStatusResult taskStatus;
+    std::thread syncQuery([&]() {
+        taskStatus = sdk.request1007_NavTaskStatus();
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    robot.responseDelayMs = 0;
+    robot.closeConnections();
+
+    TEST_CHECK(!cancelled.get());
+    TEST_CHECK(status.get().electricity == 77);
+    syncQuery.join();
+    TEST_CHECK(taskStatus.errorCode == ErrorCode_QueryStatus::COMPLETED && taskStatus.value == 3);
+    TEST_CHECK(sdk.isConnected());
+    TEST_CHECK(robot.accepted.load() == 2);
+    TEST_CHECK(robot.received1002.load() == 2);
+    TEST_CHECK(robot.received1007.load() == 2);
+    TEST_CHECK(robot.received1004.load() == 1);
+
+    // 主动断开后不再重连
+    sdk.disconnect();
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    TEST_CHECK(!sdk.isConnected());
+    TEST_CHECK(robot.accepted.load() == 2);
+}
+
+void testHeartbeat() {
+    SdkOptions options;
+    options.heartbeatInterval = std::chrono::milliseconds(50);
+    options.heartbeatMissLimit = 3;
+
+    // 正常应答：记录往返时间，连接保持
+    test::MockRobot robot;
+    RobotServerSdk sdk(options);
+    TEST_CHECK(sdk.connect("127.0.0.1", robot.port()));
+    std::this_thread::sleep_for(std::chrono::milliseconds(300));
+    const ConnectionHealth health = sdk.connectionHealth();
+    TEST_CHECK(sdk.isConnected());
+    TEST_CHECK(health.lastRtt.count() > 0 && health.smoothedRtt.count() > 0);
+    TEST_CHECK(health.missedHeartbeats == 0);
+    TEST_CHECK(robot.received1002.load() >= 2);
+
+    // 连接仍在但不再应答：连续 3 次探测超时后断开
+    test::MockRobot silentRobot;
+    silentRobot.silent = true;
+    RobotServerSdk silentSdk(options);
+    TEST_CHECK(silentSdk.connect("127.0.0.1", silentRobot.port()));
+    const auto start = std::chrono::steady_clock::now();
+    while (silentSdk.isConnected() && std::chrono::steady_clock::now() - start < std::chrono::seconds(3)) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    TEST_CHECK(!silentSdk.isConnected());
+    TEST_CHECK(std::chrono::steady_clock::now() - start < std::chrono::seconds(1));
+    TEST_CHECK(silentSdk.connectionHealth().missedHeartbeats >= 3);
+}
+
+void testMetrics() {
+    test::MockRobot robot;
+    robot.silent = false;
+    RobotServerSdk sdk(shortTimeoutOptions());
+    TEST_CHECK(sdk.connect("127.0.0.1", robot.port()));
+
+    for (int i = 0; i < 5; ++i) {
+        TEST_CHECK(sdk.request1002_RunTimeStatus().electricity == 77);
+    }
+    TEST_CHECK(sdk.request1007_NavTaskStatusAsync().get().value == 3);
+    TEST_CHECK(sdk.request1004_CancelNavTaskAsync().get());
+
+    robot.silent = true;
+    TEST_CHECK(sdk.request1002_RunTimeStatusAsync().get().errorCode == ErrorCode_RealTimeStatus::TIMEOUT);
+
+    const MetricsSnapshot metrics = sdk.metrics();
+    TEST_CHECK(metrics.latency1002.count == 5);
+    TEST_CHECK(metrics.latency1007.count == 1);
+    TEST_CHECK(metrics.latency1004.count == 1);
+    TEST_CHECK(metrics.latency1003.count == 0);
+    TEST_CHECK(metrics.latency1002.percentile(0.99) > std::chrono::microseconds::zero());
+    TEST_CHECK(metrics.latency1002.percentile(0.99) <= metrics.latency1002.max);
+    TEST_CHECK(metrics.framesSent == 8);
+    TEST_CHECK(metrics.framesDecoded == 7);
+    TEST_CHECK(metrics.decodeFailures == 0);
+    TEST_CHECK(metrics.bytesSent > 0 && metrics.bytesReceived > 0);
+    TEST_CHECK(metrics.timeouts == 1);
+    TEST_CHECK(metrics.reconnects == 0);
+
+    const std::string text = toPrometheusText(metrics);
+    TEST_CHECK(text.find("x30_sdk_request_duration_seconds_count{type=\"1002\"} 5\n") != std::string::npos);
+}
+
+/**
+ * @brief 当前进程的线程数，非 Linux 平台返回 0
+ */
+size_t processThreadCount() {
+#ifdef __linux__
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line)) {
+        if (line.compare(0, 8, "Threads:") == 0) {
+            return std::stoul(line.substr(8));
+        }
+    }
+    return 0;
+#else
+    return 0;
+#endif
+}
+
+void testSharedIoThreadPool() {
+    constexpr int ROBOTS = 64;
+    constexpr size_t IO_THREADS = 2;
+
+    test::MockRobot robot;
+    robot.responseDelayMs = 20;
+
+    SdkOptions options;
+    options.ioThreadPool = std::make_shared<IoThreadPool>(IO_THREADS);
+    TEST_CHECK(options.ioThreadPool->threadCount() == IO_THREADS);
+
+    const size_t threadsBefore = processThreadCount();
+    std::vector<std::unique_ptr<RobotServerSdk>> fleet;
+    for (int i = 0; i < ROBOTS; ++i) {
+        fleet.push_back(std::make_unique<RobotServerSdk>(options));
+        TEST_CHECK(fleet.back()->connect("127.0.0.1", robot.port()));
+    }
+
+    // 连接数增加不再增加SDK的IO线程（模拟机器狗每个连接自己占用两个线程）
+    if (threadsBefore != 0) {
+        TEST_CHECK(processThreadCount() <= threadsBefore + 2 * ROBOTS);
+    }
+
+    // 所有连接同时有请求在途，每个响应回到发出它的连接
+    std::vector<std::future<RealTimeStatus>> statuses;
+    std::vector<std::future<TaskStatusResult>> tasks;
+    for (auto& sdk : fleet) {
+        statuses.push_back(sdk->request1002_RunTimeStatusAsync());
+        tasks.push_back(sdk->request1007_NavTaskStatusAsync());
+    }
+    for (auto& status : statuses) {
+        TEST_CHECK(status.get().errorCode == ErrorCode_RealTimeStatus::SUCCESS);
+    }
+    for (auto& task : tasks) {
+        TEST_CHECK(task.get().value == 3);
+    }
+
+    // 线程池对象先于连接释放，正在使用它的连接不受影响
+    options.ioThreadPool.reset();
+    TEST_CHECK(fleet.front()->request1002_RunTimeStatus().errorCode == ErrorCode_RealTimeStatus::SUCCESS);
+
+    // 有请求在途时析构一半的连接，其余连接照常工作
+    std::vector<std::future<TaskStatusResult>> orphaned;
+    for (int i = 0; i < ROBOTS / 2; ++i) {
+        orphaned.push_back(fleet[i]->request1007_NavTaskStatusAsync());
+        fleet[i].reset();
+    }
+    for (auto& task : orphaned) {
+        TEST_CHECK(task.wait_for(std::chrono::seconds(1)) == std::future_status::ready);
+        TEST_CHECK(task.get().errorCode == ErrorCode_QueryStatus::NOT_CONNECTED);
+    }
+    for (int i = ROBOTS / 2; i < ROBOTS; ++i) {
+        TEST_CHECK(fleet[i]->request1007_NavTaskStatus().value == 3);
+    }
+
+    // 被动断开只影响对应的连接
+    robot.closeConnections();
+    for (int i = ROBOTS / 2; i < ROBOTS; ++i) {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+        while (fleet[i]->isConnected() && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        TEST_CHECK(!fleet[i]->isConnected());
+    }
+    TEST_CHECK(fleet.back()->connect("127.0.0.1", robot.port()));
+    TEST_CHECK(fleet.back()->request1002_RunTimeStatus().electricity == 77);
+}
+
+#if ROBOTSERVER_SDK_HAS_COROUTINES
+/**
+ * @brief 最小的立即执行、不返回值的协程类型
+ */
+struct FireAndForget {
+    struct promise_type {
+        FireAndForget get_return_object() { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+    };
+};
+
+FireAndForget queryAll(RobotServerSdk& sdk, std::promise<int>& done) {
+    const RealTimeStatus status = co_await sdk.co_request1002_RunTimeStatus();
+    const TaskStatusResult task = co_await sdk.co_request1007_NavTaskStatus();
+    const bool cancelled = co_await sdk.co_request1004_CancelNavTask();
+    done.set_value(status.electricity + task.value + (cancelled ? 1 : 0));
+}
+
+void testCoroutines() {
+    test::MockRobot robot;
+    RobotServerSdk sdk;
+    TEST_CHECK(sdk.connect("127.0.0.1", robot.port()));
+
+    std::promise<int> done;
+    auto result = done.get_future();
+    queryAll(sdk, done);
+    TEST_CHECK(result.wait_for(std::chrono::seconds(5)) == std::future_status::ready);
+    TEST_CHECK(result.get() == 77 + 3 + 1);
+
+    // 未连接时回调在 await_suspend 内同步调用，协程应直接继续
+    sdk.disconnect();
+    std::promise<int> offline;
+    auto offlineResult = offline.get_future();
+    queryAll(sdk, offline);
+    TEST_CHECK(offlineResult.wait_for(std::chrono::seconds(1)) == std::future_status::ready);
+    TEST_CHECK(offlineResult.get() == 0);
+}
+#endif
+
+} // namespace
+
+int main() {
+    TEST_RUN(testFutures);
+    TEST_RUN(testManyInFlightFromOneThread);
+    TEST_RUN(testConcurrentSenders);
+    TEST_RUN(testTimeoutAndDisconnect);
+    TEST_RUN(testInFlightWindow);
+    TEST_RUN(testPerRequestDeadline);
+    TEST_RUN(testCoalescedQueries);
+    TEST_RUN(testNavigationTimeout);
+    TEST_RUN(testNavigationRoute);
+    TEST_RUN(testStatusSubscription);
+    TEST_RUN(testStatusCache);
+    TEST_RUN(testAutoReconnect);
+    TEST_RUN(testHeartbeat);
+    TEST_RUN(testMetrics);
+    TEST_RUN(testSharedIoThreadPool);
+#if ROBOTSERVER_SDK_HAS_COROUTINES
+    TEST_RUN(testCoroutines);
+#endif
+
+    std::printf("%d 项检查失败\n", test::failureCount().load());
+    return test::failureCount().load() == 0 ? 0 : 1;
+}
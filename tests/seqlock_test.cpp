@@ -0,0 +1,97 @@
+#include "test_util.hpp"
+#include "common/seqlock.hpp"
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using common::Seqlock;
+
+constexpr int READER_THREADS = 4;
+constexpr uint64_t WRITES = 200000;
+
+/**
+ * @brief 跨多个字的值：所有字段相同才是一致的快照
+ */
+struct Sample {
+    uint64_t a = 0;
+    double b = 0.0;
+    uint32_t c = 0;
+    uint64_t d = 0;
+};
+
+void testEmpty() {
+    Seqlock<Sample> cell;
+    Sample sample;
+    TEST_CHECK(!cell.hasValue());
+    TEST_CHECK(!cell.load(sample));
+
+    sample.a = 1;
+    cell.store(sample);
+    Sample loaded;
+    TEST_CHECK(cell.hasValue());
+    TEST_CHECK(cell.load(loaded) && loaded.a == 1);
+}
+
+void testConsistentSnapshots() {
+    Seqlock<Sample> cell;
+    std::atomic<bool> done{false};
+    std::atomic<int> torn{0};
+
+    // 读者从不看到新旧字段混合的值
+    std::vector<std::thread> readers;
+    for (int i = 0; i < READER_THREADS; ++i) {
+        readers.emplace_back([&]() {
+            Sample sample;
+            while (!done.load(std::memory_order_relaxed)) {
+                if (!cell.load(sample)) {
+                    continue;
+                }
+                if (sample.b != static_cast<double>(sample.a) || sample.c != static_cast<uint32_t>(sample.a) ||
+                    sample.d != sample.a) {
+                    ++torn;
+                }
+            }
+        });
+    }
+
+    // 两个写者交替写入，写者之间同样互斥
+    std::atomic<uint64_t> next{1};
+    std::vector<std::thread> writers;
+    for (int i = 0; i < 2; ++i) {
+        writers.emplace_back([&]() {
+            uint64_t value;
+            while ((value = next.fetch_add(1)) <= WRITES) {
+                Sample sample;
+                sample.a = value;
+                sample.b = static_cast<double>(value);
+                sample.c = static_cast<uint32_t>(value);
+                sample.d = value;
+                cell.store(sample);
+            }
+        });
+    }
+    for (auto& writer : writers) {
+        writer.join();
+    }
+    done = true;
+    for (auto& reader : readers) {
+        reader.join();
+    }
+
+    TEST_CHECK(torn.load() == 0);
+    Sample last;
+    TEST_CHECK(cell.load(last) && last.a == last.d);
+}
+
+} // namespace
+
+int main() {
+    TEST_RUN(testEmpty);
+    TEST_RUN(testConsistentSnapshots);
+
+    std::printf("%d 项检查失败\n", test::failureCount().load());
+    return test::failureCount().load() == 0 ? 0 : 1;
+}
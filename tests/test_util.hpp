@@ -0,0 +1,36 @@
+#pragma once
+
+#include <atomic>
+#include <cstdio>
+
+namespace test {
+
+/**
+ * @brief 失败的检查项计数，main() 以此作为进程退出码；检查可能在多个线程中进行
+ */
+inline std::atomic<int>& failureCount() {
+    static std::atomic<int> count{0};
+    return count;
+}
+
+} // namespace test
+
+/**
+ * @brief 检查条件，失败时打印位置并计数，不中断后续检查
+ */
+#define TEST_CHECK(cond)                                                        \
+    do {                                                                        \
+        if (!(cond)) {                                                          \
+            std::fprintf(stderr, "%s:%d: 检查失败: %s\n", __FILE__, __LINE__, #cond); \
+            ++test::failureCount();                                             \
+        }                                                                       \
+    } while (0)
+
+/**
+ * @brief 运行一个测试函数并打印其名称
+ */
+#define TEST_RUN(fn)                          \
+    do {                                      \
+        std::printf("[ RUN  ] %s\n", #fn);    \
+        fn();                                 \
+    } while (0)
@@ -0,0 +1,164 @@
+#include "test_util.hpp"
+#include "common/timer_wheel.hpp"
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using common::TimerWheel;
+using Clock = TimerWheel::Clock;
+using std::chrono::milliseconds;
+
+void testExpiryOrderAndPrecision() {
+    TimerWheel wheel(milliseconds(10));
+    const auto start = Clock::now();
+
+    std::vector<int> fired;
+    wheel.schedule(start + milliseconds(35), [&]() { fired.push_back(35); });
+    wheel.schedule(start + milliseconds(5), [&]() { fired.push_back(5); });
+    wheel.schedule(start - milliseconds(5), [&]() { fired.push_back(-5); });
+    // 超过第 0 层一圈（256 * 10ms）的任务级联到第 0 层后才执行
+    wheel.schedule(start + milliseconds(3005), [&]() { fired.push_back(3005); });
+    TEST_CHECK(wheel.size() == 4);
+
+    // 任务不会提前执行
+    wheel.advance(start + milliseconds(4));
+    TEST_CHECK(fired.empty() || fired == std::vector<int>{-5});
+
+    wheel.advance(start + milliseconds(45));
+    TEST_CHECK(fired.size() == 3 && fired.back() == 35);
+
+    wheel.advance(start + milliseconds(3000));
+    TEST_CHECK(fired.size() == 3);
+
+    wheel.advance(start + milliseconds(3015));
+    TEST_CHECK(fired.size() == 4 && fired.back() == 3005);
+    TEST_CHECK(wheel.size() == 0);
+}
+
+void testCancel() {
+    TimerWheel wheel(milliseconds(10));
+    const auto start = Clock::now();
+
+    int fired = 0;
+    const auto kept = wheel.schedule(start + milliseconds(20), [&]() { ++fired; });
+    const auto cancelled = wheel.schedule(start + milliseconds(20), [&]() { fired += 100; });
+    TEST_CHECK(kept != cancelled && kept != 0);
+    TEST_CHECK(wheel.cancel(cancelled));
+    TEST_CHECK(!wheel.cancel(cancelled));
+    TEST_CHECK(wheel.size() == 1);
+
+    TEST_CHECK(wheel.advance(start + milliseconds(50)) == 1);
+    TEST_CHECK(fired == 1);
+    TEST_CHECK(!wheel.cancel(kept));
+}
+
+void testLongStall() {
+    TimerWheel wheel(milliseconds(1));
+    const auto start = Clock::now();
+
+    // 驱动线程长时间没有推进（跨越多圈）后一次推进执行所有到期任务，未到期的保留；
+    // 截止时间向上取整到刻度，推进到截止时间之后一个刻度时必然已执行
+    int fired = 0;
+    for (int i = 1; i <= 1000; ++i) {
+        wheel.schedule(start + milliseconds(i), [&]() { ++fired; });
+    }
+    TEST_CHECK(wheel.advance(start + milliseconds(501)) == 500);
+    TEST_CHECK(fired == 500);
+    TEST_CHECK(wheel.size() == 500);
+    TEST_CHECK(wheel.advance(start + milliseconds(2000)) == 500);
+    TEST_CHECK(wheel.size() == 0);
+}
+
+void testHierarchy() {
+    TimerWheel wheel(milliseconds(1));
+    const auto start = Clock::now();
+
+    // 每一层以及超出最高层范围（约 18.6 小时）的任务都恰好在到期的刻度执行
+    const std::vector<int64_t> deadlinesMs = {
+        300,                       // 第 1 层
+        20000,                     // 第 2 层
+        2000000,                   // 第 3 层
+        70000000,                  // 超出最高层范围
+    };
+    std::vector<int64_t> fired;
+    for (const int64_t ms : deadlinesMs) {
+        wheel.schedule(start + milliseconds(ms), [&fired, ms]() { fired.push_back(ms); });
+    }
+
+    for (size_t i = 0; i < deadlinesMs.size(); ++i) {
+        const int64_t ms = deadlinesMs[i];
+        wheel.advance(start + milliseconds(ms - 2));
+        TEST_CHECK(fired.size() == i);
+        wheel.advance(start + milliseconds(ms + 1));
+        TEST_CHECK(fired.size() == i + 1 && fired.back() == ms);
+    }
+    TEST_CHECK(wheel.size() == 0);
+}
+
+void testIdleJump() {
+    TimerWheel wheel(milliseconds(1));
+    const auto start = Clock::now();
+
+    // 空闲期间的推进直接跳过；之后登记的任务仍按自己的截止时间执行
+    TEST_CHECK(wheel.advance(start + std::chrono::hours(5)) == 0);
+    int fired = 0;
+    wheel.schedule(start + std::chrono::hours(5) + milliseconds(10), [&]() { ++fired; });
+    wheel.advance(start + std::chrono::hours(5) + milliseconds(5));
+    TEST_CHECK(fired == 0);
+    wheel.advance(start + std::chrono::hours(5) + milliseconds(12));
+    TEST_CHECK(fired == 1);
+}
+
+void testIdleGapWithoutAdvance() {
+    TimerWheel wheel(milliseconds(1));
+
+    int fired = 0;
+    wheel.schedule(Clock::now(), [&]() { ++fired; });
+    TEST_CHECK(wheel.advance(Clock::now() + milliseconds(2)) == 1);
+
+    // 时间轮为空时驱动定时器停止、不再调用 advance()；空闲之后登记任务时直接跳到当前刻度，
+    // 下一次推进不必逐个刻度追赶空闲期
+    std::this_thread::sleep_for(milliseconds(100));
+    const auto now = Clock::now();
+    const uint64_t idleTick = wheel.currentTick();
+    wheel.schedule(now + milliseconds(10), [&]() { ++fired; });
+    TEST_CHECK(wheel.currentTick() >= idleTick + 90);
+
+    TEST_CHECK(wheel.advance(now + milliseconds(5)) == 0);
+    TEST_CHECK(wheel.advance(now + milliseconds(12)) == 1);
+    TEST_CHECK(fired == 2 && wheel.size() == 0);
+}
+
+void testScheduleFromTask() {
+    TimerWheel wheel(milliseconds(10));
+    const auto start = Clock::now();
+
+    // 任务在锁外执行，可以登记新的任务
+    int fired = 0;
+    wheel.schedule(start + milliseconds(10), [&]() {
+        ++fired;
+        wheel.schedule(start + milliseconds(30), [&]() { ++fired; });
+    });
+    wheel.advance(start + milliseconds(20));
+    TEST_CHECK(fired == 1 && wheel.size() == 1);
+    wheel.advance(start + milliseconds(40));
+    TEST_CHECK(fired == 2);
+}
+
+} // namespace
+
+int main() {
+    TEST_RUN(testExpiryOrderAndPrecision);
+    TEST_RUN(testCancel);
+    TEST_RUN(testLongStall);
+    TEST_RUN(testHierarchy);
+    TEST_RUN(testIdleJump);
+    TEST_RUN(testIdleGapWithoutAdvance);
+    TEST_RUN(testScheduleFromTask);
+
+    std::printf("%d 项检查失败\n", test::failureCount().load());
+    return test::failureCount().load() == 0 ? 0 : 1;
+}
@@ -0,0 +1,126 @@
+#include "test_util.hpp"
+#include "protocol/messages.hpp"
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using namespace protocol;
+
+using Fields = std::vector<std::pair<std::string, std::string>>;
+
+bool scan(std::string_view xml, Fields& fields) {
+    fields.clear();
+    return forEachElement(xml, [&](std::string_view name, std::string_view text) {
+        fields.emplace_back(std::string(name), std::string(text));
+    });
+}
+
+void testFlatElements() {
+    Fields fields;
+    TEST_CHECK(scan("<A>1</A>\n  <B>two</B><C/><!-- c --><D> 4 </D>", fields));
+    TEST_CHECK((fields == Fields{{"A", "1"}, {"B", "two"}, {"C", ""}, {"D", " 4 "}}));
+}
+
+void testNestedElementSkipped() {
+    Fields fields;
+    TEST_CHECK(scan("<Pos><PosX>9</PosX></Pos><PosY>2</PosY>", fields));
+    TEST_CHECK((fields == Fields{{"PosY", "2"}}));
+
+    // 同名元素嵌套
+    TEST_CHECK(scan("<P><P><Q>1</Q></P></P><R>3</R>", fields));
+    TEST_CHECK((fields == Fields{{"R", "3"}}));
+
+    // </PosX 不是 <Pos> 的结束标签
+    TEST_CHECK(!scan("<Pos><PosX>9</PosX>", fields));
+}
+
+void testMismatchedCloser() {
+    Fields fields;
+    TEST_CHECK(!scan("<Pos>1</PosX>", fields));
+    TEST_CHECK(!scan("<Pos>1</Pos", fields));
+    TEST_CHECK(!scan("<Pos>1", fields));
+}
+
+void testElementBody() {
+    std::string_view body;
+    TEST_CHECK(findElementBody("<R><Items><A>1</A></Items><X><Items>2</Items></X></R>", "Items", body));
+    TEST_CHECK(body == "<A>1</A>");
+
+    TEST_CHECK(findElementBody("<R><Items><Items>1</Items></Items></R>", "Items", body));
+    TEST_CHECK(body == "<Items>1</Items>");
+
+    TEST_CHECK(findElementBody("<R><Items/></R>", "Items", body));
+    TEST_CHECK(body.empty());
+
+    TEST_CHECK(!findElementBody("<R><Items><A>1</A></R>", "Items", body));
+}
+
+void testRealTimeStatusWithNestedItems() {
+    const std::string xml =
+        "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+        "<PatrolDevice>\n<Type>1002</Type>\n<Command>1</Command>\n<Time>2024-05-20 12:34:56</Time>\n"
+        "<Items><Pos><PosX>9</PosX></Pos><PosX>+3</PosX><PosY>-2.5</PosY><Electricity>77</Electricity></Items>\n"
+        "<Extra><Items><PosX>100</PosX></Items></Extra>\n"
+        "</PatrolDevice>";
+
+    GetRealTimeStatusResponse response;
+    TEST_CHECK(response.deserialize(xml));
+    TEST_CHECK(response.posX == 3.0);
+    TEST_CHECK(response.posY == -2.5);
+    TEST_CHECK(response.electricity == 77);
+}
+
+void testRealTimeStatusMalformed() {
+    GetRealTimeStatusResponse response;
+    TEST_CHECK(!response.deserialize("<PatrolDevice><Items><Pos><PosX>9</PosX></Items></PatrolDevice>"));
+    TEST_CHECK(!response.deserialize("<PatrolDevice><Items><PosX>1</PosY></Items></PatrolDevice>"));
+    TEST_CHECK(!response.deserialize("<PatrolDevice><Type>1002</Type></PatrolDevice>"));
+}
+
+void testTaskResponses() {
+    auto wrap = [](int type, const std::string& items) {
+        return "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<PatrolDevice>\n<Type>" + std::to_string(type) +
+               "</Type>\n<Command>1</Command>\n<Time>2024-05-20 12:34:56</Time>\n<Items>" + items +
+               "</Items>\n</PatrolDevice>";
+    };
+
+    NavigationTaskResponse navigation;
+    TEST_CHECK(navigation.deserialize(wrap(1003, "<Value>12</Value><ErrorCode>2</ErrorCode><ErrorStatus>8961</ErrorStatus>")));
+    TEST_CHECK(navigation.value == 12);
+    TEST_CHECK(navigation.errorCode == ErrorCode_Navigation::CANCELLED);
+    TEST_CHECK(navigation.errorStatus == 8961);
+
+    QueryStatusResponse query;
+    TEST_CHECK(query.deserialize(wrap(1007, "<Value>3</Value><Status>1</Status><ErrorCode>-1</ErrorCode>")));
+    TEST_CHECK(query.value == 3);
+    TEST_CHECK(query.status == 1);
+    TEST_CHECK(query.errorCode == ErrorCode_QueryStatus::FAILED);
+
+    // 缺少的字段保持默认值，无法解析的错误码不覆盖默认值
+    CancelTaskResponse cancel;
+    TEST_CHECK(cancel.deserialize(wrap(1004, "<ErrorCode>1</ErrorCode>")));
+    TEST_CHECK(cancel.errorCode == ErrorCode_CancelTask::FAILURE);
+    CancelTaskResponse defaults;
+    TEST_CHECK(defaults.deserialize(wrap(1004, "<ErrorCode>x</ErrorCode>")));
+    TEST_CHECK(defaults.errorCode == ErrorCode_CancelTask::SUCCESS);
+
+    TEST_CHECK(!navigation.deserialize("<PatrolDevice><Type>1003</Type></PatrolDevice>"));
+    TEST_CHECK(!query.deserialize("<PatrolDevice><Items><Value>1</Status></Items></PatrolDevice>"));
+}
+
+} // namespace
+
+int main() {
+    TEST_RUN(testFlatElements);
+    TEST_RUN(testNestedElementSkipped);
+    TEST_RUN(testMismatchedCloser);
+    TEST_RUN(testElementBody);
+    TEST_RUN(testRealTimeStatusWithNestedItems);
+    TEST_RUN(testRealTimeStatusMalformed);
+    TEST_RUN(testTaskResponses);
+
+    std::printf("%d 项检查失败\n", test::failureCount().load());
+    return test::failureCount().load() == 0 ? 0 : 1;
+}